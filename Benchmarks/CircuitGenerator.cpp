@@ -0,0 +1,364 @@
+#include "CircuitGenerator.h"
+#include "Configuration.h"
+
+#include <QtGlobal>
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+
+namespace
+{
+constexpr uint32_t DAG_CLOCK_COUNT = 8;
+constexpr uint32_t DAG_WINDOW = 64; // Gates take their inputs from the last DAG_WINDOW gates
+constexpr uint32_t DAG_OUTPUT_COUNT = 16;
+constexpr uint32_t COUNTER_GROUP_SIZE = 8; // Counters per clock
+constexpr uint32_t SHIFTREGISTER_CHAIN_LENGTH = 64; // Shift registers per clock
+constexpr uint32_t MESH_CLOCK_PERIODS = 8;
+
+constexpr uint32_t NO_NET = std::numeric_limits<uint32_t>::max();
+} // namespace
+
+CircuitGenerator::CircuitGenerator(uint32_t pSeed):
+    mRandomState(pSeed != 0 ? pSeed : 1) // xorshift never leaves the zero state
+{}
+
+CircuitGeometry CircuitGenerator::GenerateRandomDag(uint32_t pGateCount)
+{
+    Begin();
+
+    std::vector<uint32_t> nodes;
+
+    for (uint32_t clock = 0; clock < DAG_CLOCK_COUNT; clock++)
+    {
+        nodes.push_back(AddClock(clock + 1));
+    }
+
+    for (uint32_t gate = 0; gate < pGateCount; gate++)
+    {
+        static constexpr CellKernel KERNELS[] = {CellKernel::AND_GATE, CellKernel::OR_GATE, CellKernel::XOR_GATE, CellKernel::BUFFER_GATE};
+        const auto kernel = KERNELS[GetRandom(4)];
+        const uint32_t inputCount = (kernel == CellKernel::BUFFER_GATE ? 1 : 2);
+        const auto component = AddComponent(kernel, inputCount, 1);
+
+        mCells[component].outputInverted[0] = (kernel == CellKernel::BUFFER_GATE); // NOT gate
+
+        for (uint32_t input = 0; input < inputCount; input++)
+        {
+            const auto window = std::min<uint32_t>(nodes.size(), DAG_WINDOW);
+            Connect(nodes[nodes.size() - 1 - GetRandom(window)], 0, component, input);
+        }
+
+        nodes.push_back(component);
+    }
+
+    for (uint32_t output = 0; output < std::min(pGateCount, DAG_OUTPUT_COUNT); output++)
+    {
+        Connect(nodes[nodes.size() - 1 - output], 0, AddComponent(CellKernel::OUTPUT, 1, 0), 0);
+    }
+
+    return Route();
+}
+
+CircuitGeometry CircuitGenerator::GenerateRippleCarryAdders(uint32_t pAdderCount, uint32_t pBitWidth)
+{
+    Begin();
+
+    for (uint32_t adder = 0; adder < pAdderCount; adder++)
+    {
+        uint32_t previousStage = NO_NET;
+
+        for (uint32_t bit = 0; bit < pBitWidth; bit++)
+        {
+            // Operand bits toggle at different rates, so the carry chain ripples in every tick
+            const auto stage = AddComponent(CellKernel::FULL_ADDER, 3, 2);
+            Connect(AddClock(bit + 1), 0, stage, 0);
+            Connect(AddClock(bit + 2), 0, stage, 1);
+
+            if (previousStage != NO_NET)
+            {
+                Connect(previousStage, 1, stage, 2);
+            }
+
+            Connect(stage, 0, AddComponent(CellKernel::OUTPUT, 1, 0), 0);
+            previousStage = stage;
+        }
+
+        if (previousStage != NO_NET)
+        {
+            Connect(previousStage, 1, AddComponent(CellKernel::OUTPUT, 1, 0), 0);
+        }
+    }
+
+    return Route();
+}
+
+CircuitGeometry CircuitGenerator::GenerateCounterArray(uint32_t pCounterCount, uint32_t pBitWidth)
+{
+    Q_ASSERT(pBitWidth >= 1);
+    Begin();
+
+    uint32_t previousCounter = NO_NET;
+
+    for (uint32_t counter = 0; counter < pCounterCount; counter++)
+    {
+        // Inputs: reset, hold, clock
+        const auto component = AddComponent(CellKernel::COUNTER, 3, pBitWidth);
+
+        if (counter % COUNTER_GROUP_SIZE == 0)
+        {
+            Connect(AddClock(1), 0, component, 2);
+        }
+        else
+        {
+            Connect(previousCounter, pBitWidth - 1, component, 2);
+        }
+
+        Connect(component, 0, AddComponent(CellKernel::OUTPUT, 1, 0), 0);
+        previousCounter = component;
+    }
+
+    return Route();
+}
+
+CircuitGeometry CircuitGenerator::GenerateShiftRegisterChain(uint32_t pRegisterCount, uint32_t pBitWidth)
+{
+    Q_ASSERT(pBitWidth >= 1);
+    Begin();
+
+    uint32_t clock = NO_NET;
+    uint32_t previousRegister = NO_NET;
+
+    for (uint32_t shiftRegister = 0; shiftRegister < pRegisterCount; shiftRegister++)
+    {
+        // Inputs: data, clock; only the last output is connectable
+        const auto component = AddComponent(CellKernel::SHIFTREGISTER, 2, pBitWidth);
+
+        if (shiftRegister % SHIFTREGISTER_CHAIN_LENGTH == 0)
+        {
+            if (previousRegister != NO_NET)
+            {
+                Connect(previousRegister, pBitWidth - 1, AddComponent(CellKernel::OUTPUT, 1, 0), 0);
+            }
+
+            clock = AddClock(1);
+            Connect(AddClock(3), 0, component, 0);
+        }
+        else
+        {
+            Connect(previousRegister, pBitWidth - 1, component, 0);
+        }
+
+        Connect(clock, 0, component, 1);
+        previousRegister = component;
+    }
+
+    if (previousRegister != NO_NET)
+    {
+        Connect(previousRegister, pBitWidth - 1, AddComponent(CellKernel::OUTPUT, 1, 0), 0);
+    }
+
+    return Route();
+}
+
+CircuitGeometry CircuitGenerator::GenerateWireMesh(uint32_t pSize)
+{
+    Begin();
+
+    CircuitGeometry geometry;
+    const int32_t length = (static_cast<int32_t>(pSize) + 1) * canvas::GRID_SIZE;
+
+    for (uint32_t line = 0; line < pSize; line++)
+    {
+        const int32_t offset = (static_cast<int32_t>(line) + 1) * canvas::GRID_SIZE;
+
+        geometry.wires.push_back(WireGeometry{GridPoint{0, offset}, WireDirection::HORIZONTAL, length});
+        geometry.wires.push_back(WireGeometry{GridPoint{offset, 0}, WireDirection::VERTICAL, length});
+
+        // Rows start at a clock, columns end at an output
+        ComponentGeometry clock;
+        clock.pos = GridPoint{0, offset};
+        clock.cell.kernel = CellKernel::CLOCK;
+        clock.cell.outputInverted = std::vector<bool>{false};
+        clock.cell.parameters.toggleTicks = line % MESH_CLOCK_PERIODS + 1;
+        clock.outputs.push_back(ConnectorGeometry{clock.pos, 0});
+        geometry.components.push_back(clock);
+
+        ComponentGeometry output;
+        output.pos = GridPoint{offset, length};
+        output.cell.kernel = CellKernel::OUTPUT;
+        output.cell.inputInverted = std::vector<bool>{false};
+        output.inputs.push_back(ConnectorGeometry{output.pos, 0});
+        geometry.components.push_back(output);
+    }
+
+    // Full ConPoints on the diagonal join row and column i into one net, other crossings get random diodes or nothing
+    for (uint32_t row = 0; row < pSize; row++)
+    {
+        for (uint32_t column = 0; column < pSize; column++)
+        {
+            const GridPoint pos{(static_cast<int32_t>(column) + 1) * canvas::GRID_SIZE, (static_cast<int32_t>(row) + 1) * canvas::GRID_SIZE};
+            const auto choice = GetRandom(3);
+
+            if (row == column)
+            {
+                geometry.conPoints.push_back(ConPointGeometry{pos, ConnectionType::FULL});
+            }
+            else if (choice < 2)
+            {
+                geometry.conPoints.push_back(ConPointGeometry{pos, (choice == 0 ? ConnectionType::DIODE_X : ConnectionType::DIODE_Y)});
+            }
+        }
+    }
+
+    return geometry;
+}
+
+void CircuitGenerator::Begin()
+{
+    mCells.clear();
+    mNets.clear();
+    mNetOfOutput.clear();
+}
+
+uint32_t CircuitGenerator::AddComponent(CellKernel pKernel, uint32_t pInputCount, uint32_t pOutputCount)
+{
+    NetlistCell cell;
+    cell.kernel = pKernel;
+    cell.inputInverted = std::vector<bool>(pInputCount, false);
+    cell.outputInverted = std::vector<bool>(pOutputCount, false);
+
+    mCells.push_back(cell);
+    return mCells.size() - 1;
+}
+
+uint32_t CircuitGenerator::AddClock(uint32_t pToggleTicks)
+{
+    Q_ASSERT(pToggleTicks >= 1);
+
+    const auto clock = AddComponent(CellKernel::CLOCK, 0, 1);
+    mCells[clock].parameters.toggleTicks = pToggleTicks;
+    return clock;
+}
+
+void CircuitGenerator::Connect(uint32_t pSource, uint32_t pOutput, uint32_t pTarget, uint32_t pInput)
+{
+    Q_ASSERT(pSource < mCells.size() && pOutput < mCells[pSource].outputInverted.size());
+    Q_ASSERT(pTarget < mCells.size() && pInput < mCells[pTarget].inputInverted.size());
+
+    const auto net = mNetOfOutput.emplace((static_cast<uint64_t>(pSource) << 32) | pOutput, mNets.size());
+
+    if (net.second)
+    {
+        mNets.push_back(std::vector<Pin>{Pin{pSource, pOutput, false}});
+    }
+
+    mNets[net.first->second].push_back(Pin{pTarget, pInput, true});
+}
+
+CircuitGeometry CircuitGenerator::Route()
+{
+    CircuitGeometry geometry;
+
+    // Connected pins of every component as (net, position in net)
+    std::vector<std::vector<std::pair<uint32_t, uint32_t>>> componentPins(mCells.size());
+    for (uint32_t net = 0; net < mNets.size(); net++)
+    {
+        for (uint32_t pin = 0; pin < mNets[net].size(); pin++)
+        {
+            componentPins[mNets[net][pin].component].emplace_back(net, pin);
+        }
+    }
+
+    // Pins of a component get neighbouring columns, so nets between neighbouring components stay short
+    std::vector<std::vector<int32_t>> pinColumns(mNets.size());
+    for (uint32_t net = 0; net < mNets.size(); net++)
+    {
+        pinColumns[net].resize(mNets[net].size());
+    }
+
+    int32_t column = 0;
+    for (uint32_t component = 0; component < mCells.size(); component++)
+    {
+        ComponentGeometry geometryComponent;
+        geometryComponent.pos = GridPoint{column * canvas::GRID_SIZE, 0};
+        geometryComponent.cell = mCells[component];
+
+        for (const auto& entry : componentPins[component])
+        {
+            const auto& pin = mNets[entry.first][entry.second];
+            const GridPoint pos{column * canvas::GRID_SIZE, 0};
+
+            (pin.isInput ? geometryComponent.inputs : geometryComponent.outputs).push_back(ConnectorGeometry{pos, pin.number});
+            pinColumns[entry.first][entry.second] = column++;
+        }
+
+        geometry.components.push_back(geometryComponent);
+    }
+
+    // Left edge packing: Each net takes the row whose last net ended first, if that one ends left of it
+    std::vector<uint32_t> netOrder;
+    for (uint32_t net = 0; net < mNets.size(); net++)
+    {
+        if (mNets[net].size() > 1)
+        {
+            netOrder.push_back(net);
+        }
+    }
+
+    const auto getFirstColumn = [&](uint32_t pNet)
+    {
+        return *std::min_element(pinColumns[pNet].begin(), pinColumns[pNet].end());
+    };
+
+    std::sort(netOrder.begin(), netOrder.end(), [&](uint32_t pA, uint32_t pB)
+    {
+        return getFirstColumn(pA) < getFirstColumn(pB);
+    });
+
+    using RowEnd = std::pair<int32_t, int32_t>; // Last used column and row
+    std::priority_queue<RowEnd, std::vector<RowEnd>, std::greater<RowEnd>> rowEnds;
+    int32_t rowCount = 0;
+
+    for (const auto& net : netOrder)
+    {
+        const auto firstColumn = getFirstColumn(net);
+        const auto lastColumn = *std::max_element(pinColumns[net].begin(), pinColumns[net].end());
+        int32_t row;
+
+        if (!rowEnds.empty() && rowEnds.top().first < firstColumn)
+        {
+            row = rowEnds.top().second;
+            rowEnds.pop();
+        }
+        else
+        {
+            row = rowCount++;
+        }
+
+        rowEnds.push(RowEnd{lastColumn, row});
+
+        const int32_t trackY = (row + 1) * canvas::GRID_SIZE;
+        geometry.wires.push_back(WireGeometry{GridPoint{firstColumn * canvas::GRID_SIZE, trackY}, WireDirection::HORIZONTAL,
+                                              (lastColumn - firstColumn) * canvas::GRID_SIZE});
+
+        for (const auto& pinColumn : pinColumns[net])
+        {
+            geometry.wires.push_back(WireGeometry{GridPoint{pinColumn * canvas::GRID_SIZE, 0}, WireDirection::VERTICAL, trackY});
+            geometry.conPoints.push_back(ConPointGeometry{GridPoint{pinColumn * canvas::GRID_SIZE, trackY}, ConnectionType::FULL});
+        }
+    }
+
+    return geometry;
+}
+
+uint32_t CircuitGenerator::GetRandom(uint32_t pBound)
+{
+    Q_ASSERT(pBound > 0);
+
+    // xorshift64*
+    mRandomState ^= mRandomState >> 12;
+    mRandomState ^= mRandomState << 25;
+    mRandomState ^= mRandomState >> 27;
+    return static_cast<uint32_t>((mRandomState * 0x2545F4914F6CDD1Dull) >> 32) % pBound;
+}
@@ -0,0 +1,103 @@
+#ifndef CIRCUITGENERATOR_H
+#define CIRCUITGENERATOR_H
+
+#include "Simulation/CircuitGeometry.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+///
+/// \brief The CircuitGenerator class generates synthetic circuits of arbitrary size for benchmarking
+/// Except for the wire mesh, circuits are described as components and nets, which are then routed like this:
+/// Every connected pin gets its own grid column on a common pin row, a vertical stub connects it to the
+/// horizontal track of its net below, joined by a full ConPoint. Tracks are packed greedily into as few rows as possible.
+/// Unrelated wires only cross in the middle of each other without ConPoints, so they never connect.
+/// The generated circuits only depend on the seed, so results stay comparable between runs.
+///
+class CircuitGenerator
+{
+public:
+    /// \brief Constructor for CircuitGenerator
+    /// \param pSeed: Seed of the random choices
+    CircuitGenerator(uint32_t pSeed);
+
+    /// \brief Generates a random acyclic network of AND, OR, XOR and NOT gates driven by clocks
+    /// Gates take their inputs from recently added gates, so the circuit is deep but local like real designs
+    /// \param pGateCount: The number of gates
+    /// \return The circuit geometry
+    CircuitGeometry GenerateRandomDag(uint32_t pGateCount);
+
+    /// \brief Generates independent ripple-carry adders made of full adders, their operands are driven by clocks
+    /// \param pAdderCount: The number of adders
+    /// \param pBitWidth: The bit width of each adder
+    /// \return The circuit geometry
+    CircuitGeometry GenerateRippleCarryAdders(uint32_t pAdderCount, uint32_t pBitWidth);
+
+    /// \brief Generates groups of counters, in which every counter is clocked by the highest bit of the previous one
+    /// \param pCounterCount: The number of counters
+    /// \param pBitWidth: The bit width of each counter
+    /// \return The circuit geometry
+    CircuitGeometry GenerateCounterArray(uint32_t pCounterCount, uint32_t pBitWidth);
+
+    /// \brief Generates chains of shift registers with a shared clock per chain
+    /// \param pRegisterCount: The number of shift registers
+    /// \param pBitWidth: The bit width of each shift register
+    /// \return The circuit geometry
+    CircuitGeometry GenerateShiftRegisterChain(uint32_t pRegisterCount, uint32_t pBitWidth);
+
+    /// \brief Generates a square mesh of crossing wires with diode ConPoints on two thirds of the crossings
+    /// Row and column i form one net, every row is driven by a clock and every column ends at an output
+    /// \param pSize: The number of rows and columns
+    /// \return The circuit geometry
+    CircuitGeometry GenerateWireMesh(uint32_t pSize);
+
+protected:
+    /// \brief A pin of a generated component
+    struct Pin
+    {
+        uint32_t component;
+        uint32_t number;
+        bool isInput;
+    };
+
+    /// \brief Discards all components and nets of the previously generated circuit
+    void Begin(void);
+
+    /// \brief Adds a component without connections
+    /// \param pKernel: The kernel of the component
+    /// \param pInputCount: The number of inputs
+    /// \param pOutputCount: The number of outputs
+    /// \return The component index
+    uint32_t AddComponent(CellKernel pKernel, uint32_t pInputCount, uint32_t pOutputCount);
+
+    /// \brief Adds a clock in toggle mode
+    /// \param pToggleTicks: The number of ticks between two toggles
+    /// \return The component index
+    uint32_t AddClock(uint32_t pToggleTicks);
+
+    /// \brief Connects an output to an input, outputs may drive any number of inputs
+    /// \param pSource: Index of the driving component
+    /// \param pOutput: The output number
+    /// \param pTarget: Index of the driven component
+    /// \param pInput: The input number
+    void Connect(uint32_t pSource, uint32_t pOutput, uint32_t pTarget, uint32_t pInput);
+
+    /// \brief Places all connected pins and routes all nets
+    /// \return The circuit geometry
+    CircuitGeometry Route(void);
+
+    /// \brief Returns a pseudo random number, independent of the standard library implementation
+    /// \param pBound: The exclusive upper bound, greater than 0
+    /// \return A number in [0, pBound)
+    uint32_t GetRandom(uint32_t pBound);
+
+protected:
+    uint64_t mRandomState;
+
+    std::vector<NetlistCell> mCells;
+    std::vector<std::vector<Pin>> mNets; // Pins of every net, the driving output first
+    std::unordered_map<uint64_t, uint32_t> mNetOfOutput; // Net index by component and output number
+};
+
+#endif // CIRCUITGENERATOR_H
@@ -0,0 +1,317 @@
+#include "Gui/MainWindow.h"
+#include "Configuration.h"
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QPainterPath>
+#include <QTextStream>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <map>
+
+namespace
+{
+// Generated scenes consist of rows of units: an AND gate whose output is wired to a bus below the row by an L-shaped wire,
+// ending in a T-crossing ConPoint. Every unit adds four items, every row one bus wire.
+constexpr int32_t UNIT_WIDTH = 8 * canvas::GRID_SIZE;
+constexpr int32_t ROW_HEIGHT = 8 * canvas::GRID_SIZE;
+constexpr int32_t BUS_OFFSET = 6 * canvas::GRID_SIZE; // Vertical distance of the bus from the top of the gates
+constexpr uint32_t ITEMS_PER_UNIT = 4;
+constexpr uint32_t UNITS_PER_ROW = 200;
+
+///
+/// \brief Latencies of one editor operation
+///
+struct OperationSamples
+{
+    std::vector<double> milliseconds;
+
+    /// \brief Summarizes the samples as JSON
+    /// \return Sample count, mean, percentiles and maximum in milliseconds
+    QJsonObject ToJson(void) const
+    {
+        auto sorted = milliseconds;
+        std::sort(sorted.begin(), sorted.end());
+
+        const auto percentile = [&sorted](double pPercent)
+        {
+            const auto rank = static_cast<size_t>(std::ceil(pPercent / 100 * sorted.size()));
+            return sorted[std::min(std::max<size_t>(rank, 1), sorted.size()) - 1];
+        };
+
+        QJsonObject json;
+        json["samples"] = static_cast<qint64>(sorted.size());
+
+        if (!sorted.empty())
+        {
+            double sum = 0;
+            for (const auto& sample : sorted)
+            {
+                sum += sample;
+            }
+
+            json["mean"] = sum / sorted.size();
+            json["p50"] = percentile(50);
+            json["p90"] = percentile(90);
+            json["p99"] = percentile(99);
+            json["max"] = sorted.back();
+        }
+
+        return json;
+    }
+};
+
+/// \brief Measures the wall time of the given function
+/// \param pFunction: The function to measure
+/// \return The duration in milliseconds
+double Measure(const std::function<void(void)>& pFunction)
+{
+    const auto start = std::chrono::steady_clock::now();
+    pFunction();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+/// \brief Draws an L-shaped wire like the user does, first along the direction of the first mouse movement
+/// \param pCoreLogic: The core logic
+/// \param pStart: Start point of the wire
+/// \param pEnd: End point of the wire
+void DrawWire(CoreLogic& pCoreLogic, QPointF pStart, QPointF pEnd)
+{
+    pCoreLogic.EnterControlMode(ControlMode::WIRE);
+    pCoreLogic.SetPreviewWireStart(pStart);
+    pCoreLogic.ShowPreviewWires(pEnd);
+    pCoreLogic.AddWires(pEnd);
+}
+
+/// \brief Selects all items within the given rows
+/// \param pCoreLogic: The core logic
+/// \param pScene: The scene
+/// \param pRowCount: The number of rows to select, starting at the first row
+void SelectRows(CoreLogic& pCoreLogic, QGraphicsScene& pScene, uint32_t pRowCount)
+{
+    pCoreLogic.EnterControlMode(ControlMode::EDIT);
+
+    QPainterPath path;
+    path.addRect(QRectF(-canvas::GRID_SIZE, -canvas::GRID_SIZE,
+                        UNITS_PER_ROW * UNIT_WIDTH + 2 * canvas::GRID_SIZE, pRowCount * ROW_HEIGHT));
+    pScene.setSelectionArea(path, Qt::ContainsItemShape);
+}
+
+/// \brief Fills the empty scene with generated rows of units
+/// \param pCoreLogic: The core logic
+/// \param pItemCount: The approximate number of items to generate
+/// \return The number of rows
+uint32_t GenerateScene(CoreLogic& pCoreLogic, uint32_t pItemCount)
+{
+    const uint32_t unitCount = std::max<uint32_t>(pItemCount / ITEMS_PER_UNIT, 1);
+    const uint32_t rowCount = (unitCount + UNITS_PER_ROW - 1) / UNITS_PER_ROW;
+
+    for (uint32_t row = 0; row < rowCount; row++)
+    {
+        const int32_t y = row * ROW_HEIGHT;
+        const uint32_t rowUnits = std::min(unitCount - row * UNITS_PER_ROW, UNITS_PER_ROW);
+
+        DrawWire(pCoreLogic, QPointF(0, y + BUS_OFFSET), QPointF(rowUnits * UNIT_WIDTH, y + BUS_OFFSET));
+
+        pCoreLogic.EnterAddControlMode(ComponentType::AND_GATE);
+        for (uint32_t unit = 0; unit < rowUnits; unit++)
+        {
+            pCoreLogic.AddCurrentTypeComponent(QPointF(unit * UNIT_WIDTH + canvas::GRID_SIZE, y));
+        }
+
+        // The gate output is at the middle of its right side
+        for (uint32_t unit = 0; unit < rowUnits; unit++)
+        {
+            const int32_t x = unit * UNIT_WIDTH + canvas::GRID_SIZE;
+            DrawWire(pCoreLogic, QPointF(x + 3 * canvas::GRID_SIZE, y + 2 * canvas::GRID_SIZE), QPointF(x + 5 * canvas::GRID_SIZE, y + BUS_OFFSET));
+        }
+    }
+
+    pCoreLogic.EnterControlMode(ControlMode::EDIT);
+    return rowCount;
+}
+
+/// \brief Runs all editor benchmarks on a generated scene of the given size
+/// Every operation is undone afterwards, so all repetitions work on the same scene
+/// \param pCoreLogic: The core logic
+/// \param pScene: The scene, it must be empty
+/// \param pItemCount: The approximate number of items in the scene
+/// \param pSelectionItemCount: The approximate number of items to move, copy and delete
+/// \param pRepetitions: The number of samples per operation
+/// \return The results
+QJsonObject RunBenchmarks(CoreLogic& pCoreLogic, QGraphicsScene& pScene, uint32_t pItemCount, uint32_t pSelectionItemCount, uint32_t pRepetitions)
+{
+    std::map<QString, OperationSamples> operations;
+
+    uint32_t rowCount = 0;
+    const auto setupMilliseconds = Measure([&]()
+    {
+        rowCount = GenerateScene(pCoreLogic, pItemCount);
+    });
+
+    const auto selectedRowCount = std::min(std::max<uint32_t>(pSelectionItemCount / (ITEMS_PER_UNIT * UNITS_PER_ROW), 1), rowCount);
+    const QPointF freeArea(0, (rowCount + 1) * ROW_HEIGHT); // Empty area below the generated rows
+    const QPointF moveOffset(0, (rowCount + 2) * ROW_HEIGHT);
+
+    const auto undoRedo = [&](const QString& pOperation)
+    {
+        operations[pOperation + "_undo"].milliseconds.push_back(Measure([&]() { pCoreLogic.Undo(); }));
+        operations[pOperation + "_redo"].milliseconds.push_back(Measure([&]() { pCoreLogic.Redo(); }));
+        pCoreLogic.Undo();
+    };
+
+    for (uint32_t repetition = 0; repetition < pRepetitions; repetition++)
+    {
+        // Adding an L-shaped wire that ends on an existing wire, so a ConPoint is added as well
+        pCoreLogic.EnterControlMode(ControlMode::WIRE);
+        pCoreLogic.SetPreviewWireStart(freeArea);
+        pCoreLogic.ShowPreviewWires(QPointF(UNIT_WIDTH, canvas::GRID_SIZE));
+        operations["add_wires"].milliseconds.push_back(Measure([&]() { pCoreLogic.AddWires(QPointF(UNIT_WIDTH, canvas::GRID_SIZE)); }));
+        undoRedo("add_wires");
+
+        // Moving a selection into the free area, the items are moved by the view before the core logic is notified
+        SelectRows(pCoreLogic, pScene, selectedRowCount);
+        for (auto& item : pScene.selectedItems())
+        {
+            item->moveBy(moveOffset.x(), moveOffset.y());
+        }
+        operations["move"].milliseconds.push_back(Measure([&]() { pCoreLogic.OnSelectedComponentsMovedOrPasted(moveOffset); }));
+        undoRedo("move");
+
+        SelectRows(pCoreLogic, pScene, selectedRowCount);
+        operations["copy"].milliseconds.push_back(Measure([&]() { pCoreLogic.CopySelectedComponents(); }));
+
+        // Pasting comprises inserting the copies and placing them in the free area
+        operations["paste"].milliseconds.push_back(Measure([&]()
+        {
+            pCoreLogic.PasteCopiedComponents();
+            for (auto& item : pScene.selectedItems())
+            {
+                item->moveBy(moveOffset.x(), moveOffset.y());
+            }
+            pCoreLogic.OnSelectedComponentsMovedOrPasted(moveOffset);
+        }));
+        pCoreLogic.EnterControlMode(ControlMode::EDIT);
+        undoRedo("paste");
+
+        SelectRows(pCoreLogic, pScene, selectedRowCount);
+        operations["delete"].milliseconds.push_back(Measure([&]() { pCoreLogic.DeleteSelectedComponents(); }));
+        undoRedo("delete");
+
+        operations["select_all"].milliseconds.push_back(Measure([&]() { pCoreLogic.SelectAll(); }));
+        pScene.clearSelection();
+    }
+
+    QJsonObject results;
+    for (const auto& operation : operations)
+    {
+        results[operation.first] = operation.second.ToJson();
+    }
+
+    QJsonObject result;
+    result["items"] = pScene.items().size();
+    result["selectedItems"] = static_cast<qint64>(selectedRowCount * UNITS_PER_ROW * ITEMS_PER_UNIT);
+    result["setupMilliseconds"] = setupMilliseconds;
+    result["operations"] = results;
+
+    return result;
+}
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    // Run without a display unless a platform is requested explicitly
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+    {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QApplication app(argc, argv);
+    QCoreApplication::setApplicationName("linkuit-editor-bench");
+    QCoreApplication::setApplicationVersion(QString(FULL_VERSION));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Generates large scenes and measures the latency of editor operations");
+    parser.addHelpOption();
+    parser.addVersionOption();
+
+    const QCommandLineOption sizesOption(QStringList() << "sizes", "Comma separated approximate item counts of the scenes.", "counts", "1000,10000,100000,500000");
+    const QCommandLineOption selectionOption(QStringList() << "selection", "Approximate number of items to move, copy and delete.", "count", "1000");
+    const QCommandLineOption repetitionsOption(QStringList() << "r" << "repetitions", "Samples per operation and scene.", "count", "10");
+    const QCommandLineOption outputOption(QStringList() << "o" << "output", "Write the results to a file instead of stdout.", "file");
+    parser.addOption(sizesOption);
+    parser.addOption(selectionOption);
+    parser.addOption(repetitionsOption);
+    parser.addOption(outputOption);
+
+    parser.process(app);
+
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    bool isSelectionValid = false;
+    bool isRepetitionsValid = false;
+    const uint32_t selectionItemCount = parser.value(selectionOption).toUInt(&isSelectionValid);
+    const uint32_t repetitions = parser.value(repetitionsOption).toUInt(&isRepetitionsValid);
+
+    std::vector<uint32_t> sizes;
+    for (const auto& size : parser.value(sizesOption).split(','))
+    {
+        bool isSizeValid = false;
+        sizes.push_back(size.toUInt(&isSizeValid));
+
+        if (!isSizeValid || sizes.back() == 0)
+        {
+            err << "Invalid scene size: " << size << "\n";
+            return 1;
+        }
+    }
+
+    if (!isSelectionValid || !isRepetitionsValid || repetitions == 0)
+    {
+        err << "Invalid selection or repetition count\n";
+        return 1;
+    }
+
+    QJsonArray results;
+
+    for (const auto& size : sizes)
+    {
+        err << "Running scene of " << size << " items\n";
+        err.flush();
+
+        // A fresh window per scene, so no undo history or clipboard carries over
+        MainWindow window;
+        auto result = RunBenchmarks(window.GetCoreLogic(), *window.GetView().Scene(), size, selectionItemCount, repetitions);
+        results.append(result);
+    }
+
+    QJsonObject report;
+    report["version"] = QString(FULL_VERSION);
+    report["scenes"] = results;
+
+    const auto json = QJsonDocument(report).toJson(QJsonDocument::Indented);
+
+    if (parser.isSet(outputOption))
+    {
+        QFile outputFile(parser.value(outputOption));
+
+        if (!outputFile.open(QIODevice::WriteOnly | QIODevice::Truncate) || outputFile.write(json) != json.size())
+        {
+            err << "Could not write " << outputFile.fileName() << "\n";
+            return 1;
+        }
+    }
+    else
+    {
+        out << json;
+    }
+
+    return 0;
+}
@@ -0,0 +1,41 @@
+# Benchmarks of the simulation core on generated circuits, prints the results as JSON
+QT = core gui
+
+CONFIG += c++14 console
+CONFIG -= app_bundle
+
+TARGET = linkuit-bench
+
+FULL_VERSION = "$$cat($${OUT_PWD}/version.txt)"
+DEFINES += FULL_VERSION='\\"$$FULL_VERSION\\"'
+
+VERSION = "$$FULL_VERSION"
+
+INCLUDEPATH += $${PWD}/..
+
+win32: LIBS += -lpsapi
+
+HEADERS += \
+    $${PWD}/CircuitGenerator.h \
+    $${PWD}/../Simulation/BatchSimulationEngine.h \
+    $${PWD}/../Simulation/CircuitGeometry.h \
+    $${PWD}/../Simulation/CompiledNetlist.h \
+    $${PWD}/../Simulation/ConnectivityModel.h \
+    $${PWD}/../Simulation/GridIndex.h \
+    $${PWD}/../Simulation/Netlist.h \
+    $${PWD}/../Simulation/NetlistExtractor.h \
+    $${PWD}/../Simulation/SimulationEngine.h \
+    $${PWD}/../Simulation/SimulationSnapshot.h \
+    $${PWD}/../Simulation/TimingWheel.h
+
+SOURCES += \
+    $${PWD}/main.cpp \
+    $${PWD}/CircuitGenerator.cpp \
+    $${PWD}/../Simulation/BatchSimulationEngine.cpp \
+    $${PWD}/../Simulation/CompiledNetlist.cpp \
+    $${PWD}/../Simulation/ConnectivityModel.cpp \
+    $${PWD}/../Simulation/GridIndex.cpp \
+    $${PWD}/../Simulation/NetlistExtractor.cpp \
+    $${PWD}/../Simulation/SimulationEngine.cpp \
+    $${PWD}/../Simulation/SimulationSnapshot.cpp \
+    $${PWD}/../Simulation/TimingWheel.cpp
@@ -0,0 +1,21 @@
+# Benchmarks of the editor operations on generated scenes, prints the latency percentiles as JSON
+QT += core gui widgets
+
+CONFIG += c++14 console
+CONFIG -= app_bundle
+
+TARGET = linkuit-editor-bench
+
+FULL_VERSION = "$$cat($${OUT_PWD}/version.txt)"
+DEFINES += FULL_VERSION='\\"$$FULL_VERSION\\"'
+
+VERSION = "$$FULL_VERSION"
+
+SOURCES += \
+    $${PWD}/EditorBenchmarks.cpp
+
+RESOURCES += \
+    $${PWD}/../Gui/resources.qrc
+
+include(../Common.pri)
+include(../QtAwesome/QtAwesome.pri)
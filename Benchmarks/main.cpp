@@ -0,0 +1,496 @@
+#include "Benchmarks/CircuitGenerator.h"
+#include "Simulation/BatchSimulationEngine.h"
+#include "Simulation/ConnectivityModel.h"
+#include "Simulation/NetlistExtractor.h"
+#include "Simulation/SimulationEngine.h"
+#include "Simulation/SimulationSnapshot.h"
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTextStream>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+
+#if defined(Q_OS_WIN)
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#elif defined(Q_OS_LINUX)
+#include <unistd.h>
+#endif
+
+namespace
+{
+constexpr uint32_t WARM_UP_TICKS = 100; // Ticks simulated before measuring, so clocks and caches settle
+constexpr uint32_t TICK_BATCH_SIZE = 64; // Ticks between two checks of the measurement time
+constexpr uint64_t VERIFY_TICKS = 2000; // Ticks compared by --verify
+constexpr uint32_t VERIFY_CLOCK_SLOWDOWN = 50; // Factor applied to the clock periods in a second --verify run, so ticks get skipped
+constexpr uint64_t VERIFY_LANE_TICKS = 200; // Ticks compared by the lane check of --verify
+constexpr double VERIFY_LANE_SCALE = 0.1; // Scale of the lane check circuits relative to --scale, every lane runs its own scalar engine
+constexpr uint32_t VERIFY_LANE_INPUT_PERIOD = 12; // Ticks between two input changes in the lane check of --verify
+
+///
+/// \brief A named benchmark circuit, generated for a given scale factor
+///
+struct BenchmarkCase
+{
+    const char* name;
+    std::function<CircuitGeometry(CircuitGenerator&, double)> generate;
+};
+
+/// \brief Getter for the resident memory of this process
+/// \return The resident memory in bytes, 0 if unknown on this platform
+uint64_t GetResidentBytes()
+{
+#if defined(Q_OS_WIN)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    {
+        return counters.WorkingSetSize;
+    }
+    return 0;
+#elif defined(Q_OS_LINUX)
+    QFile statm("/proc/self/statm");
+    if (!statm.open(QIODevice::ReadOnly))
+    {
+        return 0;
+    }
+
+    const auto fields = statm.readAll().split(' ');
+    return (fields.size() > 1 ? fields[1].toULongLong() * sysconf(_SC_PAGESIZE) : 0);
+#else
+    return 0;
+#endif
+}
+
+/// \brief Converts a duration to milliseconds
+/// \param pDuration: The duration
+/// \return The duration in milliseconds
+double ToMilliseconds(std::chrono::steady_clock::duration pDuration)
+{
+    return std::chrono::duration<double, std::milli>(pDuration).count();
+}
+
+/// \brief Scales a circuit size, keeping it at least 1
+/// \param pSize: The size at scale 1
+/// \param pScale: The scale factor
+/// \return The scaled size
+uint32_t Scale(uint32_t pSize, double pScale)
+{
+    return std::max<uint32_t>(static_cast<uint32_t>(std::lround(pSize * pScale)), 1);
+}
+
+/// \brief Measures entering the simulation and ticking for the given circuit
+/// Entering the simulation comprises extracting the netlist from the wire groups the GUI keeps up to date while editing,
+/// compiling it and resetting the engine, as in the GUI. Building the wire groups is measured separately, as part of
+/// loading the circuit, and so is the extraction without them, as done by linkuit-sim.
+/// \param pGeometry: The circuit geometry
+/// \param pDuration: The minimum time to spend ticking
+/// \return The results
+QJsonObject RunBenchmark(const CircuitGeometry& pGeometry, std::chrono::milliseconds pDuration)
+{
+    QJsonObject result;
+    result["components"] = static_cast<qint64>(pGeometry.components.size());
+    result["wires"] = static_cast<qint64>(pGeometry.wires.size());
+    result["conPoints"] = static_cast<qint64>(pGeometry.conPoints.size());
+
+    const auto connectivityStart = std::chrono::steady_clock::now();
+
+    ConnectivityModel connectivity;
+
+    for (const auto& wire : pGeometry.wires)
+    {
+        connectivity.AddWire(wire);
+    }
+
+    for (const auto& conPoint : pGeometry.conPoints)
+    {
+        if (conPoint.type == ConnectionType::FULL)
+        {
+            connectivity.AddFullConPoint(conPoint.pos);
+        }
+    }
+
+    const auto coldExtractStart = std::chrono::steady_clock::now();
+
+    {
+        NetlistExtractor coldExtractor;
+        coldExtractor.Extract(pGeometry);
+    }
+
+    const auto coldExtractEnd = std::chrono::steady_clock::now();
+    const auto residentBefore = GetResidentBytes();
+    const auto extractStart = std::chrono::steady_clock::now();
+
+    NetlistExtractor extractor;
+    extractor.Extract(pGeometry, connectivity);
+
+    const auto compileStart = std::chrono::steady_clock::now();
+
+    SimulationEngine engine;
+    engine.Compile(extractor.GetNetlist());
+    engine.Reset();
+
+    const auto compileEnd = std::chrono::steady_clock::now();
+    const auto residentAfter = GetResidentBytes();
+
+    result["cells"] = static_cast<qint64>(engine.GetCellCount());
+    result["connections"] = static_cast<qint64>(extractor.GetNetlist().connections.size());
+    result["connectivityMilliseconds"] = ToMilliseconds(coldExtractStart - connectivityStart);
+    result["coldExtractMilliseconds"] = ToMilliseconds(coldExtractEnd - coldExtractStart);
+    result["extractMilliseconds"] = ToMilliseconds(compileStart - extractStart);
+    result["compileMilliseconds"] = ToMilliseconds(compileEnd - compileStart);
+    result["enterSimulationMilliseconds"] = ToMilliseconds(compileEnd - extractStart);
+    result["memoryBytes"] = static_cast<qint64>(residentAfter > residentBefore ? residentAfter - residentBefore : 0);
+
+    for (uint32_t tick = 0; tick < WARM_UP_TICKS; tick++)
+    {
+        engine.Tick();
+    }
+
+    const auto countersBefore = engine.GetCounters();
+    const auto tickStart = std::chrono::steady_clock::now();
+    auto tickEnd = tickStart;
+    uint64_t tickCount = 0;
+
+    while (tickEnd - tickStart < pDuration)
+    {
+        for (uint32_t tick = 0; tick < TICK_BATCH_SIZE; tick++)
+        {
+            engine.Tick();
+        }
+
+        tickCount += TICK_BATCH_SIZE;
+        tickEnd = std::chrono::steady_clock::now();
+    }
+
+    const auto& countersAfter = engine.GetCounters();
+    const double seconds = ToMilliseconds(tickEnd - tickStart) / 1000;
+
+    result["ticks"] = static_cast<qint64>(tickCount);
+    result["ticksPerSecond"] = tickCount / seconds;
+    result["evaluatedCellsPerTick"] = static_cast<double>(countersAfter.evaluatedCells - countersBefore.evaluatedCells) / tickCount;
+    result["inputEventsPerTick"] = static_cast<double>(countersAfter.inputEvents - countersBefore.inputEvents) / tickCount;
+
+    return result;
+}
+
+/// \brief Simulates the given circuit once tick by tick and once skipping idle ticks, like the worker and linkuit-sim do
+/// \param pGeometry: The circuit geometry
+/// \param pTicks: The number of ticks to simulate
+/// \param pSkippedTicks: Receives the number of skipped ticks if the states never differ
+/// \return The first tick after which the pin states differ, or 0 if they never differ
+uint64_t VerifyIdleSkipping(const CircuitGeometry& pGeometry, uint64_t pTicks, uint64_t& pSkippedTicks)
+{
+    NetlistExtractor extractor;
+    extractor.Extract(pGeometry);
+
+    SimulationEngine reference;
+    SimulationEngine skipping;
+    reference.Compile(extractor.GetNetlist());
+    skipping.Compile(extractor.GetNetlist());
+    reference.Reset();
+    skipping.Reset();
+
+    SimulationSnapshot referenceSnapshot;
+    SimulationSnapshot skippingSnapshot;
+    uint64_t referenceTick = 0;
+    uint64_t skippedTicks = 0;
+
+    for (uint64_t tick = 0; tick < pTicks; tick++)
+    {
+        // Skipping 0 ticks must leave the pending cells alone, so the call is deliberately not guarded
+        const uint64_t idleTicks = std::min(skipping.GetIdleTicks(), pTicks - tick - 1);
+        skipping.SkipIdleTicks(idleTicks);
+        tick += idleTicks;
+        skippedTicks += idleTicks;
+
+        skipping.Tick();
+
+        for (; referenceTick <= tick; referenceTick++)
+        {
+            reference.Tick();
+        }
+
+        reference.WriteSnapshot(referenceSnapshot);
+        skipping.WriteSnapshot(skippingSnapshot);
+
+        if (referenceSnapshot.inputStates != skippingSnapshot.inputStates || referenceSnapshot.outputStates != skippingSnapshot.outputStates)
+        {
+            return tick + 1;
+        }
+    }
+
+    pSkippedTicks = skippedTicks;
+    return 0;
+}
+
+/// \brief Simulates the given circuit in all lanes of a BatchSimulationEngine and compares every lane with a SimulationEngine
+/// The clocks are replaced with inputs. Every VERIFY_LANE_INPUT_PERIOD ticks, the inputs are driven with the next batch of
+/// the exhaustive input vectors, rotating the variables over the inputs, so the lanes see different edges at different times
+/// \param pGeometry: The circuit geometry
+/// \param pTicks: The number of ticks to simulate
+/// \param pLane: Receives the first differing lane if the states differ
+/// \return The first tick after which the pin states of a lane differ, or 0 if they never differ
+uint64_t VerifyBatchLanes(const CircuitGeometry& pGeometry, uint64_t pTicks, uint32_t& pLane)
+{
+    auto geometry = pGeometry;
+
+    for (auto& component : geometry.components)
+    {
+        if (component.cell.kernel == CellKernel::CLOCK)
+        {
+            component.cell.kernel = CellKernel::INPUT;
+        }
+    }
+
+    NetlistExtractor extractor;
+    extractor.Extract(geometry);
+    const auto& netlist = extractor.GetNetlist();
+
+    BatchSimulationEngine batch;
+    batch.Compile(netlist);
+    batch.Reset();
+
+    std::vector<SimulationEngine> lanes(BatchSimulationEngine::LANE_COUNT);
+    for (auto& lane : lanes)
+    {
+        lane.Compile(netlist);
+        lane.Reset();
+    }
+
+    std::vector<uint32_t> inputCells;
+    for (uint32_t cell = 0; cell < batch.GetCellCount(); cell++)
+    {
+        if (batch.GetKernel(cell) == CellKernel::INPUT)
+        {
+            inputCells.push_back(cell);
+        }
+    }
+
+    for (uint64_t tick = 0; tick < pTicks; tick++)
+    {
+        if (tick % VERIFY_LANE_INPUT_PERIOD == 0 && !inputCells.empty())
+        {
+            const uint64_t step = tick / VERIFY_LANE_INPUT_PERIOD;
+
+            for (uint32_t input = 0; input < inputCells.size(); input++)
+            {
+                const auto cell = inputCells[input];
+                const uint64_t states = BatchSimulationEngine::GetExhaustiveLanes((input + step) % inputCells.size(), step);
+                batch.SetInputLanes(cell, states);
+
+                for (uint32_t lane = 0; lane < lanes.size(); lane++)
+                {
+                    if (lanes[lane].GetOutputState(cell, 0) != (((states >> lane) & 1) != 0))
+                    {
+                        lanes[lane].ToggleInput(cell);
+                    }
+                }
+            }
+        }
+
+        batch.Tick();
+
+        for (auto& lane : lanes)
+        {
+            lane.Tick();
+        }
+
+        for (uint32_t cell = 0; cell < netlist.cells.size(); cell++)
+        {
+            // Gathers the pin states of all lanes into one word, bit n being the state in lane n
+            uint64_t differences = 0;
+
+            for (uint32_t input = 0; input < netlist.cells[cell].inputInverted.size(); input++)
+            {
+                uint64_t states = 0;
+                for (uint32_t lane = 0; lane < lanes.size(); lane++)
+                {
+                    states |= static_cast<uint64_t>(lanes[lane].GetInputState(cell, input)) << lane;
+                }
+                differences |= states ^ batch.GetInputLanes(cell, input);
+            }
+
+            for (uint32_t output = 0; output < netlist.cells[cell].outputInverted.size(); output++)
+            {
+                uint64_t states = 0;
+                for (uint32_t lane = 0; lane < lanes.size(); lane++)
+                {
+                    states |= static_cast<uint64_t>(lanes[lane].GetOutputState(cell, output)) << lane;
+                }
+                differences |= states ^ batch.GetOutputLanes(cell, output);
+            }
+
+            if (differences != 0)
+            {
+                // The lowest differing lane
+                pLane = 0;
+                while (((differences >> pLane) & 1) == 0)
+                {
+                    pLane++;
+                }
+                return tick + 1;
+            }
+        }
+    }
+
+    return 0;
+}
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("linkuit-bench");
+    QCoreApplication::setApplicationVersion(QString(FULL_VERSION));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Generates synthetic circuits and measures entering the simulation, ticks per second and memory");
+    parser.addHelpOption();
+    parser.addVersionOption();
+
+    const QCommandLineOption filterOption(QStringList() << "f" << "filter", "Only run benchmarks whose name contains the text.", "text");
+    const QCommandLineOption scaleOption(QStringList() << "s" << "scale", "Factor applied to all circuit sizes.", "factor", "1");
+    const QCommandLineOption durationOption(QStringList() << "d" << "duration", "Milliseconds to tick each circuit.", "ms", "1000");
+    const QCommandLineOption seedOption(QStringList() << "seed", "Seed of the random circuits.", "seed", "1");
+    const QCommandLineOption outputOption(QStringList() << "o" << "output", "Write the results to a file instead of stdout.", "file");
+    const QCommandLineOption verifyOption(QStringList() << "verify",
+                                          "Check that skipping idle ticks gives the same states as ticking every single tick and that every "
+                                          "lane of the batch engine matches the scalar engine instead of measuring, exits with 2 on differences.");
+    parser.addOption(filterOption);
+    parser.addOption(scaleOption);
+    parser.addOption(durationOption);
+    parser.addOption(seedOption);
+    parser.addOption(outputOption);
+    parser.addOption(verifyOption);
+
+    parser.process(app);
+
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    bool isScaleValid = false;
+    bool isDurationValid = false;
+    bool isSeedValid = false;
+    const double scale = parser.value(scaleOption).toDouble(&isScaleValid);
+    const std::chrono::milliseconds duration(parser.value(durationOption).toUInt(&isDurationValid));
+    const uint32_t seed = parser.value(seedOption).toUInt(&isSeedValid);
+
+    if (!isScaleValid || scale <= 0 || !isDurationValid || !isSeedValid)
+    {
+        err << "Invalid scale, duration or seed\n";
+        return 1;
+    }
+
+    const std::vector<BenchmarkCase> benchmarks{
+        {"random_dag", [](CircuitGenerator& pGenerator, double pScale) { return pGenerator.GenerateRandomDag(Scale(20000, pScale)); }},
+        {"ripple_carry_adders", [](CircuitGenerator& pGenerator, double pScale) { return pGenerator.GenerateRippleCarryAdders(Scale(256, pScale), 32); }},
+        {"counter_array", [](CircuitGenerator& pGenerator, double pScale) { return pGenerator.GenerateCounterArray(Scale(4096, pScale), 16); }},
+        {"shift_register_chain", [](CircuitGenerator& pGenerator, double pScale) { return pGenerator.GenerateShiftRegisterChain(Scale(4096, pScale), 16); }},
+        {"wire_mesh", [](CircuitGenerator& pGenerator, double pScale) { return pGenerator.GenerateWireMesh(Scale(300, std::sqrt(pScale))); }}
+    };
+
+    QJsonArray results;
+    bool isVerified = true;
+
+    for (const auto& benchmark : benchmarks)
+    {
+        if (parser.isSet(filterOption) && !QString(benchmark.name).contains(parser.value(filterOption)))
+        {
+            continue;
+        }
+
+        err << "Running " << benchmark.name << "\n";
+        err.flush();
+
+        // Every benchmark gets its own generator, so filtering doesn't change the generated circuits
+        CircuitGenerator generator(seed);
+        const auto geometry = benchmark.generate(generator, scale);
+
+        if (parser.isSet(verifyOption))
+        {
+            // The generated clocks are fast, with slowed down clocks the logic settles and goes idle between the edges
+            auto slowGeometry = geometry;
+
+            for (auto& component : slowGeometry.components)
+            {
+                if (component.cell.kernel == CellKernel::CLOCK)
+                {
+                    component.cell.parameters.toggleTicks *= VERIFY_CLOCK_SLOWDOWN;
+                }
+            }
+
+            for (const auto& circuit : {&geometry, &slowGeometry})
+            {
+                uint64_t skippedTicks = 0;
+                const uint64_t mismatchTick = VerifyIdleSkipping(*circuit, VERIFY_TICKS, skippedTicks);
+
+                if (mismatchTick != 0)
+                {
+                    err << "States differ after tick " << mismatchTick << "\n";
+                    isVerified = false;
+                }
+                else
+                {
+                    err << "Identical, " << skippedTicks << " of " << VERIFY_TICKS << " ticks skipped\n";
+                }
+            }
+
+            CircuitGenerator laneGenerator(seed);
+            uint32_t mismatchLane = 0;
+            const uint64_t mismatchTick = VerifyBatchLanes(benchmark.generate(laneGenerator, scale * VERIFY_LANE_SCALE), VERIFY_LANE_TICKS, mismatchLane);
+
+            if (mismatchTick != 0)
+            {
+                err << "Lane " << mismatchLane << " differs from the scalar engine after tick " << mismatchTick << "\n";
+                isVerified = false;
+            }
+            else
+            {
+                err << "All " << BatchSimulationEngine::LANE_COUNT << " lanes identical to the scalar engine\n";
+            }
+            continue;
+        }
+
+        auto result = RunBenchmark(geometry, duration);
+        result["name"] = benchmark.name;
+        results.append(result);
+    }
+
+    if (parser.isSet(verifyOption))
+    {
+        return (isVerified ? 0 : 2);
+    }
+
+    QJsonObject report;
+    report["version"] = QString(FULL_VERSION);
+    report["scale"] = scale;
+    report["seed"] = static_cast<qint64>(seed);
+    report["benchmarks"] = results;
+
+    const auto json = QJsonDocument(report).toJson(QJsonDocument::Indented);
+
+    if (parser.isSet(outputOption))
+    {
+        QFile outputFile(parser.value(outputOption));
+
+        if (!outputFile.open(QIODevice::WriteOnly | QIODevice::Truncate) || outputFile.write(json) != json.size())
+        {
+            err << "Could not write " << outputFile.fileName() << "\n";
+            return 1;
+        }
+    }
+    else
+    {
+        out << json;
+    }
+
+    return 0;
+}
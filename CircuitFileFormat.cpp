@@ -0,0 +1,38 @@
+#include "CircuitFileFormat.h"
+#include "Configuration.h"
+
+#include <QCborMap>
+#include <QCborValue>
+#include <QJsonDocument>
+
+std::optional<QJsonObject> DecodeCircuitFile(const QByteArray& pRawData)
+{
+    if (file::SAVE_FORMAT == file::SaveFormat::BINARY)
+    {
+        const auto rawData = qUncompress(pRawData);
+
+        if (rawData.isEmpty())
+        {
+            // if the data could not be decompressed
+            return std::nullopt;
+        }
+
+        return QCborValue::fromCbor(rawData).toMap().toJsonObject();
+    }
+    else
+    {
+        return QJsonDocument::fromJson(pRawData).object();
+    }
+}
+
+QByteArray EncodeCircuitFile(const QJsonObject& pJson)
+{
+    if (file::SAVE_FORMAT == file::SaveFormat::BINARY)
+    {
+        return qCompress(QCborValue::fromJsonValue(pJson).toCbor(), 9);
+    }
+    else
+    {
+        return QJsonDocument(pJson).toJson(QJsonDocument::Compact);
+    }
+}
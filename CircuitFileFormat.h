@@ -0,0 +1,18 @@
+#ifndef CIRCUITFILEFORMAT_H
+#define CIRCUITFILEFORMAT_H
+
+#include <QByteArray>
+#include <QJsonObject>
+#include <optional>
+
+/// \brief Decodes the raw content of a circuit file in the configured save format
+/// \param pRawData: The file content
+/// \return The circuit JSON, or nothing if the data could not be decoded
+std::optional<QJsonObject> DecodeCircuitFile(const QByteArray& pRawData);
+
+/// \brief Encodes the circuit JSON in the configured save format
+/// \param pJson: The circuit JSON
+/// \return The file content
+QByteArray EncodeCircuitFile(const QJsonObject& pJson);
+
+#endif // CIRCUITFILEFORMAT_H
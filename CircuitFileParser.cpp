@@ -1,4 +1,5 @@
 #include "CircuitFileParser.h"
+#include "CircuitFileFormat.h"
 #include "Configuration.h"
 
 CircuitFileParser::CircuitFileParser(RuntimeConfigParser& pRuntimeConfigParser):
@@ -16,33 +17,17 @@ void CircuitFileParser::LoadJson(const QFileInfo& pFileInfo, bool pIsFromRecents
         return;
     }
 
-    QByteArray rawData = loadFile.readAll();
+    const auto json = DecodeCircuitFile(loadFile.readAll());
 
-    if (file::SAVE_FORMAT == file::SaveFormat::BINARY)
+    if (!json.has_value())
     {
-        rawData = qUncompress(rawData);
-
-        if (rawData.isEmpty())
-        {
-            // if the data could not be decompressed
-            emit LoadCircuitFileFailedSignal(pFileInfo, pIsFromRecents);
-            return;
-        }
-
-        auto jsonDoc = QJsonDocument(QCborValue::fromCbor(rawData).toMap().toJsonObject());
-
-        mCurrentFile = pFileInfo;
-        mRuntimeConfigParser.AddRecentFilePath(mCurrentFile.value());
-        emit LoadCircuitFileSuccessSignal(mCurrentFile.value(), jsonDoc.object());
+        emit LoadCircuitFileFailedSignal(pFileInfo, pIsFromRecents);
+        return;
     }
-    else
-    {
-        auto jsonDoc = QJsonDocument::fromJson(rawData);
 
-        mCurrentFile = pFileInfo;
-        mRuntimeConfigParser.AddRecentFilePath(mCurrentFile.value());
-        emit LoadCircuitFileSuccessSignal(mCurrentFile.value(), jsonDoc.object());
-    }
+    mCurrentFile = pFileInfo;
+    mRuntimeConfigParser.AddRecentFilePath(mCurrentFile.value());
+    emit LoadCircuitFileSuccessSignal(mCurrentFile.value(), json.value());
 
     mRuntimeConfigParser.SetLastFilePath(pFileInfo.path());
 }
@@ -65,16 +50,7 @@ void CircuitFileParser::SaveJsonAs(const QFileInfo& pFileInfo, const QJsonObject
         return;
     }
 
-    if (file::SAVE_FORMAT == file::SaveFormat::BINARY)
-    {
-        auto bin = QCborValue::fromJsonValue(pJson).toCbor();
-        saveFile.write(qCompress(bin, 9));
-    }
-    else
-    {
-        auto json = QJsonDocument(pJson).toJson(QJsonDocument::Compact);
-        saveFile.write(json);
-    }
+    saveFile.write(EncodeCircuitFile(pJson));
 
     mCurrentFile = pFileInfo;
     mIsCircuitModified = false;
@@ -1,4 +1,5 @@
 HEADERS += \
+    $$PWD/CircuitFileFormat.h \
     $$PWD/CircuitFileParser.h \
     $$PWD/Components/ComplexLogic/Counter.h \
     $$PWD/Components/ComplexLogic/DMsFlipFlop.h \
@@ -35,8 +36,26 @@ HEADERS += \
     $$PWD/Components/Inputs/LogicClock.h \
     $$PWD/Components/Inputs/LogicConstant.h \
     $$PWD/Components/LogicDiodeCell.h \
+    $$PWD/Components/PinMask.h \
     $$PWD/Gui/PieMenu.h \
+    $$PWD/Gui/StatisticsDialog.h \
+    $$PWD/Gui/WaveformStrip.h \
     $$PWD/RuntimeConfigParser.h \
+    $$PWD/Simulation/CircuitGeometry.h \
+    $$PWD/Simulation/CircuitGeometryReader.h \
+    $$PWD/Simulation/CompiledNetlist.h \
+    $$PWD/Simulation/ConnectivityModel.h \
+    $$PWD/Simulation/ExtractionWorker.h \
+    $$PWD/Simulation/GridIndex.h \
+    $$PWD/Simulation/Netlist.h \
+    $$PWD/Simulation/NetlistExtractor.h \
+    $$PWD/Simulation/SimulationEngine.h \
+    $$PWD/Simulation/SimulationHistory.h \
+    $$PWD/Simulation/SimulationProfiler.h \
+    $$PWD/Simulation/SimulationSnapshot.h \
+    $$PWD/Simulation/SimulationWorker.h \
+    $$PWD/Simulation/TimingWheel.h \
+    $$PWD/Simulation/WaveformRecorder.h \
     $$PWD/Undo/UndoCopyType.h \
     $${PWD}/Components/ComplexLogic/DFlipFlop.h \
     $${PWD}/Components/ComplexLogic/LogicCells/LogicDFlipFlopCell.h \
@@ -81,6 +100,7 @@ HEADERS += \
     $${PWD}/Gui/TutorialFrame.h
 
 SOURCES += \
+    $$PWD/CircuitFileFormat.cpp \
     $$PWD/CircuitFileParser.cpp \
     $$PWD/Components/ComplexLogic/Counter.cpp \
     $$PWD/Components/ComplexLogic/DMsFlipFlop.cpp \
@@ -117,8 +137,24 @@ SOURCES += \
     $$PWD/Components/Inputs/LogicClock.cpp \
     $$PWD/Components/Inputs/LogicConstant.cpp \
     $$PWD/Components/LogicDiodeCell.cpp \
+    $$PWD/Components/PinMask.cpp \
     $$PWD/Gui/PieMenu.cpp \
+    $$PWD/Gui/StatisticsDialog.cpp \
+    $$PWD/Gui/WaveformStrip.cpp \
     $$PWD/RuntimeConfigParser.cpp \
+    $$PWD/Simulation/CircuitGeometryReader.cpp \
+    $$PWD/Simulation/CompiledNetlist.cpp \
+    $$PWD/Simulation/ConnectivityModel.cpp \
+    $$PWD/Simulation/ExtractionWorker.cpp \
+    $$PWD/Simulation/GridIndex.cpp \
+    $$PWD/Simulation/NetlistExtractor.cpp \
+    $$PWD/Simulation/SimulationEngine.cpp \
+    $$PWD/Simulation/SimulationHistory.cpp \
+    $$PWD/Simulation/SimulationProfiler.cpp \
+    $$PWD/Simulation/SimulationSnapshot.cpp \
+    $$PWD/Simulation/SimulationWorker.cpp \
+    $$PWD/Simulation/TimingWheel.cpp \
+    $$PWD/Simulation/WaveformRecorder.cpp \
     $$PWD/Undo/UndoCopyType.cpp \
     $${PWD}/Components/ComplexLogic/DFlipFlop.cpp \
     $${PWD}/Components/ComplexLogic/LogicCells/LogicDFlipFlopCell.cpp \
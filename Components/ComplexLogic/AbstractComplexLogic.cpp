@@ -129,6 +129,11 @@ AbstractComplexLogic::AbstractComplexLogic(const CoreLogic* pCoreLogic, const st
     AbstractComplexLogic::SetLogicConnectors();
 }
 
+bool AbstractComplexLogic::HasDelay() const
+{
+    return true;
+}
+
 void AbstractComplexLogic::SetLogicConnectors()
 {
     switch(mDirection)
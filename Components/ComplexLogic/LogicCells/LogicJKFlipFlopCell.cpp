@@ -26,111 +26,10 @@
 #include "LogicJKFlipFlopCell.h"
 
 LogicJKFlipFlopCell::LogicJKFlipFlopCell():
-    LogicBaseCell(3, 2),
-    mOutputStates(2, LogicState::LOW),
-    mPrevInputStates(2, LogicState::LOW),
-    mStateChanged(true)
+    LogicBaseCell(3, 2)
 {}
 
-void LogicJKFlipFlopCell::LogicFunction()
+CellKernel LogicJKFlipFlopCell::GetKernel() const
 {
-    if (mPrevInputStates[1] == LogicState::LOW && mInputStates[1] == LogicState::HIGH) // rising edge
-    {
-        if (mPrevInputStates[0] == LogicState::HIGH && mPrevInputStates[2] == LogicState::HIGH) // both => toggle
-        {
-            if (mOutputStates[0] == LogicState::LOW)
-            {
-                mOutputStates[0] = LogicState::HIGH;
-            }
-            else
-            {
-                mOutputStates[0] = LogicState::LOW;
-            }
-        }
-        else if (mPrevInputStates[0] == LogicState::HIGH && mPrevInputStates[2] == LogicState::LOW) // J => pull up
-        {
-            mOutputStates[0] = LogicState::HIGH;
-        }
-        else if (mPrevInputStates[0] == LogicState::LOW && mPrevInputStates[2] == LogicState::HIGH) // K => pull down
-        {
-            mOutputStates[0] = LogicState::LOW;
-        }
-
-        mOutputStates[1] = ((mOutputStates[0] == LogicState::HIGH) ? LogicState::LOW : LogicState::HIGH);
-
-        mStateChanged = true;
-    }
-
-    if (mPrevInputStates[1] != mInputStates[1]) // Trigger repaint on every clock change
-    {
-        mStateChanged = true;
-    }
-
-    mPrevInputStates = mInputStates;
-}
-
-LogicState LogicJKFlipFlopCell::GetOutputState(uint32_t pOutput) const
-{
-    Q_ASSERT(pOutput <= 1);
-    if (mOutputInverted[pOutput] && mIsActive)
-    {
-        return InvertState(mOutputStates[pOutput]);
-    }
-    else
-    {
-        return mOutputStates[pOutput];
-    }
-}
-
-void LogicJKFlipFlopCell::OnSimulationAdvance()
-{
-    AdvanceUpdateTime();
-
-    if (mStateChanged)
-    {
-        mStateChanged = false;
-        NotifySuccessor(0, mOutputStates[0]);
-        NotifySuccessor(1, mOutputStates[1]);
-
-        emit StateChangedSignal();
-    }
-}
-
-void LogicJKFlipFlopCell::InputReady(uint32_t pInput, LogicState pState)
-{
-    if (mInputStates[pInput] != pState)
-    {
-        emit StateChangedSignal(); // to trigger immediate update of the component
-    }
-    LogicBaseCell::InputReady(pInput, pState);
-}
-
-void LogicJKFlipFlopCell::OnWakeUp()
-{   
-    mInputStates = std::vector<LogicState>(mInputStates.size(), LogicState::LOW);
-
-    for (size_t i = 0; i < mInputStates.size(); i++)
-    {
-        mInputStates[i] = mInputInverted[i] ? LogicState::HIGH : LogicState::LOW;
-    }
-
-    mPrevInputStates = std::vector<LogicState>(mInputStates.size(), LogicState::LOW);
-
-    mOutputStates[0] = LogicState::LOW;
-    mOutputStates[1] = LogicState::HIGH;
-    mNextUpdateTime = UpdateTime::NOW;
-
-    mStateChanged = true; // Successors should be notified about wake up
-    mIsActive = true;
-    emit StateChangedSignal();
-}
-
-void LogicJKFlipFlopCell::OnShutdown()
-{
-    mOutputCells = std::vector<std::pair<std::shared_ptr<LogicBaseCell>, uint32_t>>(mOutputCells.size(), std::make_pair(nullptr, 0));
-    mInputStates = std::vector<LogicState>(mInputStates.size(), LogicState::LOW);
-    mInputConnected = std::vector<bool>(mInputConnected.size(), false);
-    mOutputStates = std::vector<LogicState>(mOutputStates.size(), LogicState::LOW);
-    mIsActive = false;
-    emit StateChangedSignal();
+    return CellKernel::JK_FLIPFLOP;
 }
@@ -38,6 +38,11 @@ AbstractGate::AbstractGate(const CoreLogic* pCoreLogic, const std::shared_ptr<Lo
     SetLogicConnectors();
 }
 
+bool AbstractGate::HasDelay() const
+{
+    return true;
+}
+
 void AbstractGate::SetLogicConnectors()
 {
     switch(mDirection)
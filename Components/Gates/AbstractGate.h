@@ -37,6 +37,10 @@ public:
     /// \return the minimum version
     SwVersion GetMinVersion(void) const override = 0;
 
+    /// \brief Gates and complex components have a propagation delay
+    /// \return True
+    bool HasDelay(void) const override;
+
 protected:
     /// \brief Paints the abstract gate component
     /// \param pPainter: The painter to use
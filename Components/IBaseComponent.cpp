@@ -48,10 +48,39 @@ IBaseComponent::IBaseComponent(const CoreLogic* pCoreLogic, const std::shared_pt
 
     if (mLogicCell != nullptr)
     {
-        QObject::connect(pCoreLogic, &CoreLogic::SimulationAdvanceSignal, mLogicCell.get(), &LogicBaseCell::OnSimulationAdvance);
         QObject::connect(pCoreLogic, &CoreLogic::SimulationStopSignal, mLogicCell.get(), &LogicBaseCell::OnShutdown);
         QObject::connect(pCoreLogic, &CoreLogic::SimulationStartSignal,mLogicCell.get(), &LogicBaseCell::OnWakeUp);
         QObject::connect(mLogicCell.get(), &LogicBaseCell::StateChangedSignal, this, &IBaseComponent::OnLogicStateChanged);
+        QObject::connect(mLogicCell.get(), &LogicBaseCell::InputActivatedSignal, pCoreLogic, &CoreLogic::OnInputActivated);
+    }
+}
+
+bool IBaseComponent::HasDelay() const
+{
+    return false;
+}
+
+void IBaseComponent::SaveDelay(QJsonObject& pJson) const
+{
+    if (HasDelay())
+    {
+        pJson["delay"] = static_cast<int32_t>(mLogicCell->GetDelay());
+    }
+}
+
+void IBaseComponent::LoadDelay(const QJsonObject& pJson)
+{
+    if (HasDelay())
+    {
+        mLogicCell->SetDelay(pJson["delay"].toInt(DEFAULT_CELL_DELAY));
+    }
+}
+
+void IBaseComponent::CopyDelay(const IBaseComponent& pObj)
+{
+    if (HasDelay() && pObj.HasDelay())
+    {
+        mLogicCell->SetDelay(pObj.mLogicCell->GetDelay());
     }
 }
 
@@ -94,6 +94,23 @@ public:
     /// \return the minimum version
     virtual SwVersion GetMinVersion(void) const = 0;
 
+    /// \brief Returns true, if this component's logic cell has a propagation delay, which is saved with the component
+    /// \return True for gates and complex components
+    virtual bool HasDelay(void) const;
+
+    /// \brief Saves the propagation delay of this component's logic cell to the given component JSON, if it has one
+    /// \param pJson: The JSON object returned by GetJson
+    void SaveDelay(QJsonObject& pJson) const;
+
+    /// \brief Loads the propagation delay of this component's logic cell from the given component JSON, if it has one
+    /// Files without a delay get the default delay
+    /// \param pJson: The JSON object of the component
+    void LoadDelay(const QJsonObject& pJson);
+
+    /// \brief Copies the propagation delay of the logic cell of the given component, to be called on clones
+    /// \param pObj: The component this component has been cloned from
+    void CopyDelay(const IBaseComponent& pObj);
+
 protected slots:
     /// \brief Updates when this component's logic state changed
     void OnLogicStateChanged(void);
@@ -13,10 +13,7 @@ public:
     /// \brief Constructor for LogicButtonCell
     LogicButtonCell(void);
 
-    /// \brief The logic function that determines the output state
-    void LogicFunction(void) override;
-
-    /// \brief Sets the button state to HIGH, resets the remaining ticks and propagates immediately
+    /// \brief Requests the simulation to set the button state to HIGH and reset the remaining ticks
     void ButtonClick(void);
 
     /// \brief Getter for the current output state number pOutput of this cell
@@ -24,20 +21,13 @@ public:
     /// \return The logic state of this cell's output number pOutput
     LogicState GetOutputState(uint32_t pOutput = 0) const override;
 
-public slots:
-    /// \brief Advances the simulation of this cell by one logic tick
-    void OnSimulationAdvance(void) override;
-
-    /// \brief Sets the in- and outputs low for edit mode and triggers a component repaint
-    void OnShutdown(void) override;
-
-    /// \brief Initializes the logic cell's states and triggers a component repaint
-    void OnWakeUp(void) override;
+    /// \brief Getter for the kernel the simulation engine evaluates for this cell
+    /// \return The cell kernel
+    CellKernel GetKernel(void) const override;
 
-protected:
-    LogicState mState;
-    uint32_t mRemainingTicks;
-    bool mStateChanged;
+    /// \brief Getter for the kernel parameters of this cell
+    /// \return The kernel parameters containing the button hold duration
+    CellParameters GetParameters(void) const override;
 };
 
 #endif // LOGICBUTTONCELL_H
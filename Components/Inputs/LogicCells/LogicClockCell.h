@@ -13,13 +13,13 @@ public:
     /// \brief Constructor for LogicClockCell
     LogicClockCell(void);
 
-    /// \brief The logic function that determines the output states based on the inputs
-    void LogicFunction(void) override;
+    /// \brief Getter for the kernel the simulation engine evaluates for this cell
+    /// \return The cell kernel
+    CellKernel GetKernel(void) const override;
 
-    /// \brief Getter for the current output state number pOutput of this cell
-    /// \param pOutput: The number of the output to retreive
-    /// \return The logic state of this cell's output number pOutput
-    LogicState GetOutputState(uint32_t pOutput = 0) const override;
+    /// \brief Getter for the kernel parameters of this cell
+    /// \return The kernel parameters containing the clock timing and mode
+    CellParameters GetParameters(void) const override;
 
     /// \brief Sets the toggle speed of this clock logic cell
     /// \param pTicks: The new toggle speed in ticks
@@ -45,27 +45,10 @@ public:
     /// \return The clock mode (toggle or pulse)
     ClockMode GetClockMode(void);
 
-public slots:
-    /// \brief Advances the simulation of this cell by one logic tick
-    void OnSimulationAdvance(void) override;
-
-    /// \brief Sets the in- and outputs low for edit mode and triggers a component repaint
-    void OnShutdown(void) override;
-
-    /// \brief Initializes the logic cell's states and triggers a component repaint
-    void OnWakeUp(void) override;
-
 protected:
-    LogicState mState;
-
     uint32_t mToggleTicks;
     uint32_t mPulseTicks;
 
-    uint32_t mTickCountdown;
-    uint32_t mPulseCountdown;
-
-    bool mStateChanged;
-
     ClockMode mMode;
 };
 
@@ -2,46 +2,28 @@
 
 LogicConstantCell::LogicConstantCell(LogicState pConstantState):
     LogicBaseCell(0, 1),
-    mState(LogicState::LOW),
-    mConstantState(pConstantState),
-    mStateChanged(true)
+    mConstantState(pConstantState)
 {}
 
 LogicState LogicConstantCell::GetOutputState(uint32_t pOutput) const
 {
     Q_UNUSED(pOutput);
-    return mState;
+    return GetEngineOutputState(0);
 }
 
-void LogicConstantCell::OnSimulationAdvance()
-{
-    if (mStateChanged)
-    {
-        mStateChanged = false;
-        NotifySuccessor(0, mState);
-
-        emit StateChangedSignal();
-    }
-}
-
-void LogicConstantCell::OnWakeUp()
+LogicState LogicConstantCell::GetConstantState() const
 {
-    mState = mConstantState;
-
-    mStateChanged = true; // Successors should be notified about wake up
-    mIsActive = true;
-    emit StateChangedSignal();
+    return mConstantState;
 }
 
-void LogicConstantCell::OnShutdown()
+CellKernel LogicConstantCell::GetKernel() const
 {
-    mOutputCells = std::vector<std::pair<std::shared_ptr<LogicBaseCell>, uint32_t>>(mOutputCells.size(), std::make_pair(nullptr, 0));
-    mState = LogicState::LOW;
-    mIsActive = false;
-    emit StateChangedSignal();
+    return CellKernel::CONSTANT;
 }
 
-LogicState LogicConstantCell::GetConstantState() const
+CellParameters LogicConstantCell::GetParameters() const
 {
-    return mConstantState;
+    CellParameters parameters;
+    parameters.constantState = (mConstantState == LogicState::HIGH);
+    return parameters;
 }
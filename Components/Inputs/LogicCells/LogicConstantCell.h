@@ -22,21 +22,16 @@ public:
     /// \return the constant logic state of this logic cell
     LogicState GetConstantState(void) const;
 
-public slots:
-    /// \brief Advances the simulation of this cell by one logic tick
-    void OnSimulationAdvance(void) override;
+    /// \brief Getter for the kernel the simulation engine evaluates for this cell
+    /// \return The cell kernel
+    CellKernel GetKernel(void) const override;
 
-    /// \brief Sets the in- and outputs low for edit mode and triggers a component repaint
-    void OnShutdown(void) override;
-
-    /// \brief Initializes the logic cell's states and triggers a component repaint
-    void OnWakeUp(void) override;
+    /// \brief Getter for the kernel parameters of this cell
+    /// \return The kernel parameters containing the constant state
+    CellParameters GetParameters(void) const override;
 
 protected:
-    LogicState mState;
     LogicState mConstantState;
-
-    bool mStateChanged;
 };
 
 #endif // LOGICCONSTANTCELL_H
@@ -1,35 +1,24 @@
 #include "LogicInputCell.h"
 
 LogicInputCell::LogicInputCell():
-    LogicBaseCell(0, 1),
-    mState(LogicState::LOW)
+    LogicBaseCell(0, 1)
 {}
 
 void LogicInputCell::ToggleState()
 {
-    mState = ((mState == LogicState::HIGH) ? LogicState::LOW : LogicState::HIGH);
-
-    NotifySuccessor(0, mState);
-    emit StateChangedSignal();
+    if (nullptr != mSnapshot)
+    {
+        emit InputActivatedSignal(mEngineIndex);
+    }
 }
 
 LogicState LogicInputCell::GetOutputState(uint32_t pOutput) const
 {
     Q_UNUSED(pOutput);
-    return mState;
-}
-
-void LogicInputCell::OnWakeUp()
-{
-    mState = LogicState::LOW;
-    mIsActive = true;
-    emit StateChangedSignal();
+    return GetEngineOutputState(0);
 }
 
-void LogicInputCell::OnShutdown()
+CellKernel LogicInputCell::GetKernel() const
 {
-    mOutputCells = std::vector<std::pair<std::shared_ptr<LogicBaseCell>, uint32_t>>(mOutputCells.size(), std::make_pair(nullptr, 0));
-    mState = LogicState::LOW;
-    mIsActive = false;
-    emit StateChangedSignal();
+    return CellKernel::INPUT;
 }
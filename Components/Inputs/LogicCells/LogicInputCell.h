@@ -13,7 +13,7 @@ public:
     /// \brief Constructor for LogicInputCell
     LogicInputCell(void);
 
-    /// \brief Toggles the input's logic state
+    /// \brief Requests the simulation to toggle the input's logic state
     void ToggleState(void);
 
     /// \brief Getter for the current output state number pOutput of this cell
@@ -21,15 +21,9 @@ public:
     /// \return The logic state of this cell's output number pOutput
     LogicState GetOutputState(uint32_t pOutput = 0) const override;
 
-public slots:
-    /// \brief Sets the in- and outputs low for edit mode and triggers a component repaint
-    void OnShutdown(void) override;
-
-    /// \brief Initializes the logic cell's states and triggers a component repaint
-    void OnWakeUp(void) override;
-
-protected:
-    LogicState mState;
+    /// \brief Getter for the kernel the simulation engine evaluates for this cell
+    /// \return The cell kernel
+    CellKernel GetKernel(void) const override;
 };
 
 #endif // LOGICINPUTCELL_H
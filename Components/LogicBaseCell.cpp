@@ -1,86 +1,114 @@
 #include "LogicBaseCell.h"
-
-#include <QThread>
-#include <QDebug>
+#include "Simulation/SimulationSnapshot.h"
 
 LogicBaseCell::LogicBaseCell(uint32_t pInputs, uint32_t pOutputs):
-    mInputStates(pInputs, LogicState::LOW),
-    mInputConnected(pInputs, false),
-    mInputInverted(pInputs, false),
-    mOutputInverted(pOutputs, false),
-    mOutputCells(pOutputs, std::make_pair(nullptr, 0)),
-    mNextUpdateTime(UpdateTime::INF),
+    mInputConnected(pInputs),
+    mOutputConnected(pOutputs),
+    mInputInverted(pInputs),
+    mOutputInverted(pOutputs),
+    mDelay(DEFAULT_CELL_DELAY),
+    mSnapshot(nullptr),
+    mEngineIndex(0),
     mIsActive(false)
 {}
 
-void LogicBaseCell::ConnectOutput(const std::shared_ptr<LogicBaseCell>& pLogicCell, uint32_t pInput, uint32_t pOutput)
+CellParameters LogicBaseCell::GetParameters() const
 {
-    mOutputCells[pOutput] = std::make_pair(pLogicCell, pInput);
+    CellParameters parameters;
+    parameters.delay = mDelay;
+    return parameters;
 }
 
-void LogicBaseCell::SetConnected(uint32_t pInput)
+uint32_t LogicBaseCell::GetDelay() const
 {
-    mInputConnected[pInput] = true;
+    return mDelay;
+}
+
+void LogicBaseCell::SetDelay(int64_t pDelay)
+{
+    mDelay = ClampCellDelay(pDelay);
+}
+
+void LogicBaseCell::AttachToSimulation(const SimulationSnapshot* pSnapshot, uint32_t pIndex)
+{
+    mSnapshot = pSnapshot;
+    mEngineIndex = pIndex;
+}
+
+uint32_t LogicBaseCell::GetEngineIndex() const
+{
+    return mEngineIndex;
+}
+
+void LogicBaseCell::SetInputConnected(uint32_t pInput)
+{
+    mInputConnected.Set(pInput);
+}
+
+void LogicBaseCell::SetOutputConnected(uint32_t pOutput)
+{
+    mOutputConnected.Set(pOutput);
 }
 
 bool LogicBaseCell::IsInputConnected(uint32_t pInput)
 {
-    return mInputConnected[pInput];
+    return mInputConnected.Test(pInput);
 }
 
 bool LogicBaseCell::IsOutputConnected(uint32_t pOutput)
 {
-    return (nullptr != mOutputCells[pOutput].first);
+    return mOutputConnected.Test(pOutput);
 }
 
 LogicState LogicBaseCell::GetInputState(uint32_t pInput) const
 {
-    Q_ASSERT(mInputStates.size() > pInput);
-    return mInputStates[pInput];
+    Q_ASSERT(mInputInverted.Size() > pInput);
+    if (!mIsActive || nullptr == mSnapshot)
+    {
+        return LogicState::LOW;
+    }
+
+    return mSnapshot->GetInputState(mEngineIndex, pInput) ? LogicState::HIGH : LogicState::LOW;
 }
 
 std::vector<bool> LogicBaseCell::GetInputInversions() const
 {
-    return mInputInverted;
+    return mInputInverted.ToVector();
 }
 
 void LogicBaseCell::SetInputInversions(const std::vector<bool>& pInputInversions)
 {
-    mInputInverted = pInputInversions;
+    mInputInverted.Assign(pInputInversions);
 }
 
 bool LogicBaseCell::IsInputInverted(uint32_t pInput) const
 {
-    Q_ASSERT(mInputInverted.size() > pInput);
-    return mInputInverted[pInput];
+    return mInputInverted.Test(pInput);
 }
 
 void LogicBaseCell::InvertInput(uint32_t pInput)
 {
-    Q_ASSERT(pInput < mInputInverted.size());
-    mInputInverted[pInput] = !mInputInverted[pInput];
+    mInputInverted.Flip(pInput);
 }
 
 std::vector<bool> LogicBaseCell::GetOutputInversions() const
 {
-    return mOutputInverted;
+    return mOutputInverted.ToVector();
 }
 
 void LogicBaseCell::SetOutputInversions(const std::vector<bool>& pOutputInversions)
 {
-    mOutputInverted = pOutputInversions;
+    mOutputInverted.Assign(pOutputInversions);
 }
 
 bool LogicBaseCell::IsOutputInverted(uint32_t pOutput) const
 {
-    Q_ASSERT(mOutputInverted.size() > pOutput);
-    return mOutputInverted[pOutput];
+    return mOutputInverted.Test(pOutput);
 }
 
 void LogicBaseCell::InvertOutput(uint32_t pOutput)
 {
-    Q_ASSERT(pOutput < mOutputInverted.size());
-    mOutputInverted[pOutput] = !mOutputInverted[pOutput];
+    mOutputInverted.Flip(pOutput);
 }
 
 bool LogicBaseCell::IsActive() const
@@ -88,86 +116,39 @@ bool LogicBaseCell::IsActive() const
     return mIsActive;
 }
 
-void LogicBaseCell::NotifySuccessor(uint32_t pOutput, LogicState pState) const
+LogicState LogicBaseCell::GetOutputState(uint32_t pOutput) const
 {
-    Q_ASSERT(mOutputCells.size() > pOutput);
-    if (mOutputCells[pOutput].first != nullptr) // If successor exists
+    if (mOutputInverted.Test(pOutput) && mIsActive)
     {
-        if (mOutputCells[pOutput].first->IsInputInverted(mOutputCells[pOutput].second))
-        {
-            const auto&& forwardedState = ApplyInversion(InvertState(pState), pOutput);
-            mOutputCells[pOutput].first->InputReady(mOutputCells[pOutput].second, forwardedState);
-        }
-        else
-        {
-            const auto&& forwardedState = ApplyInversion(pState, pOutput);
-            mOutputCells[pOutput].first->InputReady(mOutputCells[pOutput].second, forwardedState);
-        }
-    }
-}
-
-LogicState LogicBaseCell::ApplyInversion(LogicState pState, uint32_t pOutput) const
-{
-    Q_ASSERT(mOutputInverted.size() > pOutput);
-    if (mOutputInverted[pOutput])
-    {
-        return InvertState(pState);
+        return InvertState(GetEngineOutputState(pOutput));
     }
     else
     {
-        return pState;
+        return GetEngineOutputState(pOutput);
     }
 }
 
-void LogicBaseCell::InputReady(uint32_t pInput, LogicState pState)
+LogicState LogicBaseCell::GetEngineOutputState(uint32_t pOutput) const
 {
-    if (mInputStates[pInput] != pState)
+    if (!mIsActive || nullptr == mSnapshot)
     {
-        mInputStates[pInput] = pState;
-        mNextUpdateTime = UpdateTime::NEXT_TICK;
+        return LogicState::LOW;
     }
-}
 
-bool LogicBaseCell::AssureState(LogicState &pSubject, const LogicState &pTargetState)
-{
-    if (pSubject != pTargetState)
-    {
-        pSubject = pTargetState;
-        return true;
-    }
-
-    return false;
+    return mSnapshot->GetOutputState(mEngineIndex, pOutput) ? LogicState::HIGH : LogicState::LOW;
 }
 
-bool LogicBaseCell::AssureStateIf(bool pCondition, LogicState &pSubject, const LogicState &pTargetState)
+void LogicBaseCell::OnShutdown()
 {
-    if (pCondition && pSubject != pTargetState)
-    {
-        pSubject = pTargetState;
-        return true;
-    }
-
-    return false;
+    mInputConnected.Reset();
+    mOutputConnected.Reset();
+    mSnapshot = nullptr;
+    mIsActive = false;
+    emit StateChangedSignal();
 }
 
-void LogicBaseCell::AdvanceUpdateTime()
+void LogicBaseCell::OnWakeUp()
 {
-    switch (mNextUpdateTime)
-    {
-        case UpdateTime::NEXT_TICK:
-        {
-            mNextUpdateTime = UpdateTime::NOW; // Update in next cycle
-            break;
-        }
-        case UpdateTime::NOW:
-        {
-            LogicFunction(); // Update output states now
-            mNextUpdateTime = UpdateTime::INF;
-            break;
-        }
-        case UpdateTime::INF:
-        {
-            break; // No update scheduled
-        }
-    }
+    mIsActive = true;
+    emit StateChangedSignal();
 }
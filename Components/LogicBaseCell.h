@@ -2,16 +2,12 @@
 #define LOGICBASECELL_H
 
 #include "HelperFunctions.h"
+#include "PinMask.h"
+#include "Simulation/Netlist.h"
 
 #include <QObject>
 
-/// \brief UpdateTime contains values to indicate when the logic cell should update its state
-enum class UpdateTime
-{
-    NOW = 0,
-    NEXT_TICK,
-    INF
-};
+struct SimulationSnapshot;
 
 ///
 /// \brief The LogicBaseCell class is the abstract base for all logic cells
@@ -28,28 +24,38 @@ public:
     /// \brief Default destructor for LogicBaseCell
     ~LogicBaseCell() override = default;
 
-    /// \brief The logic function that determines the output states based on the inputs
-    virtual void LogicFunction(void) {};
+    /// \brief Getter for the kernel the simulation engine evaluates for this cell
+    /// \return The cell kernel
+    virtual CellKernel GetKernel(void) const = 0;
+
+    /// \brief Getter for the kernel parameters of this cell
+    /// \return The kernel parameters
+    virtual CellParameters GetParameters(void) const;
 
-    /// \brief Notifies the logic cell connected to output pOutput to update its input state to pState
-    /// \param pOutput: The number of the output that has changed to pState
-    /// \param pState: The new state of the output
-    void NotifySuccessor(uint32_t pOutput, LogicState pState) const;
+    /// \brief Getter for the propagation delay of this cell
+    /// \return The ticks from an input change until the outputs are updated
+    uint32_t GetDelay(void) const;
 
-    /// \brief Sets input number pInput to the new state pState
-    /// \param pInput: The number of the changed input
-    /// \param pState: The new state of the input
-    virtual void InputReady(uint32_t pInput, LogicState pState);
+    /// \brief Sets the propagation delay of this cell
+    /// \param pDelay: The ticks from an input change until the outputs are updated, clamped to [1, MAX_CELL_DELAY]
+    void SetDelay(int64_t pDelay);
 
-    /// \brief Sets logic cell pLogicCell's input number pInput to this cell's output number pOutput
-    /// \param pLogicCell: The logic cell to connect to this cell's output
-    /// \param pInput: The number of the input of the connected cell
-    /// \param pOutput: The output number of this cell to connect
-    void ConnectOutput(const std::shared_ptr<LogicBaseCell>& pLogicCell, uint32_t pInput, uint32_t pOutput);
+    /// \brief Attaches this cell to its compiled counterpart in the simulation state snapshot
+    /// \param pSnapshot: Pointer to the snapshot the GUI samples or nullptr to detach
+    /// \param pIndex: The index of this cell in the simulation engine
+    void AttachToSimulation(const SimulationSnapshot* pSnapshot, uint32_t pIndex);
+
+    /// \brief Getter for the index of this cell in the simulation engine
+    /// \return The engine index of this cell
+    uint32_t GetEngineIndex(void) const;
 
     /// \brief Marks the input with the given index as connected
     /// \param pInput: The index of the input
-    void SetConnected(uint32_t pInput);
+    void SetInputConnected(uint32_t pInput);
+
+    /// \brief Marks the output with the given index as connected
+    /// \param pOutput: The index of the output
+    void SetOutputConnected(uint32_t pOutput);
 
     /// \brief Returns true, if the given input is connected to another logic cell
     /// \param pInput: The index of the input
@@ -103,63 +109,43 @@ public:
     /// \brief Getter for the current output state number pOutput of this cell
     /// \param pOutput: The number of the output to retreive
     /// \return The logic state of this cell's output number pOutput
-    virtual LogicState GetOutputState(uint32_t pOutput = 0) const = 0;
+    virtual LogicState GetOutputState(uint32_t pOutput = 0) const;
 
     /// \brief Returns true, if this logic cell is not shut down
     /// \return True, if logic cell active
     bool IsActive(void) const;
 
 protected:
-    /// \brief If the mNextUpdateTime value is NOW, AdvanceUpdateTime calls LogicFunction()
-    /// If it's NEXT_TICK, the update time is advanced to NOW
-    void AdvanceUpdateTime(void);
-
-    /// \brief Inverts the given state if pOutput is an inverted output
-    /// \param pState: A logic state
-    /// \param pOutput: A number of a cell output
-    /// \return The output logic state
-    LogicState ApplyInversion(LogicState pState, uint32_t pOutput) const;
-
-    /// \brief Sets the state pSubject to the state pTargetState if it isn't in that state already
-    /// Returns true if pSubject wasn't already in pTargetState
-    /// \param pSubject: Reference to the state to set
-    /// \param pTargetState: The target state
-    /// \return True, if the state has been changed
-    bool AssureState(LogicState &pSubject, const LogicState &pTargetState);
-
-    /// \brief Sets the state pSubject to the state pTargetState if it isn't in that state already
-    /// and if the given condition is true
-    /// Returns true if pSubject wasn't already in pTargetState
-    /// \param pCondition: The condition to be true for the state to be assured
-    /// \param pSubject: Reference to the state to set
-    /// \param pTargetState: The target state
-    /// \return True, if the state has been changed
-    bool AssureStateIf(bool pCondition, LogicState &pSubject, const LogicState &pTargetState);
+    /// \brief Getter for the output state number pOutput of the compiled cell, without output inversion
+    /// \param pOutput: The number of the output to retreive
+    /// \return The logic state of the output or LOW, if the cell is not simulated
+    LogicState GetEngineOutputState(uint32_t pOutput) const;
 
 public slots:
-    /// \brief Advances the simulation of this cell by one logic tick
-    virtual void OnSimulationAdvance(void) {};
+    /// \brief Detaches the cell from the simulation for edit mode and triggers a component repaint
+    virtual void OnShutdown(void);
 
-    /// \brief Sets the in- and outputs low for edit mode and triggers a component repaint
-    virtual void OnShutdown(void) {};
-
-    /// \brief Initializes the logic cell's states and triggers a component repaint
-    virtual void OnWakeUp(void) {};
+    /// \brief Activates the cell for simulation and triggers a component repaint
+    virtual void OnWakeUp(void);
 
 signals:
     /// \brief Emitted when the output state of this cell changed
     void StateChangedSignal(void);
 
+    /// \brief Emitted when the user toggles or presses this input cell during simulation
+    /// \param pEngineIndex: The index of this cell in the simulation engine
+    void InputActivatedSignal(uint32_t pEngineIndex);
+
 protected:
-    std::vector<LogicState> mInputStates;
-    std::vector<bool> mInputConnected;
-    std::vector<bool> mInputInverted;
-    std::vector<bool> mOutputInverted;
+    PinMask mInputConnected;
+    PinMask mOutputConnected;
+    PinMask mInputInverted;
+    PinMask mOutputInverted;
 
-    // Pairs of connected LogicCell and input number of that cell
-    std::vector<std::pair<std::shared_ptr<LogicBaseCell>, uint32_t>> mOutputCells;
+    uint32_t mDelay;
 
-    UpdateTime mNextUpdateTime;
+    const SimulationSnapshot* mSnapshot;
+    uint32_t mEngineIndex;
 
     bool mIsActive;
 };
@@ -2,86 +2,19 @@
 #include "CoreLogic.h"
 
 LogicWireCell::LogicWireCell(const CoreLogic* pCoreLogic):
-    LogicBaseCell(0, 0),
-    mState(LogicState::LOW)
+    LogicBaseCell(0, 0)
 {
     QObject::connect(pCoreLogic, &CoreLogic::SimulationStartSignal, this, &LogicWireCell::OnWakeUp);
     QObject::connect(pCoreLogic, &CoreLogic::SimulationStopSignal, this, &LogicWireCell::OnShutdown);
 }
 
-void LogicWireCell::LogicFunction()
+CellKernel LogicWireCell::GetKernel() const
 {
-    for (const auto& input : mInputStates)
-    {
-        if (input == LogicState::HIGH)
-        {
-            if (mState != LogicState::HIGH)
-            {
-                mState = LogicState::HIGH;
-                emit StateChangedSignal();
-            }
-            return;
-        }
-    }
-    if (mState != LogicState::LOW)
-    {
-        mState = LogicState::LOW;
-        emit StateChangedSignal();
-    }
-}
-
-void LogicWireCell::AppendOutput(const std::shared_ptr<LogicBaseCell>& pLogicCell, uint32_t pInput)
-{
-    mOutputCells.push_back(std::make_pair(pLogicCell, pInput));
-    mOutputInverted.push_back(false);
-    pLogicCell->SetConnected(pInput);
-}
-
-void LogicWireCell::AddInputSlot()
-{
-    mInputStates.push_back(LogicState::LOW);
-    mInputInverted.push_back(false);
-}
-
-uint32_t LogicWireCell::GetInputSize(void) const
-{
-    return mInputStates.size();
-}
-
-void LogicWireCell::InputReady(uint32_t pInput, LogicState pState)
-{
-    if (mInputStates[pInput] != pState)
-    {
-        mInputStates[pInput] = pState;
-        LogicFunction();
-
-        for (size_t i = 0; i < mOutputCells.size(); i++)
-        {
-            NotifySuccessor(i, mState);
-        }
-    }
+    return CellKernel::WIRE;
 }
 
 LogicState LogicWireCell::GetOutputState(uint32_t pOutput) const
 {
     Q_UNUSED(pOutput);
-    return mState;
-}
-
-void LogicWireCell::OnWakeUp()
-{
-    mState = LogicState::LOW;
-    mIsActive = true;
-    emit StateChangedSignal();
-}
-
-void LogicWireCell::OnShutdown()
-{
-    mState = LogicState::LOW;
-    mOutputCells.clear();
-    mInputStates.clear();
-    mOutputInverted.clear();
-    mInputInverted.clear();
-    mIsActive = false;
-    emit StateChangedSignal();
+    return GetEngineOutputState(0);
 }
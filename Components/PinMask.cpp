@@ -0,0 +1,84 @@
+#include "PinMask.h"
+
+#include <QtGlobal>
+#include <algorithm>
+
+namespace
+{
+constexpr uint32_t WORD_BITS = 64;
+} // namespace
+
+PinMask::PinMask(uint32_t pSize):
+    mSize(pSize),
+    mInlineWord(0),
+    mOverflowWords(pSize > WORD_BITS ? (pSize - 1) / WORD_BITS : 0, 0)
+{}
+
+uint32_t PinMask::Size() const
+{
+    return mSize;
+}
+
+bool PinMask::Test(uint32_t pPin) const
+{
+    Q_ASSERT(pPin < mSize);
+    return ((Word(pPin) >> (pPin % WORD_BITS)) & 1) != 0;
+}
+
+void PinMask::Set(uint32_t pPin, bool pValue)
+{
+    Q_ASSERT(pPin < mSize);
+
+    if (pValue)
+    {
+        Word(pPin) |= (uint64_t{1} << (pPin % WORD_BITS));
+    }
+    else
+    {
+        Word(pPin) &= ~(uint64_t{1} << (pPin % WORD_BITS));
+    }
+}
+
+void PinMask::Flip(uint32_t pPin)
+{
+    Q_ASSERT(pPin < mSize);
+    Word(pPin) ^= (uint64_t{1} << (pPin % WORD_BITS));
+}
+
+void PinMask::Reset()
+{
+    mInlineWord = 0;
+    std::fill(mOverflowWords.begin(), mOverflowWords.end(), 0);
+}
+
+std::vector<bool> PinMask::ToVector() const
+{
+    std::vector<bool> flags(mSize, false);
+
+    for (uint32_t pin = 0; pin < mSize; pin++)
+    {
+        flags[pin] = Test(pin);
+    }
+
+    return flags;
+}
+
+void PinMask::Assign(const std::vector<bool>& pFlags)
+{
+    *this = PinMask(pFlags.size());
+
+    for (uint32_t pin = 0; pin < mSize; pin++)
+    {
+        Set(pin, pFlags[pin]);
+    }
+}
+
+uint64_t& PinMask::Word(uint32_t pPin)
+{
+    return (pPin < WORD_BITS) ? mInlineWord : mOverflowWords[pPin / WORD_BITS - 1];
+}
+
+uint64_t PinMask::Word(uint32_t pPin) const
+{
+    return (pPin < WORD_BITS) ? mInlineWord : mOverflowWords[pPin / WORD_BITS - 1];
+}
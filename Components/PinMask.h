@@ -0,0 +1,64 @@
+#ifndef PINMASK_H
+#define PINMASK_H
+
+#include <cstdint>
+#include <vector>
+
+///
+/// \brief The PinMask class holds one flag per pin of a logic cell, packed into 64 bit words
+/// Up to 64 pins are stored inline, so most cells need no allocation for their pin flags
+///
+class PinMask
+{
+public:
+    /// \brief Constructor for PinMask, all flags are cleared
+    /// \param pSize: The number of pins
+    PinMask(uint32_t pSize);
+
+    /// \brief Getter for the number of pins
+    /// \return The number of pins
+    uint32_t Size(void) const;
+
+    /// \brief Returns the flag of the given pin
+    /// \param pPin: The pin index
+    /// \return True, if the flag is set
+    bool Test(uint32_t pPin) const;
+
+    /// \brief Sets the flag of the given pin
+    /// \param pPin: The pin index
+    /// \param pValue: The new value of the flag
+    void Set(uint32_t pPin, bool pValue = true);
+
+    /// \brief Inverts the flag of the given pin
+    /// \param pPin: The pin index
+    void Flip(uint32_t pPin);
+
+    /// \brief Clears all flags without releasing memory
+    void Reset(void);
+
+    /// \brief Getter for all flags as a vector
+    /// \return Vector with one entry per pin
+    std::vector<bool> ToVector(void) const;
+
+    /// \brief Replaces the flags with the given ones, the number of pins is taken from the vector
+    /// \param pFlags: Vector with one entry per pin
+    void Assign(const std::vector<bool>& pFlags);
+
+protected:
+    /// \brief Getter for the word holding the given pin
+    /// \param pPin: The pin index
+    /// \return Reference to the word
+    uint64_t& Word(uint32_t pPin);
+
+    /// \brief Getter for the word holding the given pin
+    /// \param pPin: The pin index
+    /// \return The word
+    uint64_t Word(uint32_t pPin) const;
+
+protected:
+    uint32_t mSize;
+    uint64_t mInlineWord;
+    std::vector<uint64_t> mOverflowWords; // Words for pins 64 and above, empty for most cells
+};
+
+#endif // PINMASK_H
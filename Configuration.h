@@ -46,6 +46,10 @@ namespace gui
 static constexpr auto DEFAULT_WINDOW_TITLE = "Linkuit Studio - Untitled";
 static constexpr auto OPEN_FILE_DIALOG_TITLE = "Open Circuit File";
 static constexpr auto SAVE_FILE_DIALOG_TITLE = "Save Circuit File";
+static constexpr auto EXPORT_WAVEFORM_DIALOG_TITLE = "Export Waveform";
+static constexpr auto SAVE_STATISTICS_DIALOG_TITLE = "Save Simulation Statistics";
+
+static constexpr std::chrono::milliseconds STATISTICS_UPDATE_INTERVAL(500);
 
 static constexpr bool SHOW_WELCOME_DIALOG_ON_STARTUP = true;
 static constexpr std::chrono::milliseconds SHOW_WELCOME_DIALOG_DELAY{300};
@@ -80,6 +84,17 @@ static constexpr QRectF DIMENSIONS(-32000, -32000, 64000, 64000);
 namespace simulation
 {
 static constexpr std::chrono::milliseconds PROPAGATION_DELAY(1);
+static constexpr std::chrono::milliseconds FRAME_INTERVAL(16); // Interval in which the GUI samples the simulation state if the refresh rate is unknown
+static constexpr std::chrono::milliseconds MIN_FRAME_INTERVAL(4); // Bound for screens with very high refresh rates
+static constexpr uint32_t TICKS_PER_TIMEOUT = 1; // Ticks per propagation delay in normal run mode
+
+static constexpr std::chrono::milliseconds MAX_SPEED_BATCH_DURATION(10); // Time spent ticking per event loop iteration at max speed
+
+static constexpr std::chrono::milliseconds TICKS_PER_SECOND_UPDATE_INTERVAL(1000);
+
+static constexpr uint32_t WAVEFORM_CAPACITY = 1 << 23; // Value changes kept by the waveform recorder, 8 bytes each
+static constexpr uint64_t WAVEFORM_STRIP_TICKS = 256; // Ticks shown in the waveform strip
+static constexpr std::chrono::milliseconds WAVEFORM_UPDATE_INTERVAL(100);
 } // namespace
 
 namespace components
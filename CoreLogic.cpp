@@ -36,12 +36,39 @@
 #include "HelperFunctions.h"
 
 #include <QCoreApplication>
+#include <QGuiApplication>
+#include <QScreen>
+#include <QWindow>
+#include <QFile>
+#include <cmath>
+#include <sstream>
+
+namespace
+{
+/// \brief Converts the given scene position into a point of the circuit geometry
+/// \param pPos: The scene position
+/// \return The geometry point
+GridPoint ToGridPoint(QPointF pPos)
+{
+    return GridPoint{static_cast<int32_t>(std::lround(pPos.x())), static_cast<int32_t>(std::lround(pPos.y()))};
+}
+
+/// \brief Builds the name of a recorded signal from a prefix and the grid position of its item
+/// \param pPrefix: The name prefix
+/// \param pPos: The scene position
+/// \return The signal name, free of whitespace
+std::string GetSignalName(const char* pPrefix, QPointF pPos)
+{
+    const auto point = ToGridPoint(pPos);
+    return std::string(pPrefix) + '_' + std::to_string(point.x / canvas::GRID_SIZE) + '_' + std::to_string(point.y / canvas::GRID_SIZE);
+}
+} // namespace
 
 CoreLogic::CoreLogic(View &pView):
     mView(pView),
     mHorizontalPreviewWire(this, WireDirection::HORIZONTAL, 0),
     mVerticalPreviewWire(this, WireDirection::VERTICAL, 0),
-    mPropagationTimer(this),
+    mFrameTimer(this),
     mProcessingTimer(this),
     mCircuitFileParser(mRuntimeConfigParser)
 {
@@ -49,15 +76,34 @@ CoreLogic::CoreLogic(View &pView):
 
     mProcessingTimer.setSingleShot(true);
 
-    QObject::connect(&mPropagationTimer, &QTimer::timeout, this, &CoreLogic::OnPropagationTimeout);
+    QObject::connect(&mFrameTimer, &QTimer::timeout, this, &CoreLogic::OnFrameTimeout);
     QObject::connect(&mProcessingTimer, &QTimer::timeout, this, &CoreLogic::OnProcessingTimeout);
 
     QObject::connect(&mCircuitFileParser, &CircuitFileParser::LoadCircuitFileSuccessSignal, this, &CoreLogic::ReadJson);
 
+    QObject::connect(&mExtractionWorker, &ExtractionWorker::ProgressChangedSignal, this, &CoreLogic::OnExtractionProgressChanged);
+    QObject::connect(&mExtractionWorker, &ExtractionWorker::ExtractionFinishedSignal, this, &CoreLogic::OnExtractionFinished);
+
     if (!mRuntimeConfigParser.LoadRuntimeConfig(GetRuntimeConfigAbsolutePath()))
     {
         qDebug() << "Could not open runtime config file, using defaults";
     }
+
+    mSimulationWorker.moveToThread(&mSimulationThread);
+    mSimulationThread.start();
+
+    mExtractionWorker.moveToThread(&mExtractionThread);
+    mExtractionThread.start();
+}
+
+CoreLogic::~CoreLogic()
+{
+    mExtractionWorker.Cancel(mExtractionJob);
+    mExtractionThread.quit();
+    mExtractionThread.wait();
+
+    mSimulationThread.quit();
+    mSimulationThread.wait();
 }
 
 RuntimeConfigParser& CoreLogic::GetRuntimeConfigParser()
@@ -129,8 +175,7 @@ void CoreLogic::EnterControlMode(ControlMode pNewMode)
 
     if (pNewMode == ControlMode::SIMULATION)
     {
-        EnterSimulation();
-        RunSimulation();
+        EnterSimulation(true);
     }
 
     mView.UpdatePieMenuIcons();
@@ -147,23 +192,244 @@ void CoreLogic::SetSimulationMode(SimulationMode pNewMode)
     }
 }
 
-void CoreLogic::EnterSimulation()
+void CoreLogic::EnterSimulation(bool pRunWhenReady)
 {
+    if (mIsNetlistValid)
+    {
+        // Nothing has been edited since the last extraction, so only the simulation state has to be set up
+        SetUpSimulation(pRunWhenReady);
+        return;
+    }
+
     StartProcessing();
-    ParseWireGroups();
-    CreateWireLogicCells();
-    ConnectLogicCells();
+    mView.ShowProcessingProgress(true);
+
+    CreateCircuitGeometry();
+
+    mExtractionJob++;
+    if (mExtractionJob == ExtractionWorker::NO_JOB)
+    {
+        mExtractionJob++;
+    }
+
+    mIsExtracting = true;
+    mRunAfterExtraction = pRunWhenReady;
+
+    // Edits are impossible until the simulation is left, which waits for the worker, so it can read mConnectivity directly
+    QMetaObject::invokeMethod(&mExtractionWorker, [this, job = mExtractionJob, geometry = std::move(mCircuitGeometry)]()
+    {
+        mExtractionWorker.Extract(job, geometry, mConnectivity);
+    });
+}
+
+void CoreLogic::OnExtractionProgressChanged(uint32_t pJob, uint8_t pPercent)
+{
+    if (mIsExtracting && pJob == mExtractionJob)
+    {
+        mView.SetProcessingProgress(pPercent);
+    }
+}
+
+void CoreLogic::OnExtractionFinished(uint32_t pJob, bool pIsCancelled)
+{
+    if (!mIsExtracting || pJob != mExtractionJob)
+    {
+        return; // Result of a superseded extraction
+    }
+
+    mIsExtracting = false;
+
+    if (pIsCancelled)
+    {
+        EndProcessing();
+        emit SimulationEntryCancelledSignal();
+        return;
+    }
+
+    mIsNetlistValid = true;
     EndProcessing();
+    SetUpSimulation(mRunAfterExtraction);
+}
+
+void CoreLogic::SetUpSimulation(bool pRunWhenReady)
+{
+    const auto& extractor = mExtractionWorker.GetExtractor();
+    CreateWireLogicCells(extractor);
+    CompileLogicCells(extractor);
+    SetUpWaveformRecording(extractor);
     SetSimulationMode(SimulationMode::STOPPED);
     emit SimulationStartSignal();
+    mFrameTimer.start(GetFrameInterval());
     StepSimulation();
+
+    if (pRunWhenReady)
+    {
+        RunSimulation();
+    }
+}
+
+void CoreLogic::InvalidateNetlist()
+{
+    mIsNetlistValid = false;
+}
+
+void CoreLogic::UpdateConnectivity(UndoBaseType* pUndoObject)
+{
+    Q_ASSERT(pUndoObject);
+
+    switch (pUndoObject->Type())
+    {
+        case undo::Type::ADD:
+        {
+            UpdateConnectivity(static_cast<UndoAddType*>(pUndoObject)->AddedComponents());
+            UpdateConnectivity(static_cast<UndoAddType*>(pUndoObject)->DeletedComponents());
+            break;
+        }
+        case undo::Type::DEL:
+        {
+            UpdateConnectivity(static_cast<UndoDeleteType*>(pUndoObject)->Components());
+            break;
+        }
+        case undo::Type::MOVE:
+        {
+            UpdateConnectivity(static_cast<UndoMoveType*>(pUndoObject)->MovedComponents());
+            UpdateConnectivity(static_cast<UndoMoveType*>(pUndoObject)->AddedComponents());
+            UpdateConnectivity(static_cast<UndoMoveType*>(pUndoObject)->DeletedComponents());
+            break;
+        }
+        case undo::Type::COPY:
+        {
+            UpdateConnectivity(static_cast<UndoCopyType*>(pUndoObject)->MovedComponents());
+            UpdateConnectivity(static_cast<UndoCopyType*>(pUndoObject)->AddedComponents());
+            UpdateConnectivity(static_cast<UndoCopyType*>(pUndoObject)->DeletedComponents());
+            break;
+        }
+        case undo::Type::CONFIGURE:
+        {
+            const auto data = static_cast<UndoConfigureType*>(pUndoObject)->Data();
+            if (data->Type() == undo::ConfigType::CONNECTION_TYPE)
+            {
+                UpdateConnectivity(std::static_pointer_cast<undo::ConnectionTypeChangedData>(data)->conPoint);
+            }
+            break;
+        }
+        default:
+        {
+            break;
+        }
+    }
+
+    InvalidateNetlist();
+}
+
+void CoreLogic::UpdateConnectivity(const std::vector<IBaseComponent*>& pComponents)
+{
+    for (const auto& comp : pComponents)
+    {
+        UpdateConnectivity(comp);
+    }
+}
+
+void CoreLogic::UpdateConnectivity(IBaseComponent* pComponent)
+{
+    Q_ASSERT(pComponent);
+
+    if (nullptr != dynamic_cast<LogicWire*>(pComponent))
+    {
+        const auto wire = static_cast<LogicWire*>(pComponent);
+        const auto registered = mConnectivityWires.find(wire);
+        const bool isInScene = (wire->scene() == mView.Scene());
+        const WireGeometry geometry{ToGridPoint(wire->pos()), wire->GetDirection(), static_cast<int32_t>(wire->GetLength())};
+
+        if (registered != mConnectivityWires.end())
+        {
+            const auto index = registered->second;
+            const auto& current = mConnectivity.GetWires()[index];
+
+            if (isInScene && current.pos == geometry.pos && current.direction == geometry.direction && current.length == geometry.length)
+            {
+                return;
+            }
+
+            // The last wire takes over the index of the removed one, in the model as well as in mGeometryWires
+            mConnectivity.RemoveWire(index);
+            mGeometryWires[index] = mGeometryWires.back();
+            mConnectivityWires[mGeometryWires[index]] = index;
+            mGeometryWires.pop_back();
+            mConnectivityWires.erase(wire);
+        }
+
+        if (isInScene)
+        {
+            mConnectivityWires[wire] = mConnectivity.AddWire(geometry);
+            mGeometryWires.push_back(wire);
+        }
+    }
+    else if (nullptr != dynamic_cast<ConPoint*>(pComponent))
+    {
+        const auto conPoint = static_cast<ConPoint*>(pComponent);
+        const auto registered = mConnectivityConPoints.find(conPoint);
+        const bool isFull = (conPoint->scene() == mView.Scene() && conPoint->GetConnectionType() == ConnectionType::FULL);
+        const auto pos = ToGridPoint(conPoint->pos());
+
+        if (registered != mConnectivityConPoints.end())
+        {
+            if (isFull && registered->second == pos)
+            {
+                return;
+            }
+
+            mConnectivity.RemoveFullConPoint(registered->second);
+            mConnectivityConPoints.erase(registered);
+        }
+
+        if (isFull)
+        {
+            mConnectivity.AddFullConPoint(pos);
+            mConnectivityConPoints[conPoint] = pos;
+        }
+    }
+}
+
+void CoreLogic::ResetConnectivity()
+{
+    mConnectivity.Clear();
+    mConnectivityWires.clear();
+    mConnectivityConPoints.clear();
+    mGeometryWires.clear();
+
+    for (const auto& item : mView.Scene()->items())
+    {
+        if (nullptr != dynamic_cast<IBaseComponent*>(item))
+        {
+            UpdateConnectivity(static_cast<IBaseComponent*>(item));
+        }
+    }
+
+    InvalidateNetlist();
 }
 
 void CoreLogic::RunSimulation()
 {
-    if (mControlMode == ControlMode::SIMULATION && mSimulationMode == SimulationMode::STOPPED)
+    StartSimulationWorker(simulation::PROPAGATION_DELAY, simulation::TICKS_PER_TIMEOUT);
+}
+
+void CoreLogic::RunSimulationAtMaxSpeed()
+{
+    StartSimulationWorker(std::chrono::milliseconds(0), 0); // Zero interval times out on every event loop iteration
+}
+
+void CoreLogic::StartSimulationWorker(std::chrono::milliseconds pInterval, uint32_t pTicksPerTimeout)
+{
+    if (mControlMode == ControlMode::SIMULATION && mSimulationMode == SimulationMode::STOPPED && !mIsExtracting)
     {
-        mPropagationTimer.start(simulation::PROPAGATION_DELAY);
+        QMetaObject::invokeMethod(&mSimulationWorker, [this, pInterval, pTicksPerTimeout]()
+        {
+            mSimulationWorker.Start(pInterval, pTicksPerTimeout, simulation::MAX_SPEED_BATCH_DURATION);
+        });
+
+        mTicksPerSecondStartTick = mSimulationSnapshot.tickCount;
+        mTicksPerSecondTimer.start();
         SetSimulationMode(SimulationMode::RUNNING);
     }
 }
@@ -172,7 +438,107 @@ void CoreLogic::StepSimulation()
 {
     if (mControlMode == ControlMode::SIMULATION)
     {
-        OnPropagationTimeout();
+        QMetaObject::invokeMethod(&mSimulationWorker, [this]()
+        {
+            mSimulationWorker.Step();
+        });
+    }
+}
+
+void CoreLogic::StepBackSimulation()
+{
+    if (mControlMode == ControlMode::SIMULATION && !IsProcessing())
+    {
+        PauseSimulation();
+
+        QMetaObject::invokeMethod(&mSimulationWorker, [this]()
+        {
+            mSimulationWorker.StepBack(1);
+        });
+    }
+}
+
+bool CoreLogic::ExportWaveform(const QString& pPath)
+{
+    if (mControlMode != ControlMode::SIMULATION || IsProcessing())
+    {
+        return false;
+    }
+
+    std::ostringstream vcd;
+    QMetaObject::invokeMethod(&mSimulationWorker, [this, &vcd]()
+    {
+        mSimulationWorker.WriteWaveform(vcd);
+    }, Qt::BlockingQueuedConnection);
+
+    QFile file(pPath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        return false;
+    }
+
+    const auto data = vcd.str();
+    return (file.write(data.data(), data.size()) == static_cast<qint64>(data.size()));
+}
+
+void CoreLogic::SetZeroDelaySettleEnabled(bool pEnabled)
+{
+    QMetaObject::invokeMethod(&mSimulationWorker, [this, pEnabled]()
+    {
+        mSimulationWorker.SetZeroDelaySettle(pEnabled);
+    });
+}
+
+void CoreLogic::SetOscillationLimit(OscillationLimit pLimit)
+{
+    QMetaObject::invokeMethod(&mSimulationWorker, [this, pLimit]()
+    {
+        mSimulationWorker.SetOscillationLimit(pLimit);
+    });
+}
+
+void CoreLogic::SetProfilingEnabled(bool pEnabled)
+{
+    mIsProfiling = pEnabled;
+
+    QMetaObject::invokeMethod(&mSimulationWorker, [this, pEnabled]()
+    {
+        mSimulationWorker.SetProfiling(pEnabled);
+    });
+}
+
+bool CoreLogic::IsProfilingEnabled() const
+{
+    return mIsProfiling;
+}
+
+SimulationProfiler CoreLogic::GetProfile()
+{
+    SimulationProfiler profile;
+    QMetaObject::invokeMethod(&mSimulationWorker, [this, &profile]()
+    {
+        profile = mSimulationWorker.GetProfile();
+    }, Qt::BlockingQueuedConnection);
+
+    profile.Merge(mFrameProfiler);
+    return profile;
+}
+
+void CoreLogic::ClearProfile()
+{
+    mFrameProfiler.Clear();
+
+    QMetaObject::invokeMethod(&mSimulationWorker, [this]()
+    {
+        mSimulationWorker.ClearProfile();
+    });
+}
+
+void CoreLogic::AddPaintSample(uint64_t pNanoseconds)
+{
+    if (mIsProfiling)
+    {
+        mFrameProfiler.AddSample(SimulationProfiler::Metric::PAINT_NANOSECONDS, pNanoseconds);
     }
 }
 
@@ -180,8 +546,14 @@ void CoreLogic::ResetSimulation()
 {
     if (mControlMode == ControlMode::SIMULATION && ! IsProcessing())
     {
-        LeaveSimulation();
-        EnterSimulation();
+        // The circuit can't be edited while simulating, so the compiled netlist is restored to its initial state in place
+        QMetaObject::invokeMethod(&mSimulationWorker, [this]()
+        {
+            mSimulationWorker.Reset();
+        });
+
+        SetSimulationMode(SimulationMode::STOPPED);
+        StepSimulation();
     }
 }
 
@@ -189,16 +561,41 @@ void CoreLogic::PauseSimulation()
 {
     if (mControlMode == ControlMode::SIMULATION && mSimulationMode == SimulationMode::RUNNING)
     {
-        mPropagationTimer.stop();
+        QMetaObject::invokeMethod(&mSimulationWorker, [this]()
+        {
+            mSimulationWorker.Pause();
+        });
         SetSimulationMode(SimulationMode::STOPPED);
     }
 }
 
 void CoreLogic::LeaveSimulation()
 {
-    mPropagationTimer.stop();
+    if (mIsExtracting)
+    {
+        mExtractionWorker.Cancel(mExtractionJob);
+
+        // The worker reads mConnectivity, so wait until it has stopped before the circuit can be edited again
+        QMetaObject::invokeMethod(&mExtractionWorker, []() {}, Qt::BlockingQueuedConnection);
+
+        mIsExtracting = false;
+        EndProcessing();
+    }
+
+    QMetaObject::invokeMethod(&mSimulationWorker, [this]()
+    {
+        mSimulationWorker.Clear();
+    }, Qt::BlockingQueuedConnection);
+
+    mFrameTimer.stop();
     SetSimulationMode(SimulationMode::STOPPED);
     emit SimulationStopSignal();
+
+    mCompiledCells.clear();
+    mCellRepaintItems.clear();
+    mSimulationSnapshot.Clear();
+    mWaveformStripSignals.clear();
+    mWaveformStripNames.clear();
 }
 
 void CoreLogic::OnMasterSlaveToggled(bool pChecked)
@@ -232,6 +629,7 @@ void CoreLogic::OnToggleValueChanged(uint32_t pValue)
         if (nullptr != clockCell && pValue != clockCell->GetToggleTicks())
         {
             clockCell->SetToggleTicks(pValue);
+            InvalidateNetlist();
             mCircuitFileParser.MarkAsModified();
         }
     }
@@ -246,6 +644,7 @@ void CoreLogic::OnPulseValueChanged(uint32_t pValue)
         if (nullptr != clockCell && pValue != clockCell->GetPulseTicks())
         {
             clockCell->SetPulseTicks(pValue);
+            InvalidateNetlist();
             mCircuitFileParser.MarkAsModified();
         }
     }
@@ -260,6 +659,7 @@ void CoreLogic::OnClockModeChanged(ClockMode pMode)
         if (nullptr != clockCell && pMode != clockCell->GetClockMode())
         {
             clockCell->SetClockMode(pMode);
+            InvalidateNetlist();
             mCircuitFileParser.MarkAsModified();
         }
     }
@@ -281,9 +681,85 @@ bool CoreLogic::IsSimulationRunning() const
     return (mControlMode == ControlMode::SIMULATION);
 }
 
-void CoreLogic::OnPropagationTimeout()
+uint32_t CoreLogic::GetOscillatingLoopCount() const
+{
+    return mSimulationSnapshot.oscillatingLoopCount;
+}
+
+void CoreLogic::OnFrameTimeout()
+{
+    ForwardStateChanges();
+
+    if (mSimulationMode == SimulationMode::RUNNING)
+    {
+        UpdateTicksPerSecond();
+    }
+
+    if (mView.IsWaveformStripVisible() && !mIsWaveformStripUpdatePending
+            && mWaveformStripTimer.elapsed() >= simulation::WAVEFORM_UPDATE_INTERVAL.count())
+    {
+        RequestWaveformStripUpdate();
+    }
+}
+
+void CoreLogic::UpdateTicksPerSecond()
 {
-    emit SimulationAdvanceSignal();
+    const auto elapsed = mTicksPerSecondTimer.elapsed();
+
+    if (elapsed >= simulation::TICKS_PER_SECOND_UPDATE_INTERVAL.count())
+    {
+        const auto ticks = mSimulationSnapshot.tickCount - mTicksPerSecondStartTick;
+        emit TicksPerSecondChangedSignal(ticks * 1000.0 / elapsed);
+
+        mTicksPerSecondStartTick = mSimulationSnapshot.tickCount;
+        mTicksPerSecondTimer.restart();
+    }
+}
+
+std::chrono::milliseconds CoreLogic::GetFrameInterval() const
+{
+    const auto screen = (mView.window()->windowHandle() != nullptr ? mView.window()->windowHandle()->screen() : QGuiApplication::primaryScreen());
+
+    if (screen == nullptr || screen->refreshRate() <= 0)
+    {
+        return simulation::FRAME_INTERVAL;
+    }
+
+    // Sampling faster than the screen refreshes would only repaint items that are never displayed
+    const auto frameInterval = std::chrono::milliseconds(static_cast<int64_t>(std::ceil(1000 / screen->refreshRate())));
+    return std::max(frameInterval, simulation::MIN_FRAME_INTERVAL);
+}
+
+void CoreLogic::OnInputActivated(uint32_t pEngineIndex)
+{
+    QMetaObject::invokeMethod(&mSimulationWorker, [this, pEngineIndex]()
+    {
+        mSimulationWorker.ActivateInput(pEngineIndex);
+    });
+}
+
+void CoreLogic::ForwardStateChanges()
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    mChangedCells.clear();
+    mSimulationWorker.TakeSnapshot(mSimulationSnapshot, mChangedCells);
+
+    uint64_t repaintRequests = 0;
+    for (const auto& index : mChangedCells)
+    {
+        emit mCompiledCells[index]->StateChangedSignal();
+        repaintRequests += mCellRepaintItems[index];
+    }
+
+    if (mIsProfiling)
+    {
+        const auto duration = std::chrono::steady_clock::now() - start;
+        mFrameProfiler.AddSample(SimulationProfiler::Metric::STATE_CHANGED_SIGNALS, mChangedCells.size());
+        mFrameProfiler.AddSample(SimulationProfiler::Metric::REPAINT_REQUESTS, repaintRequests);
+        mFrameProfiler.AddSample(SimulationProfiler::Metric::DISPATCH_NANOSECONDS,
+                                 std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+    }
 }
 
 bool CoreLogic::IsUndoQueueEmpty() const
@@ -1048,217 +1524,238 @@ LogicWire* CoreLogic::MergeWires(LogicWire* pNewWire, std::optional<LogicWire*>
     }
 }
 
-void CoreLogic::ParseWireGroups(void)
+void CoreLogic::CreateCircuitGeometry()
 {
-    mWireGroups.clear();
-    mWireMap.clear();
+    mCircuitGeometry = CircuitGeometry();
+    mCircuitGeometry.wires = mConnectivity.GetWires();
+    mGeometryComponents.clear();
+    mGeometryConPoints.clear();
 
-    for (auto& comp : mView.Scene()->items())
-    {
-        // If the component is a wire that is not yet part of a group
-        if (dynamic_cast<LogicWire*>(comp) && mWireMap.find(static_cast<LogicWire*>(comp)) == mWireMap.end())
-        {
-            mWireGroups.push_back(std::vector<IBaseComponent*>());
-            ExploreGroup(static_cast<LogicWire*>(comp), mWireGroups.size() - 1);
-        }
-        ProcessingHeartbeat();
-    }
+    uint32_t registeredWires = 0;
 
-    // Push ConPoints into groups of the wires below; done here because ExploreGroup doesn't catch all ConPoints
-    for (auto& comp : mView.Scene()->items())
+    for (auto& item : mView.Scene()->items())
     {
-        if (nullptr != dynamic_cast<ConPoint*>(comp) && static_cast<ConPoint*>(comp)->GetConnectionType() == ConnectionType::FULL)
+        if (nullptr != dynamic_cast<LogicWire*>(item))
         {
-            auto collidingItems = mView.Scene()->collidingItems(comp, Qt::IntersectsItemShape);
-            if (collidingItems.size() > 0) // Sanity check that ConPoint is above wires
+            // Wires are taken from mConnectivity, only preview wires are not registered there
+            if (mConnectivityWires.find(static_cast<LogicWire*>(item)) != mConnectivityWires.end())
             {
-                auto wireBelow = dynamic_cast<LogicWire*>(collidingItems[0]);
-                if (nullptr != wireBelow)
-                {
-                    // We trust that all wires have been inserted into mWireMap because checking would be costly
-                    mWireGroups[mWireMap.at(wireBelow)].push_back(static_cast<IBaseComponent*>(comp));
-                }
+                registeredWires++;
             }
         }
-        ProcessingHeartbeat();
-    }
-}
+        else if (nullptr != dynamic_cast<ConPoint*>(item))
+        {
+            const auto conPoint = static_cast<ConPoint*>(item);
+            mCircuitGeometry.conPoints.push_back(ConPointGeometry{ToGridPoint(conPoint->pos()), conPoint->GetConnectionType()});
+            mGeometryConPoints.push_back(conPoint);
+        }
+        else if (nullptr != dynamic_cast<IBaseComponent*>(item) && nullptr != static_cast<IBaseComponent*>(item)->GetLogicCell())
+        {
+            const auto component = static_cast<IBaseComponent*>(item);
+            const auto& logicCell = component->GetLogicCell();
 
-void CoreLogic::ExploreGroup(LogicWire* pWire, int32_t pGroupIndex)
-{
-    Q_ASSERT(pWire);
-    Q_ASSERT(pGroupIndex >= 0);
+            ComponentGeometry geometry;
+            geometry.pos = ToGridPoint(component->pos());
+            geometry.cell.kernel = logicCell->GetKernel();
+            geometry.cell.inputInverted = logicCell->GetInputInversions();
+            geometry.cell.outputInverted = logicCell->GetOutputInversions();
+            geometry.cell.parameters = logicCell->GetParameters();
 
-    mWireMap[pWire] = pGroupIndex;
-    mWireGroups[pGroupIndex].push_back(pWire); // Note: pWire must not be part of group pGroupIndex before the call to ExploreGroup
+            // Unused connectors are placed far outside of the scene and are skipped
+            for (const auto& connector : component->GetInConnectors())
+            {
+                if (canvas::DIMENSIONS.contains(component->pos() + connector.pos))
+                {
+                    geometry.inputs.push_back(ConnectorGeometry{ToGridPoint(component->pos() + connector.pos), connector.num});
+                }
+            }
 
-    for (auto& coll : mView.Scene()->collidingItems(pWire, Qt::IntersectsItemShape)) // Item shape is sufficient for wire collision
-    {
-        if (dynamic_cast<LogicWire*>(coll) != nullptr && mWireMap.find(static_cast<LogicWire*>(coll)) == mWireMap.end())
-        {
-            auto collisionPoint = GetWireCollisionPoint(pWire, static_cast<LogicWire*>(coll));
-            if (collisionPoint.has_value())
+            for (const auto& connector : component->GetOutConnectors())
             {
-                // Get ConPoints to recognize connected wires and traverse them recursively
-                auto conPoint = GetConPointAtPosition(collisionPoint.value(), ConnectionType::FULL);
-                if (conPoint.has_value() || IsLCrossing(pWire, static_cast<LogicWire*>(coll)))
+                if (canvas::DIMENSIONS.contains(component->pos() + connector.pos))
                 {
-                    ExploreGroup(static_cast<LogicWire*>(coll), pGroupIndex);
+                    geometry.outputs.push_back(ConnectorGeometry{ToGridPoint(component->pos() + connector.pos), connector.num});
                 }
             }
+
+            mCircuitGeometry.components.push_back(geometry);
+            mGeometryComponents.push_back(component);
         }
-        ProcessingHeartbeat();
     }
+
+    // Every edit updates mConnectivity, so none of its wires may have left the scene unnoticed
+    Q_ASSERT(registeredWires == mGeometryWires.size());
+    Q_UNUSED(registeredWires);
 }
 
-std::optional<QPointF> CoreLogic::GetWireCollisionPoint(const LogicWire* pWireA, const LogicWire* pWireB) const
+void CoreLogic::CreateWireLogicCells(const NetlistExtractor& pExtractor)
 {
-    Q_ASSERT(pWireA);
-    Q_ASSERT(pWireB);
+    mCompiledCells.assign(pExtractor.GetNetlist().cells.size(), nullptr);
+    mCellRepaintItems.assign(pExtractor.GetNetlist().cells.size(), 1); // Components and diodes are one item each
 
-    if (pWireA->GetDirection() == WireDirection::HORIZONTAL && pWireB->GetDirection() == WireDirection::VERTICAL)
+    // All wires of a group share one logic cell
+    for (uint32_t wire = 0; wire < mGeometryWires.size(); wire++)
     {
-        return QPointF(pWireB->x(), pWireA->y());
+        auto& logicCell = mCompiledCells[pExtractor.GetWireCell(wire)];
+
+        if (nullptr == logicCell)
+        {
+            logicCell = std::make_shared<LogicWireCell>(this);
+            mCellRepaintItems[pExtractor.GetWireCell(wire)] = 0;
+        }
+
+        mCellRepaintItems[pExtractor.GetWireCell(wire)]++;
+
+        mGeometryWires[wire]->SetLogicCell(std::static_pointer_cast<LogicWireCell>(logicCell));
     }
-    else if (pWireA->GetDirection() == WireDirection::VERTICAL && pWireB->GetDirection() == WireDirection::HORIZONTAL)
+
+    // Full ConPoints show the state of the wire group below
+    for (uint32_t conPoint = 0; conPoint < mGeometryConPoints.size(); conPoint++)
     {
-        return QPointF(pWireA->x(), pWireB->y());
-    }
+        const auto cell = pExtractor.GetConPointCell(conPoint);
 
-    return std::nullopt;
+        if (mGeometryConPoints[conPoint]->GetConnectionType() == ConnectionType::FULL && cell != NetlistExtractor::NO_CELL)
+        {
+            mGeometryConPoints[conPoint]->SetLogicCell(mCompiledCells[cell]);
+            mCellRepaintItems[cell]++;
+        }
+    }
 }
 
-bool CoreLogic::IsLCrossing(LogicWire* pWireA, LogicWire* pWireB) const
+void CoreLogic::CompileLogicCells(const NetlistExtractor& pExtractor)
 {
-    Q_ASSERT(pWireA && pWireB);
+    const auto& netlist = pExtractor.GetNetlist();
 
-    const LogicWire* a = nullptr;
-    const LogicWire* b = nullptr;
-
-    if (pWireA->GetDirection() == pWireB->GetDirection())
+    for (uint32_t component = 0; component < mGeometryComponents.size(); component++)
     {
-        return false;
+        mCompiledCells[pExtractor.GetComponentCell(component)] = mGeometryComponents[component]->GetLogicCell();
     }
 
-    if (pWireA->GetDirection() == WireDirection::VERTICAL && pWireB->GetDirection() == WireDirection::HORIZONTAL)
-    {
-        a = pWireB;
-        b = pWireA;
-    }
-    else // must be pWireA horizontal, pWireB vertical
+    for (uint32_t conPoint = 0; conPoint < mGeometryConPoints.size(); conPoint++)
     {
-        a = pWireA;
-        b = pWireB;
+        if (mGeometryConPoints[conPoint]->GetConnectionType() != ConnectionType::FULL)
+        {
+            mCompiledCells[pExtractor.GetConPointCell(conPoint)] = mGeometryConPoints[conPoint]->GetLogicCell();
+        }
     }
 
-    return ((a->y() == b->y() && a->x() == b->x()) || (a->y() == b->y() && a->x() + a->GetLength() == b->x())
-        || (a->x() == b->x() && b->y() + b->GetLength() == a->y()) || (a->x() + a->GetLength() == b->x() && a->y() == b->y() + b->GetLength()));
-}
-
-std::optional<ConPoint*> CoreLogic::GetConPointAtPosition(QPointF pPos, ConnectionType pType) const
-{
-    for (const auto& comp : mView.Scene()->items(pPos, Qt::IntersectsItemShape))
+    // Mark connected pins, so components can draw unconnected ones differently; wire cells have no pins of their own
+    for (const auto& connection : netlist.connections)
     {
-        if ((nullptr != dynamic_cast<ConPoint*>(comp)) && (pType == static_cast<ConPoint*>(comp)->GetConnectionType()))
+        if (netlist.cells[connection.sourceCell].kernel != CellKernel::WIRE)
+        {
+            mCompiledCells[connection.sourceCell]->SetOutputConnected(connection.sourceOutput);
+        }
+
+        if (netlist.cells[connection.targetCell].kernel != CellKernel::WIRE)
         {
-            return static_cast<ConPoint*>(comp);
+            mCompiledCells[connection.targetCell]->SetInputConnected(connection.targetInput);
         }
     }
 
-    return std::nullopt;
+    // Compile synchronously, so the snapshot is complete before the cells wake up
+    QMetaObject::invokeMethod(&mSimulationWorker, [this, &netlist]()
+    {
+        mSimulationWorker.Compile(netlist);
+    }, Qt::BlockingQueuedConnection);
+
+    mChangedCells.clear();
+    mSimulationWorker.TakeSnapshot(mSimulationSnapshot, mChangedCells);
+
+    for (uint32_t index = 0; index < mCompiledCells.size(); index++)
+    {
+        Q_ASSERT(mCompiledCells[index]);
+        mCompiledCells[index]->AttachToSimulation(&mSimulationSnapshot, index);
+    }
 }
 
-void CoreLogic::CreateWireLogicCells()
+void CoreLogic::SetUpWaveformRecording(const NetlistExtractor& pExtractor)
 {
-    mLogicWireCells.clear();
+    const auto& netlist = pExtractor.GetNetlist();
+    std::vector<WaveformSignal> recordedSignals;
+
+    mWaveformStripSignals.clear();
+    mWaveformStripNames.clear();
 
-    for (const auto& group : mWireGroups)
+    for (uint32_t component = 0; component < mGeometryComponents.size(); component++)
     {
-        auto logicCell = std::make_shared<LogicWireCell>(this);
-        mLogicWireCells.emplace_back(logicCell);
-        for (auto& comp : group)
+        const auto cell = pExtractor.GetComponentCell(component);
+        const auto pos = mGeometryComponents[component]->pos();
+
+        switch (netlist.cells[cell].kernel)
         {
-            if (dynamic_cast<LogicWire*>(comp) != nullptr)
+            case CellKernel::INPUT:
             {
-                static_cast<LogicWire*>(comp)->SetLogicCell(logicCell);
+                recordedSignals.push_back(WaveformSignal{cell, 0, false, GetSignalName("input", pos)});
+                break;
             }
-            else if (dynamic_cast<ConPoint*>(comp) != nullptr) // Full crossing because sorted into group
+            case CellKernel::BUTTON:
             {
-                static_cast<ConPoint*>(comp)->SetLogicCell(logicCell);
+                recordedSignals.push_back(WaveformSignal{cell, 0, false, GetSignalName("button", pos)});
+                break;
+            }
+            case CellKernel::CLOCK:
+            {
+                recordedSignals.push_back(WaveformSignal{cell, 0, false, GetSignalName("clock", pos)});
+                break;
+            }
+            case CellKernel::OUTPUT:
+            {
+                recordedSignals.push_back(WaveformSignal{cell, 0, true, GetSignalName("output", pos)});
+                mWaveformStripSignals.push_back(recordedSignals.size() - 1);
+                mWaveformStripNames.push_back(QString::fromStdString(recordedSignals.back().name));
+                break;
+            }
+            default:
+            {
+                break;
             }
-            ProcessingHeartbeat();
         }
     }
-}
 
-void CoreLogic::ConnectLogicCells()
-{
-    for (auto& comp : mView.Scene()->items())
+    // Every wire group is one net, named after its first wire
+    std::vector<bool> isNetRecorded(netlist.cells.size(), false);
+    for (uint32_t wire = 0; wire < mGeometryWires.size(); wire++)
     {
-        ProcessingHeartbeat();
+        const auto cell = pExtractor.GetWireCell(wire);
 
-        if (nullptr == dynamic_cast<IBaseComponent*>(comp) || nullptr != dynamic_cast<LogicWire*>(comp))
+        if (!isNetRecorded[cell])
         {
-            continue; //  Skip if no non-wire component
+            isNetRecorded[cell] = true;
+            recordedSignals.push_back(WaveformSignal{cell, 0, false, GetSignalName("net", mGeometryWires[wire]->pos())});
         }
+    }
 
-        auto compBase = static_cast<IBaseComponent*>(comp);
+    QMetaObject::invokeMethod(&mSimulationWorker, [this, recordedSignals = std::move(recordedSignals)]() mutable
+    {
+        mSimulationWorker.SetWaveformSignals(std::move(recordedSignals));
+    });
 
-        for (auto& coll : mView.Scene()->collidingItems(comp, Qt::IntersectsItemBoundingRect))
-        {
-            ProcessingHeartbeat();
+    mWaveformStripTimer.start();
+}
 
-            if (nullptr == dynamic_cast<LogicWire*>(coll))
-            {
-                continue; // Skip if no wire
-            }
+void CoreLogic::RequestWaveformStripUpdate()
+{
+    mIsWaveformStripUpdatePending = true;
+    mWaveformStripTimer.restart();
 
-            // Component <-> Wire connection
-            auto wire = static_cast<LogicWire*>(coll);
+    QMetaObject::invokeMethod(&mSimulationWorker, [this, stripSignals = mWaveformStripSignals]()
+    {
+        uint64_t endTick = 0;
+        auto traces = mSimulationWorker.GetWaveformTraces(stripSignals, simulation::WAVEFORM_STRIP_TICKS, endTick);
 
-            if (nullptr != dynamic_cast<ConPoint*>(comp))
-            {
-                const auto& conPoint = static_cast<ConPoint*>(comp);
-                if (conPoint->GetConnectionType() != ConnectionType::FULL) // Diode <-> Wire connection
-                {
-                    Q_ASSERT(compBase->GetLogicCell());
-                    auto outputDirection = (conPoint->GetConnectionType() == ConnectionType::DIODE_X ? WireDirection::HORIZONTAL : WireDirection::VERTICAL);
-                    auto inputDirection = (conPoint->GetConnectionType() == ConnectionType::DIODE_X ? WireDirection::VERTICAL : WireDirection::HORIZONTAL);
+        // Back on the GUI thread, the strip may have been reconfigured in the meantime
+        QMetaObject::invokeMethod(this, [this, traces = std::move(traces), endTick]() mutable
+        {
+            mIsWaveformStripUpdatePending = false;
 
-                    if ((wire->GetDirection() == outputDirection)
-                            && wire->contains(wire->mapFromScene(compBase->pos() + compBase->GetOutConnectors()[0].pos)))
-                    {
-                        std::static_pointer_cast<LogicWireCell>(wire->GetLogicCell())->AddInputSlot();
-                        compBase->GetLogicCell()->ConnectOutput(wire->GetLogicCell(), std::static_pointer_cast<LogicWireCell>(wire->GetLogicCell())->GetInputSize() - 1, 0);
-                    }
-                    else if ((wire->GetDirection() == inputDirection)
-                            && wire->contains(wire->mapFromScene(compBase->pos() + compBase->GetInConnectors()[0].pos)))
-                    {
-                        std::static_pointer_cast<LogicWireCell>(wire->GetLogicCell())->AppendOutput(compBase->GetLogicCell(), 0);
-                    }
-                }
-            }
-            else // Other component <-> Wire connection
+            if (mControlMode == ControlMode::SIMULATION && traces.size() == mWaveformStripNames.size())
             {
-                for (size_t out = 0; out < compBase->GetOutConnectorCount(); out++)
-                {
-                    if (wire->contains(wire->mapFromScene(compBase->pos() + compBase->GetOutConnectors()[out].pos)))
-                    {
-                        std::static_pointer_cast<LogicWireCell>(wire->GetLogicCell())->AddInputSlot();
-                        compBase->GetLogicCell()->ConnectOutput(wire->GetLogicCell(), std::static_pointer_cast<LogicWireCell>(wire->GetLogicCell())->GetInputSize() - 1, out);
-                    }
-                }
-
-                for (size_t in = 0; in < compBase->GetInConnectorCount(); in++)
-                {
-                    if (wire->contains(wire->mapFromScene(compBase->pos() + compBase->GetInConnectors()[in].pos)))
-                    {
-                        std::static_pointer_cast<LogicWireCell>(wire->GetLogicCell())->AppendOutput(compBase->GetLogicCell(), in);
-                    }
-                }
+                const auto startTick = (endTick > simulation::WAVEFORM_STRIP_TICKS ? endTick - simulation::WAVEFORM_STRIP_TICKS : 0);
+                mView.GetWaveformStrip()->SetWaveform(startTick, endTick, mWaveformStripNames, std::move(traces));
             }
-        }
-    }
+        });
+    });
 }
 
 void CoreLogic::StartProcessing()
@@ -1282,6 +1779,7 @@ void CoreLogic::EndProcessing()
 {
     mProcessingTimer.stop();
     mView.FadeOutProcessingOverlay();
+    mView.ShowProcessingProgress(false);
     mIsProcessing = false;
     emit ProcessingEndedSignal();
 }
@@ -1291,6 +1789,15 @@ bool CoreLogic::IsProcessing() const
     return mIsProcessing;
 }
 
+void CoreLogic::CancelProcessing()
+{
+    // Only the netlist extraction can be cancelled, the result is dropped in OnExtractionFinished
+    if (mIsExtracting)
+    {
+        mExtractionWorker.Cancel(mExtractionJob);
+    }
+}
+
 bool CoreLogic::IsDFlipFlopMasterSlave() const
 {
     return mIsDFlipFlopMasterSlave;
@@ -1676,6 +2183,7 @@ void CoreLogic::CopySelectedComponents()
         // Create a copy of the original component
         IBaseComponent* copy = static_cast<IBaseComponent*>(orig)->CloneBaseComponent(this);
         Q_ASSERT(copy);
+        copy->CopyDelay(*static_cast<IBaseComponent*>(orig));
 
         copy->setPos(SnapToGrid(orig->pos() + QPointF(canvas::GRID_SIZE, canvas::GRID_SIZE)));
 
@@ -1712,6 +2220,7 @@ void CoreLogic::PasteCopiedComponents()
         // Create a copy of the copy component
         IBaseComponent* copy = static_cast<IBaseComponent*>(comp)->CloneBaseComponent(this);
         Q_ASSERT(copy);
+        copy->CopyDelay(*static_cast<IBaseComponent*>(comp));
 
         copy->setPos(comp->pos());
         copy->setSelected(true);
@@ -1773,7 +2282,9 @@ QJsonObject CoreLogic::GetJson() const
     {
         if (nullptr != dynamic_cast<IBaseComponent*>(item))
         {
-            components.append(static_cast<IBaseComponent*>(item)->GetJson());
+            auto componentJson = static_cast<IBaseComponent*>(item)->GetJson();
+            static_cast<IBaseComponent*>(item)->SaveDelay(componentJson);
+            components.append(componentJson);
             auto version = static_cast<IBaseComponent*>(item)->GetMinVersion();
             minVersion = GetNewerVersion(minVersion, version);
         }
@@ -1802,6 +2313,8 @@ void CoreLogic::NewCircuit()
         mView.Scene()->removeItem(item);
     }
 
+    ResetConnectivity();
+
     mView.ResetViewport();
 
     // Clear undo and redo stacks
@@ -1870,6 +2383,8 @@ void CoreLogic::ReadJson(const QFileInfo& pFileInfo, const QJsonObject& pJson)
         }
     }
 
+    ResetConnectivity();
+
     // Clear undo and redo stacks
     mUndoQueue.clear();
     mRedoQueue.clear();
@@ -2040,6 +2555,7 @@ bool CoreLogic::CreateComponent(const QJsonObject &pJson)
 
         if (nullptr != item)
         {
+            item->LoadDelay(pJson);
             mView.Scene()->addItem(item);
             return true;
         }
@@ -2053,6 +2569,7 @@ void CoreLogic::AppendUndo(UndoBaseType* pUndoObject)
 {
     Q_ASSERT(pUndoObject);
 
+    UpdateConnectivity(pUndoObject);
     mCircuitFileParser.MarkAsModified();
     AppendToUndoQueue(pUndoObject, mUndoQueue);
     mRedoQueue.clear();
@@ -2189,6 +2706,7 @@ void CoreLogic::Undo()
                 break;
             }
         }
+        UpdateConnectivity(undoObject);
         mCircuitFileParser.MarkAsModified();
     }
     ClearSelection();
@@ -2311,6 +2829,7 @@ void CoreLogic::Redo()
                 break;
             }
         }
+        UpdateConnectivity(redoObject);
         mCircuitFileParser.MarkAsModified();
     }
     ClearSelection();
@@ -11,10 +11,17 @@
 #include "Configuration.h"
 #include "RuntimeConfigParser.h"
 #include "CircuitFileParser.h"
+#include "Simulation/ConnectivityModel.h"
+#include "Simulation/ExtractionWorker.h"
+#include "Simulation/SimulationWorker.h"
+#include "Simulation/SimulationSnapshot.h"
 
 #include <QGraphicsItem>
 #include <QTimer>
+#include <QThread>
+#include <QElapsedTimer>
 #include <deque>
+#include <unordered_map>
 
 class View;
 
@@ -29,6 +36,9 @@ public:
     /// \param pView: The view that contains the main scene
     CoreLogic(View &pView);
 
+    /// \brief Destructor for CoreLogic, stops the simulation thread
+    ~CoreLogic() override;
+
     /// \brief Getter for the runtime config parser object
     /// \return Reference to the runtime config parser
     RuntimeConfigParser& GetRuntimeConfigParser(void);
@@ -146,10 +156,17 @@ public:
     /// \return True, if in simulation mode
     bool IsSimulationRunning(void) const;
 
+    /// \brief Getter for the number of combinational loops that oscillate in the current simulation
+    /// \return The number of oscillating loops at the last frame
+    uint32_t GetOscillatingLoopCount(void) const;
+
     /// \brief Returns whether the software is currently processing or loading
     /// \return True, if the software is currently processing or loading
     bool IsProcessing(void) const;
 
+    /// \brief Cancels the current process, if it can be cancelled
+    void CancelProcessing(void);
+
     /// \brief Returns true, if the current config for new D flip-flips is master-slave
     /// \return True, if the current config for new D flip-flips is master-slave, false otherwise
     bool IsDFlipFlopMasterSlave(void) const;
@@ -162,6 +179,9 @@ public:
     /// \brief Starts the simulation if in simulation mode and the simulation is not yet started
     void RunSimulation(void);
 
+    /// \brief Starts the simulation unthrottled, ticking as fast as possible
+    void RunSimulationAtMaxSpeed(void);
+
     /// \brief Pauses the simulation if it is currently running
     void PauseSimulation(void);
 
@@ -171,6 +191,43 @@ public:
     /// \brief Advances the simulation by one tick if in simulation mode
     void StepSimulation(void);
 
+    /// \brief Pauses the simulation and restores the state it had one tick earlier, if in simulation mode
+    void StepBackSimulation(void);
+
+    /// \brief Writes the waveform recorded in the current simulation to the given file in the Value Change Dump format
+    /// \param pPath: The path of the file to write
+    /// \return False, if not in simulation mode or the file could not be written
+    bool ExportWaveform(const QString& pPath);
+
+    /// \brief Enables or disables settling combinational logic within one tick, takes effect on the next simulation start
+    /// \param pEnabled: True to enable the zero delay settle mode
+    void SetZeroDelaySettleEnabled(bool pEnabled);
+
+    /// \brief Sets how oscillating combinational loops are limited, takes effect on the next simulation start
+    /// \param pLimit: The oscillation limit
+    void SetOscillationLimit(OscillationLimit pLimit);
+
+    // Functions for profiling
+
+    /// \brief Enables or disables profiling of the simulation ticks and of the GUI frames
+    /// \param pEnabled: True to enable profiling
+    void SetProfilingEnabled(bool pEnabled);
+
+    /// \brief Returns true, if profiling is enabled
+    /// \return True, if profiling is enabled
+    bool IsProfilingEnabled(void) const;
+
+    /// \brief Getter for the merged tick and frame profiles, waits for the simulation thread
+    /// \return The profile
+    SimulationProfiler GetProfile(void);
+
+    /// \brief Discards all profiled ticks and frames
+    void ClearProfile(void);
+
+    /// \brief Adds the duration of a scene paint event to the frame profile, if profiling is enabled
+    /// \param pNanoseconds: The duration of the paint event
+    void AddPaintSample(uint64_t pNanoseconds);
+
     // Functions for undo and redo
 
     /// \brief Returns true, if the undo queue has no elements
@@ -237,12 +294,16 @@ signals:
     /// \brief Emitted when the core logic has started the simulation
     void SimulationStartSignal(void);
 
-    /// \brief Emitted when the simulation should advance by one step
-    void SimulationAdvanceSignal(void);
-
     /// \brief Emitted when the core logic has stopped the simulation
     void SimulationStopSignal(void);
 
+    /// \brief Emitted when entering the simulation has been cancelled by the user
+    void SimulationEntryCancelledSignal(void);
+
+    /// \brief Emitted periodically while the simulation is running
+    /// \param pTicksPerSecond: The number of ticks simulated per second since the last emission
+    void TicksPerSecondChangedSignal(double pTicksPerSecond);
+
     /// \brief Emitted when the undo/redo button enabled state should be updated
     void UpdateUndoRedoEnabledSignal(void);
 
@@ -305,19 +366,72 @@ public slots:
 
     // ///////////////////////////////
 
-    /// \brief Advances the simulation by one step; invoked by mPropagationTimer
-    void OnPropagationTimeout(void);
+    /// \brief Samples the simulation state and forwards changes to the components; invoked by mFrameTimer
+    void OnFrameTimeout(void);
+
+    /// \brief Forwards the toggle or press of an input to the simulation thread; invoked by input logic cells
+    /// \param pEngineIndex: The simulation engine index of the activated input cell
+    void OnInputActivated(uint32_t pEngineIndex);
 
     /// \brief Displays the processing overlay (loading screen); invoked by mProcessingTimer
     void OnProcessingTimeout(void);
 
+    /// \brief Forwards the extraction progress to the processing overlay; invoked by mExtractionWorker
+    /// \param pJob: The job number of the extraction
+    /// \param pPercent: The progress in percent
+    void OnExtractionProgressChanged(uint32_t pJob, uint8_t pPercent);
+
+    /// \brief Sets up the logic cells and starts the simulation, or leaves it if cancelled; invoked by mExtractionWorker
+    /// \param pJob: The job number of the extraction
+    /// \param pIsCancelled: True, if the extraction has been cancelled
+    void OnExtractionFinished(uint32_t pJob, bool pIsCancelled);
+
 protected:
-    /// \brief Performs all neccessary steps to enter simulation mode
-    void EnterSimulation(void);
+    /// \brief Sets up the simulation, extracting the netlist in the background first if the circuit has been edited
+    /// The extraction uses the wire groups of mConnectivity and only looks up the pins of components and ConPoints.
+    /// After an extraction, the simulation is set up in OnExtractionFinished
+    /// \param pRunWhenReady: If true, the simulation starts running as soon as it is set up
+    void EnterSimulation(bool pRunWhenReady);
+
+    /// \brief Instantiates the logic cells of the last extracted netlist and starts the simulation
+    /// \param pRunWhenReady: If true, the simulation starts running immediately
+    void SetUpSimulation(bool pRunWhenReady);
+
+    /// \brief Marks the last extracted netlist as outdated, for edits of cell parameters that leave the wiring unchanged
+    void InvalidateNetlist(void);
+
+    /// \brief Updates the connectivity model for all wires and ConPoints affected by an edit and invalidates the netlist
+    /// Must be called whenever an undo object has been appended, undone or redone
+    /// \param pUndoObject: The undo object describing the edit
+    void UpdateConnectivity(UndoBaseType* pUndoObject);
+
+    /// \brief Updates the connectivity model for the given components
+    /// \param pComponents: The components that may have been added, removed, moved or reconfigured
+    void UpdateConnectivity(const std::vector<IBaseComponent*>& pComponents);
+
+    /// \brief Updates the connectivity model for one component, comparing its current state in the scene to the registered one
+    /// Wires are registered while they are in the scene, ConPoints while they are in the scene and of type FULL
+    /// \param pComponent: The component, other components than wires and ConPoints are ignored
+    void UpdateConnectivity(IBaseComponent* pComponent);
+
+    /// \brief Rebuilds the connectivity model from all components in the scene, used after replacing the whole circuit
+    void ResetConnectivity(void);
 
     /// \brief Performs all neccessary steps to leave simulation mode
     void LeaveSimulation(void);
 
+    /// \brief Starts the simulation worker with the given timing if in simulation mode and the simulation is not yet started
+    /// \param pInterval: The interval between two timer timeouts of the worker
+    /// \param pTicksPerTimeout: The number of ticks per timeout, or 0 to tick for MAX_SPEED_BATCH_DURATION per timeout
+    void StartSimulationWorker(std::chrono::milliseconds pInterval, uint32_t pTicksPerTimeout);
+
+    /// \brief Emits the achieved ticks per second if the measurement interval has passed
+    void UpdateTicksPerSecond(void);
+
+    /// \brief Getter for the interval in which the simulation state is sampled for display
+    /// \return One frame of the screen showing the view, but at least simulation::MIN_FRAME_INTERVAL
+    std::chrono::milliseconds GetFrameInterval(void) const;
+
     /// \brief Sets the current simulation mode to the given mode and emits the change signal
     /// \param pNewMode: The new simulation mode to go into
     void SetSimulationMode(SimulationMode pNewMode);
@@ -390,24 +504,6 @@ protected:
     /// \return True, if there are two wires in pPoint crossing each other
     bool IsXCrossingPoint(QPointF pPoint) const;
 
-    /// \brief Checks if the two given wires form an L-type crossing
-    /// \param pWireA: The first wire
-    /// \param pWireB: The second wire
-    /// \return True, if the wires form an L-type crossing
-    bool IsLCrossing(LogicWire* pWireA, LogicWire* pWireB) const;
-
-    /// \brief Gets the collision point of two wires of different direction, assuming they do in fact collide
-    /// \param pWireA: The first wire
-    /// \param pWireB: The second wire
-    /// \return The collision point of the wires (optional)
-    std::optional<QPointF> GetWireCollisionPoint(const LogicWire* pWireA, const LogicWire* pWireB) const;
-
-    /// \brief Checks if a ConPoint of the given type collides with the given position
-    /// \param pPos: The position to check
-    /// \param pType: The connection type to look for
-    /// \return A pointer to the ConPoint (optional)
-    std::optional<ConPoint*> GetConPointAtPosition(QPointF pPos, ConnectionType pType) const;
-
     // Functions for component retreival
 
     /// \brief Checks if a component of the given type T collides with the given position
@@ -434,19 +530,29 @@ protected:
 
     // Functions for entering simulation mode (parsing, setting up logic cells etc.)
 
-    /// \brief Groups all existing wires into groups that are connected, meaning they always have the same logic state
-    void ParseWireGroups(void);
+    /// \brief Captures the connectivity relevant geometry of all scene components into mCircuitGeometry
+    /// Wires are taken from mConnectivity, so their order matches mGeometryWires
+    void CreateCircuitGeometry(void);
 
-    /// \brief Looks for wires connecting to pWire and recursively includes them in the group
-    /// \param pWire: The root wire of that the group should be explored
-    /// \param pGroupIndex: The index of a group in mWireGroups
-    void ExploreGroup(LogicWire* pWire, int32_t pGroupIndex);
+    /// \brief Creates logic cells for the extracted wire groups and assigns them to wires and full ConPoints
+    /// \param pExtractor: The extractor holding the netlist
+    void CreateWireLogicCells(const NetlistExtractor& pExtractor);
 
-    /// \brief Creates logic cells for wire groups, including full ConPoints
-    void CreateWireLogicCells(void);
+    /// \brief Compiles the extracted netlist in the simulation engine and attaches the logic cells to it
+    /// \param pExtractor: The extractor holding the netlist
+    void CompileLogicCells(const NetlistExtractor& pExtractor);
 
-    /// \brief Connects all logic cells based on their connector positions
-    void ConnectLogicCells(void);
+    /// \brief Updates the simulation snapshot and emits the state changed signal of all logic cells whose state changed
+    void ForwardStateChanges(void);
+
+    /// \brief Selects the signals the waveform recorder records: all wire groups, inputs and outputs
+    /// Outputs are also shown in the waveform strip
+    /// \param pExtractor: The extractor holding the netlist
+    void SetUpWaveformRecording(const NetlistExtractor& pExtractor);
+
+    /// \brief Requests the latest traces of the waveform strip signals from the simulation thread
+    /// The strip is updated asynchronously once they arrive
+    void RequestWaveformStripUpdate(void);
 
     // Functions for undo and redo
 
@@ -512,13 +618,46 @@ protected:
     LogicWire mHorizontalPreviewWire;
     LogicWire mVerticalPreviewWire;
 
-    // Variables for wire parsing (grouping)
-    std::vector<std::vector<IBaseComponent*>> mWireGroups;
-    std::map<LogicWire*, int32_t> mWireMap; // Contains wire pointers as keys and group indizes as values
-
-    std::vector<std::shared_ptr<LogicWireCell>> mLogicWireCells;
-
-    QTimer mPropagationTimer; // Main timer to set the propagation delay
+    // Wire groups of the circuit, updated on every edit; mGeometryWires holds the scene wire of every model wire
+    ConnectivityModel mConnectivity;
+    std::unordered_map<const LogicWire*, uint32_t> mConnectivityWires; // Model index of every registered wire
+    std::unordered_map<const ConPoint*, GridPoint> mConnectivityConPoints; // Registered position of every full ConPoint
+
+    // Variables for netlist extraction, the geometry vectors map geometry indices to scene components
+    // The extraction runs on its own thread on a copy of the geometry and reads mConnectivity, only the job with the current number is processed
+    CircuitGeometry mCircuitGeometry;
+    ExtractionWorker mExtractionWorker;
+    QThread mExtractionThread;
+    uint32_t mExtractionJob = ExtractionWorker::NO_JOB;
+    bool mIsExtracting = false;
+    bool mRunAfterExtraction = false;
+    bool mIsNetlistValid = false; // True, if the extracted netlist matches the circuit
+    std::vector<IBaseComponent*> mGeometryComponents;
+    std::vector<LogicWire*> mGeometryWires;
+    std::vector<ConPoint*> mGeometryConPoints;
+
+    // The simulation runs on its own thread, the GUI only reads mSimulationSnapshot
+    SimulationWorker mSimulationWorker;
+    QThread mSimulationThread;
+    SimulationSnapshot mSimulationSnapshot;
+    std::vector<std::shared_ptr<LogicBaseCell>> mCompiledCells; // Logic cells by simulation engine index
+    std::vector<uint32_t> mChangedCells;
+    std::vector<uint32_t> mCellRepaintItems; // Number of graphics items repainted when a logic cell's state changes
+
+    QTimer mFrameTimer; // Timer to sample the simulation state for display
+
+    QElapsedTimer mTicksPerSecondTimer;
+    uint64_t mTicksPerSecondStartTick = 0;
+
+    // Recorded signals shown in the waveform strip, at most one strip update is requested at a time
+    std::vector<uint32_t> mWaveformStripSignals;
+    std::vector<QString> mWaveformStripNames;
+    QElapsedTimer mWaveformStripTimer;
+    bool mIsWaveformStripUpdatePending = false;
+
+    // Frame measurements of the GUI thread, merged with the tick measurements of the simulation thread
+    SimulationProfiler mFrameProfiler;
+    bool mIsProfiling = false;
 
     // Undo and redo queues
     std::deque<UndoBaseType*> mUndoQueue;
@@ -10,7 +10,8 @@ MainWindow::MainWindow(QWidget *pParent) :
     mView(mAwesome, mCoreLogic),
     mCoreLogic(mView),
     mAboutDialog(this),
-    mWelcomeDialog(mAwesome, this)
+    mWelcomeDialog(mAwesome, this),
+    mStatisticsDialog(mCoreLogic, this)
 {
     mUi->setupUi(this);
 
@@ -28,6 +29,7 @@ MainWindow::MainWindow(QWidget *pParent) :
 
     QObject::connect(&mCoreLogic, &CoreLogic::ControlModeChangedSignal, this, &MainWindow::OnControlModeChanged);
     QObject::connect(&mCoreLogic, &CoreLogic::SimulationModeChangedSignal, this, &MainWindow::OnSimulationModeChanged);
+    QObject::connect(&mCoreLogic, &CoreLogic::TicksPerSecondChangedSignal, this, &MainWindow::OnTicksPerSecondChanged);
 
     ConnectGuiSignalsAndSlots();
 
@@ -89,6 +91,13 @@ void MainWindow::InitializeMessageBoxes()
     mErrorSaveFileBox.setText(tr("The circuit could not be saved."));
     mErrorSaveFileBox.setStandardButtons(QMessageBox::Ok);
     mErrorSaveFileBox.setDefaultButton(QMessageBox::Ok);
+
+    mErrorExportWaveformBox.setIcon(QMessageBox::Icon::Critical);
+    mErrorExportWaveformBox.setWindowTitle("Linkuit Studio");
+    mErrorExportWaveformBox.setWindowIcon(QIcon(":/images/icons/icon_default.png"));
+    mErrorExportWaveformBox.setText(tr("The waveform could not be exported."));
+    mErrorExportWaveformBox.setStandardButtons(QMessageBox::Ok);
+    mErrorExportWaveformBox.setDefaultButton(QMessageBox::Ok);
 }
 
 void MainWindow::InitializeTutorial()
@@ -332,10 +341,54 @@ void MainWindow::ConnectGuiSignalsAndSlots()
             mUi->uActionStart->setText(tr("Start"));
         }
     });
+    QObject::connect(&mCoreLogic, &CoreLogic::SimulationEntryCancelledSignal, this, [&]()
+    {
+        // Return to editing the same way as if the user stopped the simulation
+        if (mCoreLogic.IsSimulationRunning())
+        {
+            mUi->uActionStart->trigger();
+        }
+    });
     QObject::connect(mUi->uActionRun, &QAction::triggered, this, &MainWindow::RunSimulation);
+    QObject::connect(mUi->uActionRunMaxSpeed, &QAction::triggered, this, &MainWindow::RunSimulationAtMaxSpeed);
     QObject::connect(mUi->uActionStep, &QAction::triggered, this, &MainWindow::StepSimulation);
+    QObject::connect(mUi->uActionStepBack, &QAction::triggered, this, &MainWindow::StepBackSimulation);
     QObject::connect(mUi->uActionReset, &QAction::triggered, this, &MainWindow::ResetSimulation);
     QObject::connect(mUi->uActionPause, &QAction::triggered, this, &MainWindow::PauseSimulation);
+    QObject::connect(mUi->uActionShowWaveform, &QAction::toggled, &mView, &View::SetWaveformStripEnabled);
+    QObject::connect(mUi->uActionZeroDelaySettle, &QAction::toggled, &mCoreLogic, &CoreLogic::SetZeroDelaySettleEnabled);
+
+    auto oscillationLimitGroup = new QActionGroup(this);
+    oscillationLimitGroup->addAction(mUi->uActionOscillationReport);
+    oscillationLimitGroup->addAction(mUi->uActionOscillationSlowDown);
+    oscillationLimitGroup->addAction(mUi->uActionOscillationFreeze);
+
+    QObject::connect(mUi->uActionOscillationReport, &QAction::triggered, this, [&]()
+    {
+        mCoreLogic.SetOscillationLimit(OscillationLimit::NONE);
+    });
+    QObject::connect(mUi->uActionOscillationSlowDown, &QAction::triggered, this, [&]()
+    {
+        mCoreLogic.SetOscillationLimit(OscillationLimit::SLOW_DOWN);
+    });
+    QObject::connect(mUi->uActionOscillationFreeze, &QAction::triggered, this, [&]()
+    {
+        mCoreLogic.SetOscillationLimit(OscillationLimit::FREEZE);
+    });
+    QObject::connect(mUi->uActionExportWaveform, &QAction::triggered, this, [&]()
+    {
+        mFadeOutOnCtrlTimer.stop();
+        FadeInGui();
+
+        QString path = mCoreLogic.GetCircuitFileParser().IsFileOpen() ? mCoreLogic.GetCircuitFileParser().GetFileInfo().value().absolutePath() : mCoreLogic.GetRuntimeConfigParser().GetLastFilePath();
+        const auto fileInfo = QFileInfo(QFileDialog::getSaveFileName(this, tr(gui::EXPORT_WAVEFORM_DIALOG_TITLE), path, tr("Value Change Dump Files (*.vcd)")));
+
+        if (fileInfo.absoluteFilePath() != "" && !mCoreLogic.ExportWaveform(fileInfo.absoluteFilePath()))
+        {
+            mErrorExportWaveformBox.exec();
+        }
+    });
+    QObject::connect(mUi->uActionStatistics, &QAction::triggered, &mStatisticsDialog, &StatisticsDialog::show);
     QObject::connect(mUi->uActionAbout, &QAction::triggered, &mAboutDialog, &AboutDialog::show);
     QObject::connect(mUi->uActionClose, &QAction::triggered, this, &MainWindow::close);
 
@@ -990,11 +1043,21 @@ void MainWindow::RunSimulation()
     mCoreLogic.RunSimulation();
 }
 
+void MainWindow::RunSimulationAtMaxSpeed()
+{
+    mCoreLogic.RunSimulationAtMaxSpeed();
+}
+
 void MainWindow::StepSimulation()
 {
     mCoreLogic.StepSimulation();
 }
 
+void MainWindow::StepBackSimulation()
+{
+    mCoreLogic.StepBackSimulation();
+}
+
 void MainWindow::ResetSimulation()
 {
     mCoreLogic.ResetSimulation();
@@ -1090,8 +1153,11 @@ void MainWindow::OnControlModeChanged(ControlMode pNewMode)
 
             mUi->uActionStart->setEnabled(true);
             mUi->uActionRun->setEnabled(false);
+            mUi->uActionRunMaxSpeed->setEnabled(false);
             mUi->uActionReset->setEnabled(false);
+            mUi->uActionExportWaveform->setEnabled(false);
             mUi->uActionStep->setEnabled(false);
+            mUi->uActionStepBack->setEnabled(false);
             mUi->uActionPause->setEnabled(false);
 
             mUi->uEditButton->setChecked(true);
@@ -1127,8 +1193,11 @@ void MainWindow::OnControlModeChanged(ControlMode pNewMode)
 
             mUi->uActionStart->setEnabled(true);
             mUi->uActionRun->setEnabled(false);
+            mUi->uActionRunMaxSpeed->setEnabled(false);
             mUi->uActionReset->setEnabled(false);
+            mUi->uActionExportWaveform->setEnabled(false);
             mUi->uActionStep->setEnabled(false);
+            mUi->uActionStepBack->setEnabled(false);
             mUi->uActionPause->setEnabled(false);
 
             mUi->uEditButton->setChecked(true);
@@ -1164,8 +1233,11 @@ void MainWindow::OnControlModeChanged(ControlMode pNewMode)
 
             mUi->uActionStart->setEnabled(true);
             mUi->uActionRun->setEnabled(false);
+            mUi->uActionRunMaxSpeed->setEnabled(false);
             mUi->uActionReset->setEnabled(false);
+            mUi->uActionExportWaveform->setEnabled(false);
             mUi->uActionStep->setEnabled(false);
+            mUi->uActionStepBack->setEnabled(false);
             mUi->uActionPause->setEnabled(false);
 
             ForceUncheck(mUi->uEditButton);
@@ -1199,8 +1271,11 @@ void MainWindow::OnControlModeChanged(ControlMode pNewMode)
 
             mUi->uActionStart->setEnabled(true);
             mUi->uActionRun->setEnabled(false);
+            mUi->uActionRunMaxSpeed->setEnabled(false);
             mUi->uActionReset->setEnabled(false);
+            mUi->uActionExportWaveform->setEnabled(false);
             mUi->uActionStep->setEnabled(false);
+            mUi->uActionStepBack->setEnabled(false);
             mUi->uActionPause->setEnabled(false);
 
             ForceUncheck(mUi->uEditButton);
@@ -1237,8 +1312,11 @@ void MainWindow::OnControlModeChanged(ControlMode pNewMode)
 
             mUi->uActionStart->setEnabled(true);
             mUi->uActionRun->setEnabled(true);
+            mUi->uActionRunMaxSpeed->setEnabled(true);
             mUi->uActionReset->setEnabled(true);
+            mUi->uActionExportWaveform->setEnabled(true);
             mUi->uActionStep->setEnabled(true);
+            mUi->uActionStepBack->setEnabled(true);
             mUi->uActionPause->setEnabled(false);
 
             ForceUncheck(mUi->uEditButton);
@@ -1267,8 +1345,10 @@ void MainWindow::OnSimulationModeChanged(SimulationMode pNewMode)
             mUi->uStepButton->setEnabled(true);
 
             mUi->uActionRun->setEnabled(true);
+            mUi->uActionRunMaxSpeed->setEnabled(true);
             mUi->uActionPause->setEnabled(false);
             mUi->uActionStep->setEnabled(true);
+            mUi->uActionStepBack->setEnabled(true);
 
             mUi->uLabelStatus->setText(tr("Simulation paused."));
             break;
@@ -1279,8 +1359,10 @@ void MainWindow::OnSimulationModeChanged(SimulationMode pNewMode)
             mUi->uStepButton->setEnabled(false);
 
             mUi->uActionRun->setEnabled(false);
+            mUi->uActionRunMaxSpeed->setEnabled(false);
             mUi->uActionPause->setEnabled(true);
             mUi->uActionStep->setEnabled(false);
+            mUi->uActionStepBack->setEnabled(false);
             mUi->uLabelStatus->setText(tr("Simulation running..."));
             break;
         }
@@ -1291,6 +1373,24 @@ void MainWindow::OnSimulationModeChanged(SimulationMode pNewMode)
     }
 }
 
+void MainWindow::OnTicksPerSecondChanged(double pTicksPerSecond)
+{
+    if (mCoreLogic.GetSimulationMode() == SimulationMode::RUNNING)
+    {
+        const auto oscillatingLoopCount = mCoreLogic.GetOscillatingLoopCount();
+
+        if (oscillatingLoopCount > 0)
+        {
+            mUi->uLabelStatus->setText(tr("Simulation running at %0 ticks/s, %1 oscillating loop(s)...")
+                                       .arg(QString::number(pTicksPerSecond, 'f', 0)).arg(oscillatingLoopCount));
+        }
+        else
+        {
+            mUi->uLabelStatus->setText(tr("Simulation running at %0 ticks/s...").arg(QString::number(pTicksPerSecond, 'f', 0)));
+        }
+    }
+}
+
 void MainWindow::FadeOutGui()
 {
     mIsToolboxVisible = mUi->uToolboxContainer->isVisible();
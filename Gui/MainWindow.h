@@ -4,6 +4,7 @@
 #include "View.h"
 #include "QtAwesome.h"
 #include "Gui/AboutDialog.h"
+#include "Gui/StatisticsDialog.h"
 #include "Gui/WelcomeDialog.h"
 #include "Gui/IconToolButton.h"
 #include "Gui/TutorialFrame.h"
@@ -97,6 +98,10 @@ protected slots:
     /// \param pNewMode: The newly entered simulation mode
     void OnSimulationModeChanged(SimulationMode pNewMode);
 
+    /// \brief Displays the achieved simulation speed in the status bar
+    /// \param pTicksPerSecond: The number of simulated ticks per second
+    void OnTicksPerSecondChanged(double pTicksPerSecond);
+
     /// \brief Sets the displayed zoom level and the slider to the given values
     /// \param pPercentage: The new zoom value to display
     void UpdateZoomLabelAndSlider(uint8_t pPercentage, uint32_t pValue);
@@ -221,9 +226,15 @@ protected:
     /// \brief Runs the simulation
     void RunSimulation(void);
 
+    /// \brief Runs the simulation unthrottled
+    void RunSimulationAtMaxSpeed(void);
+
     /// \brief Advances the simulation by one tick
     void StepSimulation(void);
 
+    /// \brief Restores the simulation state of the previous tick
+    void StepBackSimulation(void);
+
     /// \brief Resets the simulation
     void ResetSimulation(void);
 
@@ -315,11 +326,13 @@ protected:
 
     AboutDialog mAboutDialog;
     WelcomeDialog mWelcomeDialog;
+    StatisticsDialog mStatisticsDialog;
 
     QMessageBox mSaveChangesBox;
     QMessageBox mErrorOpenFileBox;
     QMessageBox mErrorOpenRecentFileBox;
     QMessageBox mErrorSaveFileBox;
+    QMessageBox mErrorExportWaveformBox;
     QMessageBox mNewerVersionCompatibleBox;
     QMessageBox mNewerVersionIncompatibleBox;
 
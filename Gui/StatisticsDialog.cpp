@@ -0,0 +1,203 @@
+#include "StatisticsDialog.h"
+#include "CoreLogic.h"
+#include "Configuration.h"
+
+#include <QCheckBox>
+#include <QComboBox>
+#include <QFile>
+#include <QFileDialog>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QMessageBox>
+#include <QPainter>
+#include <QPushButton>
+#include <QTableWidget>
+#include <QVBoxLayout>
+#include <sstream>
+
+namespace
+{
+constexpr int32_t HISTOGRAM_HEIGHT = 120;
+constexpr int32_t BAR_SPACING = 2;
+const QColor BAR_COLOR(0, 150, 160);
+const QColor LABEL_COLOR(200, 200, 200);
+
+const QStringList COLUMN_TITLES{"Samples", "Mean", "p50", "p99", "Max"};
+}
+
+ProfileHistogramView::ProfileHistogramView(QWidget *pParent):
+    QWidget(pParent)
+{
+    setMinimumHeight(HISTOGRAM_HEIGHT);
+}
+
+void ProfileHistogramView::SetHistogram(const ProfileHistogram &pHistogram)
+{
+    mHistogram = pHistogram;
+    update();
+}
+
+void ProfileHistogramView::paintEvent(QPaintEvent *pEvent)
+{
+    Q_UNUSED(pEvent);
+
+    QPainter painter(this);
+    painter.fillRect(rect(), canvas::BACKGROUND_COLOR);
+    painter.setPen(LABEL_COLOR);
+
+    if (mHistogram.sampleCount == 0)
+    {
+        painter.drawText(rect(), Qt::AlignCenter, tr("No samples"));
+        return;
+    }
+
+    uint32_t firstBucket = ProfileHistogram::BUCKET_COUNT;
+    uint32_t lastBucket = 0;
+    uint64_t largestBucket = 0;
+
+    for (uint32_t bucket = 0; bucket < ProfileHistogram::BUCKET_COUNT; bucket++)
+    {
+        if (mHistogram.buckets[bucket] > 0)
+        {
+            firstBucket = std::min(firstBucket, bucket);
+            lastBucket = bucket;
+            largestBucket = std::max(largestBucket, mHistogram.buckets[bucket]);
+        }
+    }
+
+    const int32_t labelHeight = fontMetrics().height();
+    const QRect barArea = rect().adjusted(BAR_SPACING, BAR_SPACING, -BAR_SPACING, -labelHeight);
+    const int32_t barWidth = barArea.width() / static_cast<int32_t>(lastBucket - firstBucket + 1);
+
+    for (uint32_t bucket = firstBucket; bucket <= lastBucket; bucket++)
+    {
+        const int32_t x = barArea.left() + static_cast<int32_t>(bucket - firstBucket) * barWidth;
+        const int32_t height = static_cast<int32_t>(mHistogram.buckets[bucket] * barArea.height() / largestBucket);
+
+        painter.fillRect(x, barArea.bottom() - height, std::max(barWidth - BAR_SPACING, 1), height, BAR_COLOR);
+    }
+
+    painter.drawText(rect(), Qt::AlignBottom | Qt::AlignLeft, QString::number(ProfileHistogram::GetBucketUpperBound(firstBucket)));
+    painter.drawText(rect(), Qt::AlignBottom | Qt::AlignRight, QString::number(ProfileHistogram::GetBucketUpperBound(lastBucket)));
+}
+
+StatisticsDialog::StatisticsDialog(CoreLogic &pCoreLogic, QWidget *pParent):
+    QDialog(pParent),
+    mCoreLogic(pCoreLogic),
+    mUpdateTimer(this)
+{
+    setWindowTitle(tr("Simulation Statistics"));
+
+    mProfileCheckBox = new QCheckBox(tr("Profile simulation"), this);
+    mProfileCheckBox->setChecked(mCoreLogic.IsProfilingEnabled());
+
+    auto clearButton = new QPushButton(tr("Clear"), this);
+    auto saveButton = new QPushButton(tr("Save JSON..."), this);
+
+    auto buttonLayout = new QHBoxLayout();
+    buttonLayout->addWidget(mProfileCheckBox);
+    buttonLayout->addStretch();
+    buttonLayout->addWidget(clearButton);
+    buttonLayout->addWidget(saveButton);
+
+    const auto metricCount = static_cast<int32_t>(SimulationProfiler::Metric::COUNT);
+    mTable = new QTableWidget(metricCount, COLUMN_TITLES.size(), this);
+    mTable->setHorizontalHeaderLabels(COLUMN_TITLES);
+    mTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    mTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+
+    mHistogramSelector = new QComboBox(this);
+
+    for (int32_t metric = 0; metric < metricCount; metric++)
+    {
+        const QString name = SimulationProfiler::GetMetricName(static_cast<SimulationProfiler::Metric>(metric));
+        mTable->setVerticalHeaderItem(metric, new QTableWidgetItem(name));
+        mHistogramSelector->addItem(name);
+
+        for (int32_t column = 0; column < COLUMN_TITLES.size(); column++)
+        {
+            auto item = new QTableWidgetItem();
+            item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+            mTable->setItem(metric, column, item);
+        }
+    }
+
+    mHistogramView = new ProfileHistogramView(this);
+
+    auto layout = new QVBoxLayout(this);
+    layout->addLayout(buttonLayout);
+    layout->addWidget(mTable);
+    layout->addWidget(mHistogramSelector);
+    layout->addWidget(mHistogramView);
+
+    QObject::connect(mProfileCheckBox, &QCheckBox::toggled, &mCoreLogic, &CoreLogic::SetProfilingEnabled);
+    QObject::connect(clearButton, &QPushButton::clicked, this, [&]()
+    {
+        mCoreLogic.ClearProfile();
+        OnUpdateTimeout();
+    });
+    QObject::connect(saveButton, &QPushButton::clicked, this, &StatisticsDialog::OnSaveClicked);
+    QObject::connect(mHistogramSelector, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &StatisticsDialog::UpdateView);
+    QObject::connect(&mUpdateTimer, &QTimer::timeout, this, &StatisticsDialog::OnUpdateTimeout);
+}
+
+void StatisticsDialog::showEvent(QShowEvent *pEvent)
+{
+    QDialog::showEvent(pEvent);
+
+    mProfileCheckBox->setChecked(mCoreLogic.IsProfilingEnabled());
+    OnUpdateTimeout();
+    mUpdateTimer.start(gui::STATISTICS_UPDATE_INTERVAL);
+}
+
+void StatisticsDialog::hideEvent(QHideEvent *pEvent)
+{
+    mUpdateTimer.stop();
+    QDialog::hideEvent(pEvent);
+}
+
+void StatisticsDialog::OnUpdateTimeout()
+{
+    mProfile = mCoreLogic.GetProfile();
+    UpdateView();
+}
+
+void StatisticsDialog::OnSaveClicked()
+{
+    mProfile = mCoreLogic.GetProfile();
+    UpdateView();
+
+    const auto path = QFileDialog::getSaveFileName(this, tr(gui::SAVE_STATISTICS_DIALOG_TITLE), QString(), tr("JSON Files (*.json)"));
+    if (path.isEmpty())
+    {
+        return;
+    }
+
+    std::ostringstream json;
+    mProfile.WriteJson(json);
+    const auto data = json.str();
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) || file.write(data.data(), data.size()) != static_cast<qint64>(data.size()))
+    {
+        QMessageBox::critical(this, windowTitle(), tr("The statistics could not be saved."));
+    }
+}
+
+void StatisticsDialog::UpdateView()
+{
+    for (int32_t metric = 0; metric < mTable->rowCount(); metric++)
+    {
+        const auto& histogram = mProfile.GetHistogram(static_cast<SimulationProfiler::Metric>(metric));
+        const double mean = (histogram.sampleCount > 0 ? static_cast<double>(histogram.sum) / histogram.sampleCount : 0);
+
+        mTable->item(metric, 0)->setText(QString::number(histogram.sampleCount));
+        mTable->item(metric, 1)->setText(QString::number(mean, 'f', 1));
+        mTable->item(metric, 2)->setText(QString::number(histogram.GetPercentile(50)));
+        mTable->item(metric, 3)->setText(QString::number(histogram.GetPercentile(99)));
+        mTable->item(metric, 4)->setText(QString::number(histogram.max));
+    }
+
+    const auto selected = std::max(mHistogramSelector->currentIndex(), 0);
+    mHistogramView->SetHistogram(mProfile.GetHistogram(static_cast<SimulationProfiler::Metric>(selected)));
+}
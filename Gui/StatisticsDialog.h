@@ -0,0 +1,85 @@
+#ifndef STATISTICSDIALOG_H
+#define STATISTICSDIALOG_H
+
+#include "Simulation/SimulationProfiler.h"
+
+#include <QDialog>
+#include <QTimer>
+#include <QWidget>
+
+class CoreLogic;
+
+QT_BEGIN_NAMESPACE
+class QCheckBox;
+class QComboBox;
+class QTableWidget;
+QT_END_NAMESPACE
+
+///
+/// \brief The ProfileHistogramView class paints the buckets of one profile histogram as bars
+///
+class ProfileHistogramView : public QWidget
+{
+    Q_OBJECT
+public:
+    /// \brief Constructor for ProfileHistogramView
+    /// \param pParent: Pointer to the parent widget
+    explicit ProfileHistogramView(QWidget *pParent = nullptr);
+
+    /// \brief Replaces the displayed histogram
+    /// \param pHistogram: The histogram
+    void SetHistogram(const ProfileHistogram &pHistogram);
+
+protected:
+    /// \brief Paints one bar per bucket between the lowest and highest used bucket
+    /// \param pEvent: The paint event
+    void paintEvent(QPaintEvent *pEvent) override;
+
+protected:
+    ProfileHistogram mHistogram;
+};
+
+///
+/// \brief The StatisticsDialog class shows the simulation profile and lets the user save it as JSON
+///
+class StatisticsDialog : public QDialog
+{
+    Q_OBJECT
+public:
+    /// \brief Constructor for the statistics dialog
+    /// \param pCoreLogic: Reference to the core logic
+    /// \param pParent: Pointer to the parent widget
+    StatisticsDialog(CoreLogic &pCoreLogic, QWidget *pParent = nullptr);
+
+protected:
+    /// \brief Starts refreshing the statistics periodically
+    /// \param pEvent: The show event
+    void showEvent(QShowEvent *pEvent) override;
+
+    /// \brief Stops refreshing the statistics
+    /// \param pEvent: The hide event
+    void hideEvent(QHideEvent *pEvent) override;
+
+protected slots:
+    /// \brief Fetches the latest profile and updates the table and histogram; invoked by mUpdateTimer
+    void OnUpdateTimeout(void);
+
+    /// \brief Asks for a file name and saves the latest profile as JSON
+    void OnSaveClicked(void);
+
+protected:
+    /// \brief Updates the table and histogram from mProfile
+    void UpdateView(void);
+
+protected:
+    CoreLogic &mCoreLogic;
+    SimulationProfiler mProfile;
+    QTimer mUpdateTimer;
+
+    QCheckBox *mProfileCheckBox;
+    QTableWidget *mTable;
+    QComboBox *mHistogramSelector;
+    ProfileHistogramView *mHistogramView;
+};
+
+#endif // STATISTICSDIALOG_H
@@ -0,0 +1,100 @@
+#include "WaveformStrip.h"
+#include "Configuration.h"
+
+#include <QPainter>
+#include <algorithm>
+
+namespace
+{
+constexpr int32_t ROW_HEIGHT = 20;
+constexpr int32_t NAME_COLUMN_WIDTH = 120;
+constexpr int32_t LEVEL_MARGIN = 4; // Vertical distance of the high and low level from the row border
+constexpr uint32_t MAX_ROW_COUNT = 16;
+const QColor NAME_COLOR(200, 200, 200);
+const QColor SEPARATOR_COLOR(0, 60, 66);
+}
+
+WaveformStrip::WaveformStrip(QWidget *pParent):
+    QWidget(pParent),
+    mFromTick(0),
+    mToTick(0)
+{
+    Clear();
+}
+
+void WaveformStrip::SetWaveform(uint64_t pFromTick, uint64_t pToTick, std::vector<QString> pNames, std::vector<WaveformTrace> pTraces)
+{
+    Q_ASSERT(pNames.size() == pTraces.size());
+
+    mFromTick = pFromTick;
+    mToTick = pToTick;
+    mNames = std::move(pNames);
+    mTraces = std::move(pTraces);
+
+    const uint32_t rowCount = std::min<uint32_t>(std::max<uint32_t>(mTraces.size(), 1), MAX_ROW_COUNT);
+    setFixedHeight(rowCount * ROW_HEIGHT);
+    update();
+}
+
+void WaveformStrip::Clear()
+{
+    SetWaveform(0, 0, std::vector<QString>(), std::vector<WaveformTrace>());
+}
+
+void WaveformStrip::paintEvent(QPaintEvent *pEvent)
+{
+    Q_UNUSED(pEvent);
+
+    QPainter painter(this);
+    painter.fillRect(rect(), canvas::BACKGROUND_COLOR);
+
+    if (mTraces.empty())
+    {
+        painter.setPen(NAME_COLOR);
+        painter.drawText(rect(), Qt::AlignCenter, tr("No outputs to show"));
+        return;
+    }
+
+    for (uint32_t row = 0; row < std::min<uint32_t>(mTraces.size(), MAX_ROW_COUNT); row++)
+    {
+        const QRect nameRect(0, row * ROW_HEIGHT, NAME_COLUMN_WIDTH, ROW_HEIGHT);
+        const QRect traceRect(NAME_COLUMN_WIDTH, row * ROW_HEIGHT, width() - NAME_COLUMN_WIDTH, ROW_HEIGHT);
+
+        painter.setPen(SEPARATOR_COLOR);
+        painter.drawLine(0, nameRect.bottom(), width(), nameRect.bottom());
+
+        painter.setPen(NAME_COLOR);
+        painter.drawText(nameRect.adjusted(LEVEL_MARGIN, 0, -LEVEL_MARGIN, 0), Qt::AlignVCenter | Qt::AlignLeft, mNames[row]);
+
+        PaintTrace(painter, mTraces[row], traceRect);
+    }
+}
+
+void WaveformStrip::PaintTrace(QPainter &pPainter, const WaveformTrace &pTrace, const QRect &pRow) const
+{
+    const auto ticks = std::max<uint64_t>(mToTick - mFromTick, 1);
+    const auto toX = [&](uint64_t pTick)
+    {
+        return pRow.left() + static_cast<int32_t>((std::min(pTick, mToTick) - mFromTick) * pRow.width() / ticks);
+    };
+
+    const int32_t highY = pRow.top() + LEVEL_MARGIN;
+    const int32_t lowY = pRow.bottom() - LEVEL_MARGIN;
+
+    bool value = pTrace.startValue;
+    int32_t x = pRow.left();
+
+    pPainter.setPen(components::HIGH_COLOR);
+
+    for (const auto& transition : pTrace.transitions)
+    {
+        const auto transitionX = toX(transition);
+        pPainter.drawLine(x, value ? highY : lowY, transitionX, value ? highY : lowY);
+        pPainter.drawLine(transitionX, highY, transitionX, lowY);
+
+        x = transitionX;
+        value = !value;
+    }
+
+    pPainter.drawLine(x, value ? highY : lowY, pRow.right(), value ? highY : lowY);
+}
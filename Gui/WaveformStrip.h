@@ -0,0 +1,49 @@
+#ifndef WAVEFORMSTRIP_H
+#define WAVEFORMSTRIP_H
+
+#include "Simulation/WaveformRecorder.h"
+
+#include <QWidget>
+#include <QString>
+#include <vector>
+
+///
+/// \brief The WaveformStrip class displays the recorded course of a few signals over the last ticks
+///
+class WaveformStrip : public QWidget
+{
+    Q_OBJECT
+public:
+    /// \brief Constructor for WaveformStrip
+    /// \param pParent: Pointer to the parent widget
+    explicit WaveformStrip(QWidget *pParent = nullptr);
+
+    /// \brief Replaces the displayed waveform
+    /// \param pFromTick: The first tick of the displayed window
+    /// \param pToTick: The last tick of the displayed window
+    /// \param pNames: The names of the signals
+    /// \param pTraces: The traces of the signals, one per name
+    void SetWaveform(uint64_t pFromTick, uint64_t pToTick, std::vector<QString> pNames, std::vector<WaveformTrace> pTraces);
+
+    /// \brief Removes all displayed signals
+    void Clear(void);
+
+protected:
+    /// \brief Paints the signal names and traces
+    /// \param pEvent: The paint event
+    void paintEvent(QPaintEvent *pEvent) override;
+
+    /// \brief Paints the trace of one signal
+    /// \param pPainter: The painter to use
+    /// \param pTrace: The trace to paint
+    /// \param pRow: The row rectangle, excluding the name column
+    void PaintTrace(QPainter &pPainter, const WaveformTrace &pTrace, const QRect &pRow) const;
+
+protected:
+    uint64_t mFromTick;
+    uint64_t mToTick;
+    std::vector<QString> mNames;
+    std::vector<WaveformTrace> mTraces;
+};
+
+#endif // WAVEFORMSTRIP_H
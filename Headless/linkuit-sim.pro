@@ -0,0 +1,47 @@
+# Headless command line simulator, runs circuit files without widgets or a graphics scene
+QT = core gui
+
+CONFIG += c++14 console
+CONFIG -= app_bundle
+
+TARGET = linkuit-sim
+
+FULL_VERSION = "$$cat($${OUT_PWD}/version.txt)"
+DEFINES += FULL_VERSION='\\"$$FULL_VERSION\\"'
+
+VERSION = "$$FULL_VERSION"
+
+INCLUDEPATH += $${PWD}/..
+
+HEADERS += \
+    $${PWD}/../CircuitFileFormat.h \
+    $${PWD}/../Simulation/BatchSimulationEngine.h \
+    $${PWD}/../Simulation/CircuitGeometry.h \
+    $${PWD}/../Simulation/CircuitGeometryReader.h \
+    $${PWD}/../Simulation/CompiledNetlist.h \
+    $${PWD}/../Simulation/ConnectivityModel.h \
+    $${PWD}/../Simulation/GridIndex.h \
+    $${PWD}/../Simulation/Netlist.h \
+    $${PWD}/../Simulation/NetlistExtractor.h \
+    $${PWD}/../Simulation/SimulationEngine.h \
+    $${PWD}/../Simulation/SimulationProfiler.h \
+    $${PWD}/../Simulation/SimulationSnapshot.h \
+    $${PWD}/../Simulation/Testbench.h \
+    $${PWD}/../Simulation/TimingWheel.h \
+    $${PWD}/../Simulation/WaveformRecorder.h
+
+SOURCES += \
+    $${PWD}/main.cpp \
+    $${PWD}/../CircuitFileFormat.cpp \
+    $${PWD}/../Simulation/BatchSimulationEngine.cpp \
+    $${PWD}/../Simulation/CircuitGeometryReader.cpp \
+    $${PWD}/../Simulation/CompiledNetlist.cpp \
+    $${PWD}/../Simulation/ConnectivityModel.cpp \
+    $${PWD}/../Simulation/GridIndex.cpp \
+    $${PWD}/../Simulation/NetlistExtractor.cpp \
+    $${PWD}/../Simulation/SimulationEngine.cpp \
+    $${PWD}/../Simulation/SimulationProfiler.cpp \
+    $${PWD}/../Simulation/SimulationSnapshot.cpp \
+    $${PWD}/../Simulation/Testbench.cpp \
+    $${PWD}/../Simulation/TimingWheel.cpp \
+    $${PWD}/../Simulation/WaveformRecorder.cpp
@@ -0,0 +1,601 @@
+#include "CircuitFileFormat.h"
+#include "Configuration.h"
+#include "Simulation/BatchSimulationEngine.h"
+#include "Simulation/CircuitGeometryReader.h"
+#include "Simulation/NetlistExtractor.h"
+#include "Simulation/SimulationEngine.h"
+#include "Simulation/SimulationProfiler.h"
+#include "Simulation/Testbench.h"
+#include "Simulation/WaveformRecorder.h"
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QTextStream>
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <sstream>
+
+namespace
+{
+constexpr int32_t MAX_LABEL_DISTANCE = 3 * canvas::GRID_SIZE; // Text labels name the closest input or output within this distance
+constexpr int MISMATCH_EXIT_CODE = 2;
+constexpr uint32_t MAX_EXHAUSTIVE_INPUTS = 20; // --exhaustive prints one line per input vector
+
+/// \brief Getter for the signal name prefix of the inputs and outputs of a circuit
+/// \param pKernel: The kernel of the component
+/// \return The prefix or nullptr, if the component is no in- or output
+const char* GetSignalPrefix(CellKernel pKernel)
+{
+    switch (pKernel)
+    {
+        case CellKernel::INPUT:
+        {
+            return "input";
+        }
+        case CellKernel::BUTTON:
+        {
+            return "button";
+        }
+        case CellKernel::CLOCK:
+        {
+            return "clock";
+        }
+        case CellKernel::OUTPUT:
+        {
+            return "output";
+        }
+        default:
+        {
+            return nullptr;
+        }
+    }
+}
+
+/// \brief Builds the name of a recorded signal from a prefix and the grid position of its item, as the GUI does
+/// \param pPrefix: The name prefix
+/// \param pPos: The scene position
+/// \return The signal name
+std::string GetSignalName(const char* pPrefix, GridPoint pPos)
+{
+    return std::string(pPrefix) + '_' + std::to_string(pPos.x / canvas::GRID_SIZE) + '_' + std::to_string(pPos.y / canvas::GRID_SIZE);
+}
+
+/// \brief Names every in- and output after the closest text label within MAX_LABEL_DISTANCE
+/// Whitespace and commas in label texts are replaced with underscores
+/// \param pGeometry: The circuit geometry
+/// \param pTextLabels: The text labels of the circuit
+/// \return The label name of every component, empty for unlabeled components
+std::vector<std::string> GetLabelNames(const CircuitGeometry& pGeometry, const std::vector<TextLabelGeometry>& pTextLabels)
+{
+    std::vector<std::string> names(pGeometry.components.size());
+    std::vector<int32_t> distances(pGeometry.components.size(), MAX_LABEL_DISTANCE + 1);
+
+    for (const auto& label : pTextLabels)
+    {
+        if (label.text.empty())
+        {
+            continue;
+        }
+
+        uint32_t closestComponent = pGeometry.components.size();
+        int32_t closestDistance = MAX_LABEL_DISTANCE + 1;
+
+        for (uint32_t component = 0; component < pGeometry.components.size(); component++)
+        {
+            const auto& pos = pGeometry.components[component].pos;
+            const auto distance = std::max(std::abs(pos.x - label.pos.x), std::abs(pos.y - label.pos.y));
+
+            if (GetSignalPrefix(pGeometry.components[component].cell.kernel) != nullptr && distance < closestDistance)
+            {
+                closestComponent = component;
+                closestDistance = distance;
+            }
+        }
+
+        if (closestComponent < pGeometry.components.size() && closestDistance < distances[closestComponent])
+        {
+            auto name = label.text;
+            std::replace_if(name.begin(), name.end(), [](char pChar) { return std::isspace(static_cast<unsigned char>(pChar)) || pChar == ','; }, '_');
+
+            names[closestComponent] = name;
+            distances[closestComponent] = closestDistance;
+        }
+    }
+
+    return names;
+}
+
+/// \brief Getter for the scene position of a component as JSON object
+/// \param pPos: The scene position
+/// \return The JSON object
+QJsonObject ToJson(GridPoint pPos)
+{
+    QJsonObject position;
+    position["x"] = pPos.x;
+    position["y"] = pPos.y;
+    return position;
+}
+
+/// \brief Simulates every combination of input states for pTicks ticks and prints the output states of each
+/// Bit n of the input vector number is the state of the nth input in file order. Every vector starts from the reset
+/// state and 64 vectors are simulated at once, one per lane of a BatchSimulationEngine.
+/// \param pGeometry: The circuit geometry
+/// \param pExtractor: The extractor holding the netlist of the circuit
+/// \param pTicks: The number of ticks to simulate per vector
+/// \param pIsJson: True, to print JSON
+/// \param pOut: The stream to print to
+void RunExhaustive(const CircuitGeometry& pGeometry, const NetlistExtractor& pExtractor, uint64_t pTicks, bool pIsJson, QTextStream& pOut)
+{
+    std::vector<uint32_t> inputCells;
+    std::vector<uint32_t> outputCells;
+    QJsonArray inputs;
+    QJsonArray outputs;
+
+    for (uint32_t component = 0; component < pGeometry.components.size(); component++)
+    {
+        const auto kernel = pGeometry.components[component].cell.kernel;
+
+        if (kernel == CellKernel::INPUT)
+        {
+            inputCells.push_back(pExtractor.GetComponentCell(component));
+            inputs.append(ToJson(pGeometry.components[component].pos));
+        }
+        else if (kernel == CellKernel::OUTPUT)
+        {
+            outputCells.push_back(pExtractor.GetComponentCell(component));
+            outputs.append(ToJson(pGeometry.components[component].pos));
+        }
+    }
+
+    Q_ASSERT(inputCells.size() <= MAX_EXHAUSTIVE_INPUTS);
+
+    BatchSimulationEngine engine;
+    engine.Compile(pExtractor.GetNetlist());
+
+    const uint64_t vectorCount = static_cast<uint64_t>(1) << inputCells.size();
+    QJsonArray vectors;
+
+    for (uint64_t batch = 0; batch * BatchSimulationEngine::LANE_COUNT < vectorCount; batch++)
+    {
+        engine.Reset();
+
+        for (uint32_t input = 0; input < inputCells.size(); input++)
+        {
+            engine.SetInputLanes(inputCells[input], BatchSimulationEngine::GetExhaustiveLanes(input, batch));
+        }
+
+        for (uint64_t tick = 0; tick < pTicks; tick++)
+        {
+            engine.Tick();
+        }
+
+        const auto laneCount = std::min<uint64_t>(vectorCount - batch * BatchSimulationEngine::LANE_COUNT, BatchSimulationEngine::LANE_COUNT);
+
+        for (uint32_t lane = 0; lane < laneCount; lane++)
+        {
+            QString inputStates;
+            QString outputStates;
+
+            for (const auto& cell : inputCells)
+            {
+                inputStates += (((engine.GetOutputLanes(cell, 0) >> lane) & 1) != 0 ? '1' : '0');
+            }
+
+            for (const auto& cell : outputCells)
+            {
+                outputStates += (((engine.GetInputLanes(cell, 0) >> lane) & 1) != 0 ? '1' : '0');
+            }
+
+            if (pIsJson)
+            {
+                QJsonObject vector;
+                vector["inputs"] = inputStates;
+                vector["outputs"] = outputStates;
+                vectors.append(vector);
+            }
+            else
+            {
+                pOut << inputStates << " " << outputStates << "\n";
+            }
+        }
+    }
+
+    if (pIsJson)
+    {
+        QJsonObject result;
+        result["ticks"] = static_cast<qint64>(pTicks);
+        result["inputs"] = inputs;
+        result["outputs"] = outputs;
+        result["vectors"] = vectors;
+        pOut << QJsonDocument(result).toJson(QJsonDocument::Indented);
+    }
+}
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("linkuit-sim");
+    QCoreApplication::setApplicationVersion(QString(FULL_VERSION));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Runs a Linkuit Studio circuit without GUI and prints the states of its outputs");
+    parser.addHelpOption();
+    parser.addVersionOption();
+    parser.addPositionalArgument("file", QCoreApplication::translate("file", "Circuit file to simulate."));
+
+    const QCommandLineOption ticksOption(QStringList() << "t" << "ticks", "Number of ticks to simulate.", "ticks", "0");
+    const QCommandLineOption jsonOption(QStringList() << "j" << "json", "Print the output states as JSON.");
+    const QCommandLineOption vcdOption(QStringList() << "vcd",
+                                       QString("Write the waveform of all nets, inputs and outputs during --ticks or --testbench to a VCD file, "
+                                               "one time unit per tick. Only the last %1 value changes are kept.").arg(simulation::WAVEFORM_CAPACITY),
+                                       "file");
+    const QCommandLineOption testbenchOption(QStringList() << "b" << "testbench",
+                                             "Drive the circuit with a stimulus file instead of --ticks and report all mismatches, exits with 2 "
+                                             "on mismatches. The header names the columns: \"ticks\", inputs to drive and =outputs to check. "
+                                             "Each row holds a tick count or ^signal to run until its rising edge, then 0, 1 or - per column. "
+                                             "Signals are named like input_X_Y or by nearby text labels.", "file");
+    const QCommandLineOption profileOption(QStringList() << "profile",
+                                           "Measure every tick of --ticks without skipping idle ticks and write histograms of the tick duration, "
+                                           "evaluated cells and input events per tick as JSON. --testbench runs are not profiled.", "file");
+    const QCommandLineOption settleOption(QStringList() << "settle", "Settle acyclic combinational logic within one tick instead of one tick per gate.");
+    const QCommandLineOption oscillationsOption(QStringList() << "oscillations",
+                                                "How combinational loops that oscillate on their own are handled: report, slow or freeze.",
+                                                "limit", "report");
+    const QCommandLineOption exhaustiveOption(QStringList() << "exhaustive",
+                                              "Simulate every combination of input states for --ticks ticks and print the output states of each, "
+                                              "64 combinations at once.");
+    parser.addOption(ticksOption);
+    parser.addOption(jsonOption);
+    parser.addOption(vcdOption);
+    parser.addOption(testbenchOption);
+    parser.addOption(profileOption);
+    parser.addOption(settleOption);
+    parser.addOption(oscillationsOption);
+    parser.addOption(exhaustiveOption);
+
+    parser.process(app);
+
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    if (parser.positionalArguments().size() != 1)
+    {
+        parser.showHelp(1);
+    }
+
+    bool isTickCountValid = false;
+    const uint64_t tickCount = parser.value(ticksOption).toULongLong(&isTickCountValid);
+
+    if (!isTickCountValid)
+    {
+        err << "Invalid tick count: " << parser.value(ticksOption) << "\n";
+        return 1;
+    }
+
+    OscillationLimit oscillationLimit = OscillationLimit::NONE;
+
+    if (parser.value(oscillationsOption) == "slow")
+    {
+        oscillationLimit = OscillationLimit::SLOW_DOWN;
+    }
+    else if (parser.value(oscillationsOption) == "freeze")
+    {
+        oscillationLimit = OscillationLimit::FREEZE;
+    }
+    else if (parser.value(oscillationsOption) != "report")
+    {
+        err << "Invalid oscillation limit: " << parser.value(oscillationsOption) << "\n";
+        return 1;
+    }
+
+    if (parser.isSet(exhaustiveOption))
+    {
+        if (tickCount == 0)
+        {
+            err << "--exhaustive needs a tick count of at least 1\n";
+            return 1;
+        }
+
+        if (parser.isSet(testbenchOption) || parser.isSet(vcdOption) || parser.isSet(profileOption) || parser.isSet(settleOption)
+                || parser.isSet(oscillationsOption))
+        {
+            err << "--exhaustive can not be combined with --testbench, --vcd, --profile, --settle or --oscillations\n";
+            return 1;
+        }
+    }
+
+    QFile circuitFile(parser.positionalArguments().front());
+
+    if (!circuitFile.open(QIODevice::ReadOnly))
+    {
+        err << "Could not open " << circuitFile.fileName() << "\n";
+        return 1;
+    }
+
+    const auto json = DecodeCircuitFile(circuitFile.readAll());
+    CircuitGeometryReader reader;
+
+    if (!json.has_value() || !reader.ReadJson(json.value()))
+    {
+        err << "Could not read circuit file " << circuitFile.fileName();
+
+        if (!reader.GetError().empty())
+        {
+            err << ", " << QString::fromStdString(reader.GetError());
+        }
+
+        err << "\n";
+        return 1;
+    }
+
+    if (reader.GetSkippedComponentCount() > 0)
+    {
+        err << "Skipped " << reader.GetSkippedComponentCount() << " components unknown by this version\n";
+    }
+
+    const auto& geometry = reader.GetGeometry();
+
+    NetlistExtractor extractor;
+    extractor.Extract(geometry);
+
+    if (parser.isSet(exhaustiveOption))
+    {
+        const uint32_t inputCount = std::count_if(geometry.components.begin(), geometry.components.end(), [](const ComponentGeometry& pComponent)
+        {
+            return (pComponent.cell.kernel == CellKernel::INPUT);
+        });
+
+        if (inputCount > MAX_EXHAUSTIVE_INPUTS)
+        {
+            err << "--exhaustive supports up to " << MAX_EXHAUSTIVE_INPUTS << " inputs, the circuit has " << inputCount << "\n";
+            return 1;
+        }
+
+        RunExhaustive(geometry, extractor, tickCount, parser.isSet(jsonOption), out);
+        return 0;
+    }
+
+    SimulationEngine engine;
+    engine.SetZeroDelaySettle(parser.isSet(settleOption));
+    engine.SetOscillationLimit(oscillationLimit);
+    engine.Compile(extractor.GetNetlist());
+    engine.Reset();
+
+    WaveformRecorder recorder(simulation::WAVEFORM_CAPACITY);
+
+    if (parser.isSet(vcdOption))
+    {
+        std::vector<WaveformSignal> recordedSignals;
+
+        for (uint32_t component = 0; component < geometry.components.size(); component++)
+        {
+            const auto kernel = geometry.components[component].cell.kernel;
+            const auto prefix = GetSignalPrefix(kernel);
+
+            if (prefix != nullptr)
+            {
+                const auto name = GetSignalName(prefix, geometry.components[component].pos);
+                recordedSignals.push_back(WaveformSignal{extractor.GetComponentCell(component), 0, kernel == CellKernel::OUTPUT, name});
+            }
+        }
+
+        std::vector<bool> isNetRecorded(engine.GetCellCount(), false);
+        for (uint32_t wire = 0; wire < geometry.wires.size(); wire++)
+        {
+            const auto cell = extractor.GetWireCell(wire);
+
+            if (!isNetRecorded[cell])
+            {
+                isNetRecorded[cell] = true;
+                recordedSignals.push_back(WaveformSignal{cell, 0, false, GetSignalName("net", geometry.wires[wire].pos)});
+            }
+        }
+
+        recorder.SetSignals(engine, std::move(recordedSignals), 0);
+    }
+
+    Testbench testbench;
+    SimulationProfiler profiler;
+    uint64_t simulatedTicks = tickCount;
+
+    if (parser.isSet(testbenchOption))
+    {
+        // Every in- and output is accessible by its position name and by its label
+        const auto labelNames = GetLabelNames(geometry, reader.GetTextLabels());
+
+        for (uint32_t component = 0; component < geometry.components.size(); component++)
+        {
+            const auto kernel = geometry.components[component].cell.kernel;
+            const auto prefix = GetSignalPrefix(kernel);
+            const auto cell = extractor.GetComponentCell(component);
+
+            if (prefix == nullptr)
+            {
+                continue;
+            }
+
+            testbench.AddSignal(GetSignalName(prefix, geometry.components[component].pos), cell, kernel);
+
+            if (!labelNames[component].empty() && !testbench.AddSignal(labelNames[component], cell, kernel))
+            {
+                err << "Label \"" << QString::fromStdString(labelNames[component]) << "\" names more than one component, only the first is used\n";
+            }
+        }
+
+        QFile stimulusFile(parser.value(testbenchOption));
+
+        if (!stimulusFile.open(QIODevice::ReadOnly))
+        {
+            err << "Could not open " << stimulusFile.fileName() << "\n";
+            return 1;
+        }
+
+        std::istringstream stimulus(stimulusFile.readAll().toStdString());
+
+        if (!testbench.Load(stimulus))
+        {
+            err << stimulusFile.fileName() << ", " << QString::fromStdString(testbench.GetError()) << "\n";
+            return 1;
+        }
+
+        const bool isRunComplete = testbench.Run(engine, [&recorder, &engine](uint64_t pTickCount)
+        {
+            recorder.Sample(engine, pTickCount);
+        });
+
+        if (!isRunComplete)
+        {
+            err << stimulusFile.fileName() << ", " << QString::fromStdString(testbench.GetError()) << "\n";
+            return 1;
+        }
+
+        simulatedTicks = testbench.GetTickCount();
+    }
+    else
+    {
+        const bool isProfiling = parser.isSet(profileOption);
+
+        for (uint64_t tick = 0; tick < tickCount; tick++)
+        {
+            if (!isProfiling)
+            {
+                // Jump over ticks in which no state can change, the profiler measures every single tick instead
+                const uint64_t idleTicks = std::min(engine.GetIdleTicks(), tickCount - tick - 1);
+
+                if (idleTicks > 0)
+                {
+                    engine.SkipIdleTicks(idleTicks);
+                    tick += idleTicks;
+                }
+            }
+
+            if (isProfiling)
+            {
+                profiler.BeginTick(engine);
+            }
+
+            engine.Tick();
+            recorder.Sample(engine, tick + 1);
+
+            if (isProfiling)
+            {
+                profiler.EndTick(engine);
+            }
+        }
+    }
+
+    if (parser.isSet(profileOption))
+    {
+        std::ostringstream profile;
+        profiler.WriteJson(profile);
+
+        QFile profileFile(parser.value(profileOption));
+        const auto data = profile.str();
+
+        if (!profileFile.open(QIODevice::WriteOnly | QIODevice::Truncate) || profileFile.write(data.data(), data.size()) != static_cast<qint64>(data.size()))
+        {
+            err << "Could not write " << profileFile.fileName() << "\n";
+            return 1;
+        }
+    }
+
+    if (parser.isSet(vcdOption))
+    {
+        std::ostringstream vcd;
+        recorder.WriteVcd(vcd, simulatedTicks);
+
+        QFile vcdFile(parser.value(vcdOption));
+        const auto data = vcd.str();
+
+        if (!vcdFile.open(QIODevice::WriteOnly | QIODevice::Truncate) || vcdFile.write(data.data(), data.size()) != static_cast<qint64>(data.size()))
+        {
+            err << "Could not write " << vcdFile.fileName() << "\n";
+            return 1;
+        }
+    }
+
+    if (engine.GetOscillatingLoopCount() > 0)
+    {
+        err << engine.GetOscillatingLoopCount() << " of " << engine.GetLoopCount() << " combinational loops oscillate\n";
+    }
+
+    if (parser.isSet(testbenchOption))
+    {
+        if (parser.isSet(jsonOption))
+        {
+            QJsonArray mismatches;
+
+            for (const auto& mismatch : testbench.GetMismatches())
+            {
+                QJsonObject entry;
+                entry["line"] = static_cast<qint64>(mismatch.line);
+                entry["tick"] = static_cast<qint64>(mismatch.tick);
+                entry["signal"] = QString::fromStdString(mismatch.signal);
+                entry["expected"] = (mismatch.expected ? 1 : 0);
+                mismatches.append(entry);
+            }
+
+            QJsonObject result;
+            result["ticks"] = static_cast<qint64>(simulatedTicks);
+            result["checks"] = static_cast<qint64>(testbench.GetCheckCount());
+            result["mismatches"] = mismatches;
+            result["oscillatingLoops"] = static_cast<qint64>(engine.GetOscillatingLoopCount());
+            out << QJsonDocument(result).toJson(QJsonDocument::Indented);
+        }
+        else
+        {
+            for (const auto& mismatch : testbench.GetMismatches())
+            {
+                out << "line " << mismatch.line << ", tick " << mismatch.tick << ": " << QString::fromStdString(mismatch.signal)
+                    << " is " << (mismatch.expected ? 0 : 1) << ", expected " << (mismatch.expected ? 1 : 0) << "\n";
+            }
+
+            out << testbench.GetCheckCount() << " checks, " << testbench.GetMismatches().size() << " mismatches, " << simulatedTicks << " ticks\n";
+        }
+
+        return (testbench.GetMismatches().empty() ? 0 : MISMATCH_EXIT_CODE);
+    }
+
+    // Outputs are listed in file order with their scene position, which identifies them across runs
+    QJsonArray outputs;
+
+    for (uint32_t component = 0; component < geometry.components.size(); component++)
+    {
+        if (geometry.components[component].cell.kernel != CellKernel::OUTPUT)
+        {
+            continue;
+        }
+
+        const auto& pos = geometry.components[component].pos;
+        const bool state = engine.GetInputState(extractor.GetComponentCell(component), 0);
+
+        if (parser.isSet(jsonOption))
+        {
+            QJsonObject output;
+            output["x"] = pos.x;
+            output["y"] = pos.y;
+            output["state"] = (state ? 1 : 0);
+            outputs.append(output);
+        }
+        else
+        {
+            out << pos.x << " " << pos.y << " " << (state ? 1 : 0) << "\n";
+        }
+    }
+
+    if (parser.isSet(jsonOption))
+    {
+        QJsonObject result;
+        result["ticks"] = static_cast<qint64>(tickCount);
+        result["outputs"] = outputs;
+        result["oscillatingLoops"] = static_cast<qint64>(engine.GetOscillatingLoopCount());
+        out << QJsonDocument(result).toJson(QJsonDocument::Indented);
+    }
+
+    return 0;
+}
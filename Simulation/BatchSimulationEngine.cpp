@@ -0,0 +1,625 @@
+#include "BatchSimulationEngine.h"
+
+#include <QtGlobal>
+#include <algorithm>
+
+namespace
+{
+constexpr uint64_t ALL_LANES = ~static_cast<uint64_t>(0);
+
+// Lane patterns of the six least significant input vector bits
+constexpr uint64_t EXHAUSTIVE_PATTERNS[6] = {0xAAAAAAAAAAAAAAAAull, 0xCCCCCCCCCCCCCCCCull, 0xF0F0F0F0F0F0F0F0ull,
+                                             0xFF00FF00FF00FF00ull, 0xFFFF0000FFFF0000ull, 0xFFFFFFFF00000000ull};
+}
+
+BatchSimulationEngine::BatchSimulationEngine()
+{}
+
+void BatchSimulationEngine::Compile(const Netlist& pNetlist)
+{
+    Clear();
+    CompileNetlist(pNetlist, mNetlist);
+
+    const uint32_t cellCount = mNetlist.kernels.size();
+
+    mInputStates.resize(mNetlist.inputResetStates.size(), 0);
+    mPrevInputStates.resize(mNetlist.inputResetStates.size(), 0);
+    mOutputStates.resize(mNetlist.outputOffsets.back(), 0);
+
+    // Every cell gets one pending lane mask per tick of its propagation delay
+    mPendingOffsets.reserve(cellCount + 1);
+    mPendingOffsets.push_back(0);
+    for (const auto& parameters : mNetlist.parameters)
+    {
+        mPendingOffsets.push_back(mPendingOffsets.back() + parameters.delay);
+    }
+    mPendingLanes.resize(mPendingOffsets.back(), 0);
+    mIsScheduled.resize(cellCount, 0);
+    mInternalStates.resize(cellCount, 0);
+    mTickCountdowns.resize(cellCount, 0);
+    mPulseCountdowns.resize(cellCount, 0);
+    mStateChanged.resize(cellCount, 0);
+}
+
+void BatchSimulationEngine::Clear()
+{
+    mNetlist = CompiledNetlist();
+    mInputStates.clear();
+    mPrevInputStates.clear();
+    mOutputStates.clear();
+    mPendingOffsets.clear();
+    mPendingLanes.clear();
+    mScheduledCells.clear();
+    mCurrentCells.clear();
+    mIsScheduled.clear();
+    mInternalStates.clear();
+    mTickCountdowns.clear();
+    mPulseCountdowns.clear();
+    mStateChanged.clear();
+    mChangedCells.clear();
+}
+
+void BatchSimulationEngine::Reset()
+{
+    for (uint32_t i = 0; i < mInputStates.size(); i++)
+    {
+        mInputStates[i] = (mNetlist.inputResetStates[i] != 0) ? ALL_LANES : 0;
+    }
+
+    std::fill(mPrevInputStates.begin(), mPrevInputStates.end(), 0);
+    std::fill(mOutputStates.begin(), mOutputStates.end(), 0);
+    std::fill(mPendingLanes.begin(), mPendingLanes.end(), 0);
+    std::fill(mIsScheduled.begin(), mIsScheduled.end(), 0);
+    std::fill(mInternalStates.begin(), mInternalStates.end(), 0);
+    std::fill(mStateChanged.begin(), mStateChanged.end(), 0);
+    mScheduledCells.clear();
+    mChangedCells.clear();
+
+    for (uint32_t cell = 0; cell < mNetlist.kernels.size(); cell++)
+    {
+        switch (mNetlist.kernels[cell])
+        {
+            case CellKernel::WIRE:
+            case CellKernel::DIODE:
+            case CellKernel::OUTPUT:
+            case CellKernel::INPUT:
+            case CellKernel::BUTTON:
+            {
+                break;
+            }
+            case CellKernel::CONSTANT:
+            {
+                mOutputStates[mNetlist.outputOffsets[cell]] = mNetlist.parameters[cell].constantState ? ALL_LANES : 0;
+                MarkStateChanged(cell); // Successors should be notified about wake up
+                break;
+            }
+            case CellKernel::CLOCK:
+            {
+                mTickCountdowns[cell] = mNetlist.parameters[cell].toggleTicks;
+                mPulseCountdowns[cell] = mNetlist.parameters[cell].pulseTicks;
+                MarkStateChanged(cell);
+                break;
+            }
+            case CellKernel::RS_FLIPFLOP:
+            case CellKernel::RS_CLOCKED_FLIPFLOP:
+            case CellKernel::RS_MS_FLIPFLOP:
+            case CellKernel::D_FLIPFLOP:
+            case CellKernel::D_MS_FLIPFLOP:
+            case CellKernel::T_FLIPFLOP:
+            case CellKernel::JK_FLIPFLOP:
+            case CellKernel::JK_MS_FLIPFLOP:
+            {
+                mOutputStates[mNetlist.outputOffsets[cell] + 1] = ALL_LANES; // Not Q
+                mPendingLanes[mPendingOffsets[cell]] = ALL_LANES; // Due in the first tick
+                Schedule(cell);
+                MarkStateChanged(cell);
+                break;
+            }
+            default:
+            {
+                mPendingLanes[mPendingOffsets[cell]] = ALL_LANES; // Due in the first tick
+                Schedule(cell);
+                MarkStateChanged(cell);
+                break;
+            }
+        }
+    }
+}
+
+void BatchSimulationEngine::Tick()
+{
+    for (const auto& cell : mNetlist.timedCells)
+    {
+        if (mNetlist.kernels[cell] == CellKernel::CLOCK)
+        {
+            LogicFunction(cell, ALL_LANES); // Clocks are evaluated on every tick
+        }
+    }
+
+    mCurrentCells.swap(mScheduledCells);
+    mScheduledCells.clear();
+
+    for (const auto& cell : mCurrentCells)
+    {
+        AdvanceUpdateTime(cell);
+    }
+
+    for (size_t i = 0; i < mChangedCells.size(); i++)
+    {
+        const auto cell = mChangedCells[i];
+        mStateChanged[cell] = 0;
+        NotifySuccessors(cell);
+    }
+
+    mChangedCells.clear();
+}
+
+void BatchSimulationEngine::SetInputLanes(uint32_t pCell, uint64_t pLanes)
+{
+    Q_ASSERT(pCell < mNetlist.kernels.size());
+    Q_ASSERT(mNetlist.kernels[pCell] == CellKernel::INPUT || mNetlist.kernels[pCell] == CellKernel::BUTTON);
+
+    if (mOutputStates[mNetlist.outputOffsets[pCell]] != pLanes)
+    {
+        mOutputStates[mNetlist.outputOffsets[pCell]] = pLanes;
+        NotifySuccessors(pCell);
+    }
+}
+
+uint32_t BatchSimulationEngine::GetCellCount() const
+{
+    return mNetlist.kernels.size();
+}
+
+CellKernel BatchSimulationEngine::GetKernel(uint32_t pCell) const
+{
+    Q_ASSERT(pCell < mNetlist.kernels.size());
+    return mNetlist.kernels[pCell];
+}
+
+uint64_t BatchSimulationEngine::GetInputLanes(uint32_t pCell, uint32_t pInput) const
+{
+    Q_ASSERT(pCell < mNetlist.kernels.size() && mNetlist.inputOffsets[pCell] + pInput < mNetlist.inputOffsets[pCell + 1]);
+    return mInputStates[mNetlist.inputOffsets[pCell] + pInput];
+}
+
+uint64_t BatchSimulationEngine::GetOutputLanes(uint32_t pCell, uint32_t pOutput) const
+{
+    Q_ASSERT(pCell < mNetlist.kernels.size() && mNetlist.outputOffsets[pCell] + pOutput < mNetlist.outputOffsets[pCell + 1]);
+    return mOutputStates[mNetlist.outputOffsets[pCell] + pOutput];
+}
+
+uint64_t BatchSimulationEngine::GetExhaustiveLanes(uint32_t pVariable, uint64_t pBatch)
+{
+    if (pVariable < 6)
+    {
+        return EXHAUSTIVE_PATTERNS[pVariable];
+    }
+
+    return (((pBatch >> (pVariable - 6)) & 1) != 0) ? ALL_LANES : 0;
+}
+
+void BatchSimulationEngine::AdvanceUpdateTime(uint32_t pCell)
+{
+    const uint32_t first = mPendingOffsets[pCell];
+    const uint32_t last = mPendingOffsets[pCell + 1] - 1;
+    const uint64_t now = mPendingLanes[first];
+
+    if (now != 0)
+    {
+        LogicFunction(pCell, now); // Update the due lanes now
+    }
+
+    // The other lanes move one tick closer to their update
+    uint64_t pendingLanes = 0;
+    for (uint32_t i = first; i < last; i++)
+    {
+        mPendingLanes[i] = mPendingLanes[i + 1];
+        pendingLanes |= mPendingLanes[i];
+    }
+    mPendingLanes[last] = 0;
+
+    if (pendingLanes != 0)
+    {
+        mScheduledCells.push_back(pCell);
+    }
+    else
+    {
+        mIsScheduled[pCell] = 0;
+    }
+}
+
+void BatchSimulationEngine::Schedule(uint32_t pCell)
+{
+    if (mIsScheduled[pCell] == 0)
+    {
+        mIsScheduled[pCell] = 1;
+        mScheduledCells.push_back(pCell);
+    }
+}
+
+void BatchSimulationEngine::LogicFunction(uint32_t pCell, uint64_t pLanes)
+{
+    const uint32_t inputOffset = mNetlist.inputOffsets[pCell];
+    const uint32_t inputCount = mNetlist.inputOffsets[pCell + 1] - inputOffset;
+    const uint32_t outputCount = mNetlist.outputOffsets[pCell + 1] - mNetlist.outputOffsets[pCell];
+
+    const uint64_t* inputs = mInputStates.data() + inputOffset;
+    uint64_t* prevInputs = mPrevInputStates.data() + inputOffset;
+    const uint64_t* outputs = mOutputStates.data() + mNetlist.outputOffsets[pCell];
+
+    const uint64_t risingEdge = (inputCount > 1) ? (~prevInputs[1] & inputs[1] & pLanes) : 0;
+    const uint64_t fallingEdge = (inputCount > 1) ? (prevInputs[1] & ~inputs[1] & pLanes) : 0;
+
+    bool changed = false;
+
+    switch (mNetlist.kernels[pCell])
+    {
+        case CellKernel::AND_GATE:
+        {
+            uint64_t state = ALL_LANES;
+            for (uint32_t i = 0; i < inputCount; i++)
+            {
+                state &= inputs[i];
+            }
+            changed |= AssureOutput(pCell, 0, state, pLanes);
+            break;
+        }
+        case CellKernel::OR_GATE:
+        {
+            uint64_t state = 0;
+            for (uint32_t i = 0; i < inputCount; i++)
+            {
+                state |= inputs[i];
+            }
+            changed |= AssureOutput(pCell, 0, state, pLanes);
+            break;
+        }
+        case CellKernel::XOR_GATE:
+        {
+            uint64_t oneHigh = 0;
+            uint64_t moreHigh = 0;
+            for (uint32_t i = 0; i < inputCount; i++)
+            {
+                moreHigh |= oneHigh & inputs[i];
+                oneHigh |= inputs[i];
+            }
+            changed |= AssureOutput(pCell, 0, oneHigh & ~moreHigh, pLanes); // Exactly one input high
+            break;
+        }
+        case CellKernel::BUFFER_GATE:
+        {
+            changed |= AssureOutput(pCell, 0, inputs[0], pLanes);
+            break;
+        }
+        case CellKernel::CLOCK:
+        {
+            const auto& parameters = mNetlist.parameters[pCell];
+
+            mTickCountdowns[pCell]--;
+            mPulseCountdowns[pCell]--;
+
+            if (mTickCountdowns[pCell] == 0)
+            {
+                if (parameters.pulseMode)
+                {
+                    changed |= AssureOutput(pCell, 0, ALL_LANES, ALL_LANES);
+                    mPulseCountdowns[pCell] = parameters.pulseTicks;
+                }
+                else
+                {
+                    changed |= AssureOutput(pCell, 0, ~outputs[0], ALL_LANES);
+                }
+                mTickCountdowns[pCell] = parameters.toggleTicks;
+            }
+            else if (mPulseCountdowns[pCell] == 0)
+            {
+                if (parameters.pulseMode)
+                {
+                    changed |= AssureOutput(pCell, 0, 0, ALL_LANES);
+                }
+                mPulseCountdowns[pCell] = parameters.pulseTicks;
+            }
+            break;
+        }
+        case CellKernel::HALF_ADDER:
+        {
+            changed |= AssureOutput(pCell, 0, inputs[0] ^ inputs[1], pLanes);
+            changed |= AssureOutput(pCell, 1, inputs[0] & inputs[1], pLanes);
+            break;
+        }
+        case CellKernel::FULL_ADDER:
+        {
+            changed |= AssureOutput(pCell, 0, inputs[0] ^ inputs[1] ^ inputs[2], pLanes);
+            changed |= AssureOutput(pCell, 1, (inputs[0] & inputs[1]) | (inputs[0] & inputs[2]) | (inputs[1] & inputs[2]), pLanes);
+            break;
+        }
+        case CellKernel::RS_FLIPFLOP:
+        case CellKernel::RS_CLOCKED_FLIPFLOP:
+        {
+            // R wins over S, the clocked variant only latches on the rising edge
+            const bool clocked = (mNetlist.kernels[pCell] == CellKernel::RS_CLOCKED_FLIPFLOP);
+            const uint64_t set = clocked ? (inputs[0] & risingEdge) : inputs[0];
+            const uint64_t reset = clocked ? (inputs[2] & risingEdge) : inputs[1];
+
+            changed |= AssureOutput(pCell, 0, (outputs[0] | set) & ~reset, pLanes);
+            changed |= AssureOutput(pCell, 1, (outputs[1] & ~set) | reset, pLanes);
+            break;
+        }
+        case CellKernel::RS_MS_FLIPFLOP:
+        {
+            mInternalStates[pCell] = (mInternalStates[pCell] | (inputs[0] & risingEdge)) & ~(inputs[2] & risingEdge);
+
+            changed |= AssureOutput(pCell, 0, mInternalStates[pCell], fallingEdge);
+            changed |= AssureOutput(pCell, 1, ~mInternalStates[pCell], fallingEdge);
+            break;
+        }
+        case CellKernel::D_FLIPFLOP:
+        {
+            changed |= AssureOutput(pCell, 0, prevInputs[0], risingEdge);
+            changed |= AssureOutput(pCell, 1, ~prevInputs[0], risingEdge);
+            break;
+        }
+        case CellKernel::D_MS_FLIPFLOP:
+        {
+            mInternalStates[pCell] = (mInternalStates[pCell] & ~risingEdge) | (inputs[0] & risingEdge);
+
+            changed |= AssureOutput(pCell, 0, mInternalStates[pCell], fallingEdge);
+            changed |= AssureOutput(pCell, 1, ~mInternalStates[pCell], fallingEdge);
+            break;
+        }
+        case CellKernel::T_FLIPFLOP:
+        {
+            const uint64_t toggle = risingEdge & prevInputs[0];
+            const uint64_t state = outputs[0] ^ toggle;
+
+            changed |= AssureOutput(pCell, 0, state, toggle);
+            changed |= AssureOutput(pCell, 1, ~state, toggle);
+            break;
+        }
+        case CellKernel::JK_FLIPFLOP:
+        case CellKernel::JK_MS_FLIPFLOP:
+        {
+            const bool masterSlave = (mNetlist.kernels[pCell] == CellKernel::JK_MS_FLIPFLOP);
+            const uint64_t j = prevInputs[0];
+            const uint64_t k = prevInputs[2];
+            const uint64_t state = masterSlave ? mInternalStates[pCell] : outputs[0];
+
+            // Both => toggle, J => pull up, K => pull down, none => keep
+            const uint64_t nextState = (state & ~(j | k)) | (j & ~k) | (j & k & ~state);
+
+            if (masterSlave)
+            {
+                mInternalStates[pCell] = (state & ~risingEdge) | (nextState & risingEdge);
+                changed |= AssureOutput(pCell, 0, mInternalStates[pCell], fallingEdge);
+                changed |= AssureOutput(pCell, 1, ~mInternalStates[pCell], fallingEdge);
+            }
+            else
+            {
+                changed |= AssureOutput(pCell, 0, nextState, risingEdge);
+                changed |= AssureOutput(pCell, 1, ~nextState, risingEdge);
+            }
+            break;
+        }
+        case CellKernel::MULTIPLEXER:
+        {
+            const uint32_t digitCount = GetMultiplexerDigitCount(inputCount);
+
+            uint64_t state = 0;
+            for (uint32_t i = 0; i < inputCount - digitCount; i++)
+            {
+                state |= MatchInputValue(pCell, 0, digitCount, i) & inputs[digitCount + i];
+            }
+            changed |= AssureOutput(pCell, 0, state, pLanes);
+            break;
+        }
+        case CellKernel::DEMULTIPLEXER:
+        {
+            const uint32_t digitCount = inputCount - 1;
+
+            for (uint32_t i = 0; i < outputCount; i++)
+            {
+                changed |= AssureOutput(pCell, i, MatchInputValue(pCell, 0, digitCount, i) & inputs[digitCount], pLanes);
+            }
+            break;
+        }
+        case CellKernel::DECODER:
+        {
+            for (uint32_t i = 0; i < outputCount; i++)
+            {
+                changed |= AssureOutput(pCell, i, MatchInputValue(pCell, 0, inputCount, i), pLanes);
+            }
+            break;
+        }
+        case CellKernel::ENCODER:
+        {
+            uint64_t anyHigh = 0;
+            for (uint32_t i = 0; i < inputCount; i++)
+            {
+                anyHigh |= inputs[i];
+            }
+            changed |= AssureOutput(pCell, outputCount - 1, anyHigh, pLanes);
+
+            // The highest high input wins, so later inputs overwrite the bits of earlier ones
+            for (uint32_t bit = 0; bit < outputCount - 1; bit++)
+            {
+                uint64_t state = 0;
+                for (uint32_t i = 0; i < inputCount; i++)
+                {
+                    state = (((i >> bit) & 1) != 0) ? (state | inputs[i]) : (state & ~inputs[i]);
+                }
+                changed |= AssureOutput(pCell, bit, state, pLanes);
+            }
+            break;
+        }
+        case CellKernel::SHIFTREGISTER:
+        {
+            for (uint32_t i = outputCount - 1; i > 0; i--)
+            {
+                changed |= AssureOutput(pCell, i, outputs[i - 1], risingEdge);
+            }
+            changed |= AssureOutput(pCell, 0, inputs[0], risingEdge);
+            break;
+        }
+        case CellKernel::COUNTER:
+        {
+            const uint64_t clockEdge = ~prevInputs[2] & inputs[2] & pLanes;
+            const uint64_t reset = clockEdge & inputs[0];
+            uint64_t carry = clockEdge & ~inputs[0] & ~inputs[1];
+
+            // Bit sliced increment, the carry out of the highest bit wraps the counter to zero
+            for (uint32_t i = 0; i < outputCount; i++)
+            {
+                const uint64_t bit = outputs[i];
+                changed |= AssureOutput(pCell, i, (bit ^ carry) & ~reset, carry | reset);
+                carry &= bit;
+            }
+            break;
+        }
+        default:
+        {
+            break; // Wires, diodes and outputs are evaluated on input change, inputs and constants never
+        }
+    }
+
+    switch (mNetlist.kernels[pCell])
+    {
+        case CellKernel::RS_CLOCKED_FLIPFLOP:
+        case CellKernel::RS_MS_FLIPFLOP:
+        case CellKernel::D_FLIPFLOP:
+        case CellKernel::D_MS_FLIPFLOP:
+        case CellKernel::T_FLIPFLOP:
+        case CellKernel::JK_FLIPFLOP:
+        case CellKernel::JK_MS_FLIPFLOP:
+        case CellKernel::SHIFTREGISTER:
+        case CellKernel::COUNTER:
+        {
+            for (uint32_t i = 0; i < inputCount; i++)
+            {
+                prevInputs[i] = (prevInputs[i] & ~pLanes) | (inputs[i] & pLanes);
+            }
+            break;
+        }
+        default:
+        {
+            break;
+        }
+    }
+
+    if (changed)
+    {
+        MarkStateChanged(pCell);
+    }
+}
+
+void BatchSimulationEngine::NotifySuccessors(uint32_t pCell)
+{
+    for (uint32_t output = mNetlist.outputOffsets[pCell]; output < mNetlist.outputOffsets[pCell + 1]; output++)
+    {
+        const uint64_t state = mOutputStates[output];
+
+        for (uint32_t edge = mNetlist.edgeOffsets[output]; edge < mNetlist.edgeOffsets[output + 1]; edge++)
+        {
+            const auto& target = mNetlist.edges[edge];
+            InputReady(target.targetCell, target.targetInput, (target.inverted != 0) ? ~state : state);
+        }
+
+        // Collapsed wire groups and diodes only mirror their driver
+        for (uint32_t mirror = mNetlist.mirrorOffsets[output]; mirror < mNetlist.mirrorOffsets[output + 1]; mirror++)
+        {
+            const auto& target = mNetlist.mirrors[mirror];
+            mInputStates[target.targetInput] = (target.inverted != 0) ? ~state : state;
+            mOutputStates[mNetlist.outputOffsets[target.targetCell]] = mInputStates[target.targetInput];
+        }
+    }
+}
+
+void BatchSimulationEngine::InputReady(uint32_t pCell, uint32_t pInput, uint64_t pState)
+{
+    const uint64_t changedLanes = mInputStates[pInput] ^ pState;
+
+    if (changedLanes == 0)
+    {
+        return;
+    }
+
+    mInputStates[pInput] = pState;
+
+    switch (mNetlist.kernels[pCell])
+    {
+        case CellKernel::WIRE:
+        {
+            uint64_t state = 0;
+            for (uint32_t i = mNetlist.inputOffsets[pCell]; i < mNetlist.inputOffsets[pCell + 1]; i++)
+            {
+                state |= mInputStates[i];
+            }
+
+            if (AssureOutput(pCell, 0, state, ALL_LANES))
+            {
+                NotifySuccessors(pCell);
+            }
+            break;
+        }
+        case CellKernel::DIODE:
+        {
+            if (AssureOutput(pCell, 0, pState, ALL_LANES))
+            {
+                NotifySuccessors(pCell);
+            }
+            break;
+        }
+        case CellKernel::OUTPUT:
+        {
+            break; // Outputs only display their input state
+        }
+        default:
+        {
+            // The changed lanes restart their delay, like a scalar cell whose input changes while an update is pending
+            const uint32_t last = mPendingOffsets[pCell + 1] - 1;
+            for (uint32_t i = mPendingOffsets[pCell]; i < last; i++)
+            {
+                mPendingLanes[i] &= ~changedLanes;
+            }
+            mPendingLanes[last] |= changedLanes;
+            Schedule(pCell);
+            break;
+        }
+    }
+}
+
+bool BatchSimulationEngine::AssureOutput(uint32_t pCell, uint32_t pOutput, uint64_t pState, uint64_t pLanes)
+{
+    auto& output = mOutputStates[mNetlist.outputOffsets[pCell] + pOutput];
+    const uint64_t newState = (output & ~pLanes) | (pState & pLanes);
+
+    if (output != newState)
+    {
+        output = newState;
+        return true;
+    }
+
+    return false;
+}
+
+void BatchSimulationEngine::MarkStateChanged(uint32_t pCell)
+{
+    if (mStateChanged[pCell] == 0)
+    {
+        mStateChanged[pCell] = 1;
+        mChangedCells.push_back(pCell);
+    }
+}
+
+uint64_t BatchSimulationEngine::MatchInputValue(uint32_t pCell, uint32_t pFirst, uint32_t pCount, uint32_t pValue) const
+{
+    uint64_t lanes = ALL_LANES;
+
+    for (uint32_t i = 0; i < pCount; i++)
+    {
+        const uint64_t input = mInputStates[mNetlist.inputOffsets[pCell] + pFirst + i];
+        lanes &= (((pValue >> i) & 1) != 0) ? input : ~input;
+    }
+
+    return lanes;
+}
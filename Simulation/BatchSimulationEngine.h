@@ -0,0 +1,141 @@
+#ifndef BATCHSIMULATIONENGINE_H
+#define BATCHSIMULATIONENGINE_H
+
+#include "Simulation/CompiledNetlist.h"
+
+#include <cstdint>
+#include <vector>
+
+///
+/// \brief The BatchSimulationEngine class simulates 64 independent copies (lanes) of a compiled netlist at once
+/// Every pin carries one 64 bit word, bit n of the word being the pin state in lane n. Gates become single word
+/// operations, so one tick evaluates 64 stimulus vectors. Each lane follows the same propagation delays as the
+/// scalar SimulationEngine, because the pending updates are tracked per lane as well.
+///
+class BatchSimulationEngine
+{
+public:
+    /// \brief The number of independent lanes simulated per tick
+    static constexpr uint32_t LANE_COUNT = 64;
+
+    /// \brief Constructor for BatchSimulationEngine
+    BatchSimulationEngine(void);
+
+    /// \brief Compiles the given netlist, replacing any previous circuit
+    /// \param pNetlist: The netlist to compile
+    void Compile(const Netlist& pNetlist);
+
+    /// \brief Releases the compiled circuit
+    void Clear(void);
+
+    /// \brief Puts all cells in all lanes into their initial simulation state
+    void Reset(void);
+
+    /// \brief Advances all lanes by one logic tick
+    void Tick(void);
+
+    /// \brief Drives the output of an input or button cell with the given lane states and propagates the change
+    /// Buttons are driven like switch inputs in batch mode, they are not released automatically
+    /// \param pCell: Index of an INPUT or BUTTON cell
+    /// \param pLanes: The new output state of each lane
+    void SetInputLanes(uint32_t pCell, uint64_t pLanes);
+
+    /// \brief Getter for the number of compiled cells
+    /// \return The number of compiled cells
+    uint32_t GetCellCount(void) const;
+
+    /// \brief Getter for the kernel of the given cell
+    /// \param pCell: The cell index
+    /// \return The kernel of the cell
+    CellKernel GetKernel(uint32_t pCell) const;
+
+    /// \brief Getter for the lane states of input pInput of the given cell, with input inversion applied
+    /// \param pCell: The cell index
+    /// \param pInput: The input number
+    /// \return The input state of each lane
+    uint64_t GetInputLanes(uint32_t pCell, uint32_t pInput) const;
+
+    /// \brief Getter for the lane states of output pOutput of the given cell, without output inversion
+    /// \param pCell: The cell index
+    /// \param pOutput: The output number
+    /// \return The output state of each lane
+    uint64_t GetOutputLanes(uint32_t pCell, uint32_t pOutput) const;
+
+    /// \brief Returns the lane states of input variable pVariable for an exhaustive enumeration of input vectors
+    /// Lane n of batch b holds the input vector with the number b * LANE_COUNT + n
+    /// \param pVariable: The number of the input variable (bit of the input vector number)
+    /// \param pBatch: The number of the batch
+    /// \return The state of the variable in each lane
+    static uint64_t GetExhaustiveLanes(uint32_t pVariable, uint64_t pBatch);
+
+protected:
+    /// \brief Evaluates the lanes of the cell that are due and moves the other pending lanes one tick closer
+    /// \param pCell: The cell index
+    void AdvanceUpdateTime(uint32_t pCell);
+
+    /// \brief Adds the given cell to the worklist of cells with a pending update if it isn't in it already
+    /// \param pCell: The cell index
+    void Schedule(uint32_t pCell);
+
+    /// \brief Evaluates the kernel of the given cell for the given lanes
+    /// \param pCell: The cell index
+    /// \param pLanes: Mask of the lanes to evaluate, other lanes keep their state
+    void LogicFunction(uint32_t pCell, uint64_t pLanes);
+
+    /// \brief Forwards all output states of the given cell to the connected inputs
+    /// \param pCell: The cell index
+    void NotifySuccessors(uint32_t pCell);
+
+    /// \brief Sets the given input of the given cell to pState and schedules the changed lanes
+    /// \param pCell: The cell index
+    /// \param pInput: Global index of the input
+    /// \param pState: The new input state of each lane
+    void InputReady(uint32_t pCell, uint32_t pInput, uint64_t pState);
+
+    /// \brief Sets the lanes pLanes of output pOutput of the given cell to pState and returns true if it changed
+    /// \param pCell: The cell index
+    /// \param pOutput: The output number
+    /// \param pState: The new output state of each lane
+    /// \param pLanes: Mask of the lanes to set
+    /// \return True, if the output state changed in any lane
+    bool AssureOutput(uint32_t pCell, uint32_t pOutput, uint64_t pState, uint64_t pLanes);
+
+    /// \brief Marks the given cell as changed for the next notification pass
+    /// \param pCell: The cell index
+    void MarkStateChanged(uint32_t pCell);
+
+    /// \brief Returns the lanes in which the inputs pFirst to pFirst + pCount - 1 of the given cell read as pValue
+    /// \param pCell: The cell index
+    /// \param pFirst: The first input number, being the least significant bit
+    /// \param pCount: The number of inputs to read
+    /// \param pValue: The value to compare with
+    /// \return Mask of the lanes in which the inputs equal pValue
+    uint64_t MatchInputValue(uint32_t pCell, uint32_t pFirst, uint32_t pCount, uint32_t pValue) const;
+
+protected:
+    CompiledNetlist mNetlist;
+
+    std::vector<uint64_t> mInputStates;
+    std::vector<uint64_t> mPrevInputStates;
+    std::vector<uint64_t> mOutputStates;
+
+    // Per lane update times, cell i owns the masks [offset[i], offset[i + 1]), one per tick of its delay.
+    // Mask n holds the lanes that are updated in n + 1 ticks, a lane is pending in one mask at most
+    std::vector<uint32_t> mPendingOffsets;
+    std::vector<uint64_t> mPendingLanes;
+
+    std::vector<uint32_t> mScheduledCells;
+    std::vector<uint32_t> mCurrentCells;
+    std::vector<uint8_t> mIsScheduled;
+
+    // Master-slave internal state
+    std::vector<uint64_t> mInternalStates;
+    // Clock tick and pulse countdowns, these do not depend on inputs and are shared by all lanes
+    std::vector<uint32_t> mTickCountdowns;
+    std::vector<uint32_t> mPulseCountdowns;
+
+    std::vector<uint8_t> mStateChanged;
+    std::vector<uint32_t> mChangedCells;
+};
+
+#endif // BATCHSIMULATIONENGINE_H
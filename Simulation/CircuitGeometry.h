@@ -0,0 +1,66 @@
+#ifndef CIRCUITGEOMETRY_H
+#define CIRCUITGEOMETRY_H
+
+#include "HelperStructures.h"
+#include "Simulation/Netlist.h"
+
+#include <cstdint>
+#include <vector>
+
+/// \brief A point in scene coordinates, all connectable geometry is snapped to the grid
+struct GridPoint
+{
+    int32_t x = 0;
+    int32_t y = 0;
+
+    bool operator==(const GridPoint& pOther) const
+    {
+        return (x == pOther.x && y == pOther.y);
+    }
+
+    bool operator!=(const GridPoint& pOther) const
+    {
+        return !(*this == pOther);
+    }
+};
+
+/// \brief A connectable in- or output pin of a component
+struct ConnectorGeometry
+{
+    GridPoint pos; // Scene position of the pin
+    uint32_t number; // In- or output number of the pin on its logic cell
+};
+
+/// \brief A non-wire component with its logic cell and the scene positions of its connectable pins
+struct ComponentGeometry
+{
+    GridPoint pos;
+    NetlistCell cell;
+    std::vector<ConnectorGeometry> inputs;
+    std::vector<ConnectorGeometry> outputs;
+};
+
+/// \brief A straight wire segment from pos to pos + length in its direction
+struct WireGeometry
+{
+    GridPoint pos;
+    WireDirection direction = WireDirection::HORIZONTAL;
+    int32_t length = 0;
+};
+
+/// \brief A ConPoint, full ConPoints connect crossing wires, diodes connect them in one direction
+struct ConPointGeometry
+{
+    GridPoint pos;
+    ConnectionType type = ConnectionType::FULL;
+};
+
+/// \brief The connectivity relevant geometry of a circuit, independent of any graphics scene
+struct CircuitGeometry
+{
+    std::vector<ComponentGeometry> components;
+    std::vector<WireGeometry> wires;
+    std::vector<ConPointGeometry> conPoints;
+};
+
+#endif // CIRCUITGEOMETRY_H
@@ -0,0 +1,741 @@
+#include "CircuitGeometryReader.h"
+#include "Configuration.h"
+
+#include <QJsonArray>
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+int32_t SnapToGrid(int32_t pCoordinate)
+{
+    return static_cast<int32_t>(std::floor(pCoordinate / static_cast<double>(canvas::GRID_SIZE) + 0.5) * canvas::GRID_SIZE);
+}
+
+GridPoint Offset(GridPoint pPos, int32_t pX, int32_t pY)
+{
+    return GridPoint{pPos.x + pX, pPos.y + pY};
+}
+} // namespace
+
+CircuitGeometryReader::CircuitGeometryReader():
+    mSkippedComponentCount(0)
+{}
+
+bool CircuitGeometryReader::ReadJson(const QJsonObject& pJson)
+{
+    mGeometry = CircuitGeometry();
+    mTextLabels.clear();
+    mSkippedComponentCount = 0;
+    mError.clear();
+
+    if (!pJson.contains(file::JSON_COMPONENTS_IDENTIFIER) || !pJson[file::JSON_COMPONENTS_IDENTIFIER].isArray())
+    {
+        return false;
+    }
+
+    const auto components = pJson[file::JSON_COMPONENTS_IDENTIFIER].toArray();
+
+    for (int32_t i = 0; i < components.size(); i++)
+    {
+        if (!ReadComponent(components[i].toObject()))
+        {
+            mError = "component " + std::to_string(i) + ": " + mError;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+const CircuitGeometry& CircuitGeometryReader::GetGeometry() const
+{
+    return mGeometry;
+}
+
+const std::vector<TextLabelGeometry>& CircuitGeometryReader::GetTextLabels() const
+{
+    return mTextLabels;
+}
+
+uint32_t CircuitGeometryReader::GetSkippedComponentCount() const
+{
+    return mSkippedComponentCount;
+}
+
+const std::string& CircuitGeometryReader::GetError() const
+{
+    return mError;
+}
+
+bool CircuitGeometryReader::ReadComponent(const QJsonObject& pJson)
+{
+    if (!pJson.contains(file::JSON_TYPE_IDENTIFIER) || !pJson[file::JSON_TYPE_IDENTIFIER].isDouble())
+    {
+        mSkippedComponentCount++;
+        return true;
+    }
+
+    bool isValid = true;
+
+    switch (pJson[file::JSON_TYPE_IDENTIFIER].toInt())
+    {
+        case file::ComponentId::AND_GATE:
+        {
+            uint32_t inputCount = 0;
+            isValid = ReadPinCount(pJson, "inputs", components::gates::MAX_INPUT_COUNT, inputCount)
+                      && AddGate(pJson, CellKernel::AND_GATE, inputCount);
+            break;
+        }
+        case file::ComponentId::OR_GATE:
+        {
+            uint32_t inputCount = 0;
+            isValid = ReadPinCount(pJson, "inputs", components::gates::MAX_INPUT_COUNT, inputCount)
+                      && AddGate(pJson, CellKernel::OR_GATE, inputCount);
+            break;
+        }
+        case file::ComponentId::XOR_GATE:
+        {
+            uint32_t inputCount = 0;
+            isValid = ReadPinCount(pJson, "inputs", components::gates::MAX_INPUT_COUNT, inputCount)
+                      && AddGate(pJson, CellKernel::XOR_GATE, inputCount);
+            break;
+        }
+        case file::ComponentId::NOT_GATE:
+        {
+            isValid = AddGate(pJson, CellKernel::BUFFER_GATE, 1, true);
+            break;
+        }
+        case file::ComponentId::BUFFER_GATE:
+        {
+            isValid = AddGate(pJson, CellKernel::BUFFER_GATE, 1);
+            break;
+        }
+        case file::ComponentId::WIRE:
+        {
+            WireGeometry wire;
+            wire.pos = GridPoint{SnapToGrid(pJson["x"].toInt()), SnapToGrid(pJson["y"].toInt())};
+            wire.direction = static_cast<WireDirection>(pJson["dir"].toInt());
+            wire.length = pJson["length"].toInt();
+
+            if (wire.direction != WireDirection::HORIZONTAL && wire.direction != WireDirection::VERTICAL)
+            {
+                mError = "invalid wire \"dir\" value " + std::to_string(pJson["dir"].toInt());
+                isValid = false;
+                break;
+            }
+
+            mGeometry.wires.push_back(wire);
+            break;
+        }
+        case file::ComponentId::CONPOINT:
+        {
+            ConPointGeometry conPoint;
+            conPoint.pos = GridPoint{SnapToGrid(pJson["x"].toInt()), SnapToGrid(pJson["y"].toInt())};
+
+            if (pJson.contains("dir"))
+            {
+                if (pJson["dir"] == static_cast<int32_t>(DiodeDirection::HORIZONTAL))
+                {
+                    conPoint.type = ConnectionType::DIODE_X;
+                }
+                else if (pJson["dir"] == static_cast<int32_t>(DiodeDirection::VERTICAL))
+                {
+                    conPoint.type = ConnectionType::DIODE_Y;
+                }
+            }
+
+            mGeometry.conPoints.push_back(conPoint);
+            break;
+        }
+        case file::ComponentId::TEXT_LABEL:
+        {
+            // Text labels have no logic, they are only kept to name components
+            const auto pos = GridPoint{SnapToGrid(pJson["x"].toInt()), SnapToGrid(pJson["y"].toInt())};
+            mTextLabels.push_back(TextLabelGeometry{pos, pJson["text"].toString().trimmed().toStdString()});
+            break;
+        }
+        case file::ComponentId::INPUT:
+        {
+            AddPointComponent(pJson, CellKernel::INPUT, ConnectorType::OUT);
+            break;
+        }
+        case file::ComponentId::CONSTANT:
+        {
+            CellParameters parameters;
+            parameters.constantState = (static_cast<LogicState>(pJson["state"].toInt()) == LogicState::HIGH);
+            AddPointComponent(pJson, CellKernel::CONSTANT, ConnectorType::OUT, parameters);
+            break;
+        }
+        case file::ComponentId::BUTTON:
+        {
+            CellParameters parameters;
+            parameters.toggleTicks = components::inputs::BUTTON_TOGGLE_TICKS;
+            AddPointComponent(pJson, CellKernel::BUTTON, ConnectorType::OUT, parameters);
+            break;
+        }
+        case file::ComponentId::CLOCK:
+        {
+            isValid = AddClock(pJson);
+            break;
+        }
+        case file::ComponentId::OUTPUT:
+        {
+            AddPointComponent(pJson, CellKernel::OUTPUT, ConnectorType::IN);
+            break;
+        }
+        case file::ComponentId::HALF_ADDER:
+        {
+            isValid = AddComplexLogic(pJson, CellKernel::HALF_ADDER, 2, 2);
+            break;
+        }
+        case file::ComponentId::FULL_ADDER:
+        {
+            isValid = AddComplexLogic(pJson, CellKernel::FULL_ADDER, 3, 2);
+            break;
+        }
+        case file::ComponentId::RS_FLIPFLOP:
+        {
+            isValid = AddComplexLogic(pJson, CellKernel::RS_FLIPFLOP, 2, 2);
+            break;
+        }
+        case file::ComponentId::D_FLIPFLOP:
+        {
+            isValid = AddComplexLogic(pJson, CellKernel::D_FLIPFLOP, 2, 2);
+            break;
+        }
+        case file::ComponentId::D_MS_FLIPFLOP:
+        {
+            isValid = AddComplexLogic(pJson, CellKernel::D_MS_FLIPFLOP, 2, 2);
+            break;
+        }
+        case file::ComponentId::T_FLIPFLOP:
+        {
+            isValid = AddComplexLogic(pJson, CellKernel::T_FLIPFLOP, 2, 2);
+            break;
+        }
+        case file::ComponentId::JK_FLIPFLOP:
+        {
+            isValid = AddComplexLogic(pJson, CellKernel::JK_FLIPFLOP, 3, 2);
+            break;
+        }
+        case file::ComponentId::JK_MS_FLIPFLOP:
+        {
+            isValid = AddComplexLogic(pJson, CellKernel::JK_MS_FLIPFLOP, 3, 2);
+            break;
+        }
+        case file::ComponentId::RS_MS_FLIPFLOP:
+        {
+            isValid = AddComplexLogic(pJson, CellKernel::RS_MS_FLIPFLOP, 3, 2);
+            break;
+        }
+        case file::ComponentId::RS_CLOCKED_FLIPFLOP:
+        {
+            isValid = AddComplexLogic(pJson, CellKernel::RS_CLOCKED_FLIPFLOP, 3, 2);
+            break;
+        }
+        case file::ComponentId::MULTIPLEXER:
+        {
+            uint32_t bitWidth = 0;
+            isValid = ReadPinCount(pJson, "bits", components::multiplexer::MAX_BIT_WIDTH, bitWidth)
+                      && AddComplexLogic(pJson, CellKernel::MULTIPLEXER, bitWidth + (1u << bitWidth), 1, bitWidth);
+            break;
+        }
+        case file::ComponentId::DEMULTIPLEXER:
+        {
+            uint32_t bitWidth = 0;
+            isValid = ReadPinCount(pJson, "bits", components::multiplexer::MAX_BIT_WIDTH, bitWidth)
+                      && AddComplexLogic(pJson, CellKernel::DEMULTIPLEXER, bitWidth + 1, 1u << bitWidth, bitWidth);
+            break;
+        }
+        case file::ComponentId::DECODER:
+        {
+            uint32_t inputCount = 0;
+            isValid = ReadPinCount(pJson, "inputs", components::encoder_decoder::MAX_INPUT_COUNT, inputCount)
+                      && AddComplexLogic(pJson, CellKernel::DECODER, inputCount, 1u << inputCount, 0, false, true);
+            break;
+        }
+        case file::ComponentId::ENCODER:
+        {
+            uint32_t outputCount = 0;
+            isValid = ReadPinCount(pJson, "outputs", components::encoder_decoder::MAX_INPUT_COUNT, outputCount)
+                      && AddComplexLogic(pJson, CellKernel::ENCODER, 1u << outputCount, outputCount + 1, 0, false, true);
+            break;
+        }
+        case file::ComponentId::SHIFTREGISTER:
+        {
+            uint32_t bitWidth = 0;
+            isValid = ReadPinCount(pJson, "bits", components::shift_register::MAX_BIT_WIDTH, bitWidth) && AddShiftRegister(pJson, bitWidth);
+            break;
+        }
+        case file::ComponentId::COUNTER:
+        {
+            uint32_t bitWidth = 0;
+            isValid = ReadPinCount(pJson, "bits", components::counter::MAX_BIT_WIDTH, bitWidth)
+                      && AddComplexLogic(pJson, CellKernel::COUNTER, 3, bitWidth, 2, false);
+            break;
+        }
+        default:
+        {
+            // Component unknown by this SW version
+            mSkippedComponentCount++;
+            break;
+        }
+    }
+
+    return isValid;
+}
+
+bool CircuitGeometryReader::AddGate(const QJsonObject& pJson, CellKernel pKernel, uint32_t pInputCount, bool pIsOutputInverted)
+{
+    Q_ASSERT(pInputCount >= 1);
+
+    auto component = CreateComponent(pJson, pKernel);
+    component.cell.inputInverted = ReadInversions(pJson["ininv"], pInputCount);
+    component.cell.outputInverted = std::vector<bool>{pJson.contains("outinv") ? pJson["outinv"].toBool() : pIsOutputInverted};
+
+    Direction direction;
+
+    if (!ReadDirection(pJson, direction))
+    {
+        return false;
+    }
+
+    const int32_t spacing = (pInputCount == 2 ? 2 : 1);
+    const int32_t length = components::gates::GRID_WIDTH * canvas::GRID_SIZE;
+    const int32_t breadth = (pInputCount + (spacing == 2 ? 0 : 1)) * canvas::GRID_SIZE * spacing;
+    const int32_t outputOffset = ((pInputCount >= 4 && pInputCount % 2 == 0) ? canvas::GRID_SIZE / 2 : 0);
+
+    for (uint32_t i = 0; i < pInputCount; i++)
+    {
+        const int32_t inputPos = spacing * canvas::GRID_SIZE * i + canvas::GRID_SIZE;
+
+        switch (direction)
+        {
+            case Direction::RIGHT:
+            {
+                component.inputs.push_back(ConnectorGeometry{Offset(component.pos, 0, inputPos), i});
+                break;
+            }
+            case Direction::DOWN:
+            {
+                component.inputs.push_back(ConnectorGeometry{Offset(component.pos, inputPos, 0), i});
+                break;
+            }
+            case Direction::LEFT:
+            {
+                component.inputs.push_back(ConnectorGeometry{Offset(component.pos, length, inputPos), i});
+                break;
+            }
+            case Direction::UP:
+            {
+                component.inputs.push_back(ConnectorGeometry{Offset(component.pos, inputPos, length), i});
+                break;
+            }
+            default:
+            {
+                Q_ASSERT(false); // Checked by ReadDirection
+                break;
+            }
+        }
+    }
+
+    switch (direction)
+    {
+        case Direction::RIGHT:
+        {
+            component.outputs.push_back(ConnectorGeometry{Offset(component.pos, length, breadth / 2 - outputOffset), 0});
+            break;
+        }
+        case Direction::DOWN:
+        {
+            component.outputs.push_back(ConnectorGeometry{Offset(component.pos, breadth / 2 + outputOffset, length), 0});
+            break;
+        }
+        case Direction::LEFT:
+        {
+            component.outputs.push_back(ConnectorGeometry{Offset(component.pos, 0, breadth / 2 + outputOffset), 0});
+            break;
+        }
+        case Direction::UP:
+        {
+            component.outputs.push_back(ConnectorGeometry{Offset(component.pos, breadth / 2 - outputOffset, 0), 0});
+            break;
+        }
+        default:
+        {
+            Q_ASSERT(false); // Checked by ReadDirection
+            break;
+        }
+    }
+
+    mGeometry.components.push_back(component);
+    return true;
+}
+
+bool CircuitGeometryReader::AddComplexLogic(const QJsonObject& pJson, CellKernel pKernel, uint32_t pInputCount, uint32_t pOutputCount,
+                                            uint32_t pTopInputCount, bool pStretchTwoPins, bool pTrapezoidShape)
+{
+    Q_ASSERT(pInputCount >= pTopInputCount);
+
+    auto component = CreateComponent(pJson, pKernel);
+    component.cell.inputInverted = ReadInversions(pJson["ininv"], pInputCount);
+    component.cell.outputInverted = ReadInversions(pJson["outinv"], pOutputCount);
+
+    Direction direction;
+
+    if (!ReadDirection(pJson, direction))
+    {
+        return false;
+    }
+
+    const int32_t sideInputCount = pInputCount - pTopInputCount;
+
+    int32_t inputsSpacing = 1;
+    int32_t outputsSpacing = 1;
+
+    if (pStretchTwoPins)
+    {
+        inputsSpacing = (sideInputCount == 2 ? 2 : 1);
+        outputsSpacing = (pOutputCount == 2 ? 2 : 1);
+    }
+
+    int32_t inputsOffset = 0;
+    int32_t outputsOffset = 0;
+
+    if (pTrapezoidShape)
+    {
+        if (pInputCount < pOutputCount)
+        {
+            inputsOffset = (pOutputCount - pInputCount) / 2;
+        }
+        else
+        {
+            outputsOffset = (pInputCount - pOutputCount) / 2;
+        }
+    }
+
+    // Length is the extent in signal direction, breadth the extent along the in- and output sides
+    const int32_t length = std::max(components::gates::GRID_WIDTH * canvas::GRID_SIZE,
+                                    (components::gates::GRID_WIDTH - 2) * canvas::GRID_SIZE + static_cast<int32_t>(pTopInputCount) * canvas::GRID_SIZE);
+    const int32_t breadth = std::max((sideInputCount + (inputsSpacing == 2 ? 0 : 1)) * inputsSpacing,
+                                     (static_cast<int32_t>(pOutputCount) + (outputsSpacing == 2 ? 0 : 1)) * outputsSpacing) * canvas::GRID_SIZE;
+
+    for (uint32_t i = 0; i < pTopInputCount; i++)
+    {
+        const int32_t topPos = canvas::GRID_SIZE * (pTopInputCount - i - 1) + canvas::GRID_SIZE;
+
+        switch (direction)
+        {
+            case Direction::RIGHT:
+            {
+                component.inputs.push_back(ConnectorGeometry{Offset(component.pos, topPos, 0), i});
+                break;
+            }
+            case Direction::DOWN:
+            {
+                component.inputs.push_back(ConnectorGeometry{Offset(component.pos, breadth, topPos), i});
+                break;
+            }
+            case Direction::LEFT:
+            {
+                component.inputs.push_back(ConnectorGeometry{Offset(component.pos, length - topPos, breadth), i});
+                break;
+            }
+            case Direction::UP:
+            {
+                component.inputs.push_back(ConnectorGeometry{Offset(component.pos, 0, length - topPos), i});
+                break;
+            }
+            default:
+            {
+                Q_ASSERT(false); // Checked by ReadDirection
+                break;
+            }
+        }
+    }
+
+    for (int32_t i = 0; i < sideInputCount; i++)
+    {
+        const int32_t inputPos = (inputsSpacing * i + inputsOffset + 1) * canvas::GRID_SIZE;
+        const uint32_t number = pTopInputCount + i;
+
+        switch (direction)
+        {
+            case Direction::RIGHT:
+            {
+                component.inputs.push_back(ConnectorGeometry{Offset(component.pos, 0, inputPos), number});
+                break;
+            }
+            case Direction::DOWN:
+            {
+                component.inputs.push_back(ConnectorGeometry{Offset(component.pos, breadth - inputPos, 0), number});
+                break;
+            }
+            case Direction::LEFT:
+            {
+                component.inputs.push_back(ConnectorGeometry{Offset(component.pos, length, breadth - inputPos), number});
+                break;
+            }
+            case Direction::UP:
+            {
+                component.inputs.push_back(ConnectorGeometry{Offset(component.pos, inputPos, length), number});
+                break;
+            }
+            default:
+            {
+                Q_ASSERT(false); // Checked by ReadDirection
+                break;
+            }
+        }
+    }
+
+    for (uint32_t i = 0; i < pOutputCount; i++)
+    {
+        const int32_t outputPos = (outputsSpacing * static_cast<int32_t>(i) + outputsOffset + 1) * canvas::GRID_SIZE;
+
+        switch (direction)
+        {
+            case Direction::RIGHT:
+            {
+                component.outputs.push_back(ConnectorGeometry{Offset(component.pos, length, outputPos), i});
+                break;
+            }
+            case Direction::DOWN:
+            {
+                component.outputs.push_back(ConnectorGeometry{Offset(component.pos, breadth - outputPos, length), i});
+                break;
+            }
+            case Direction::LEFT:
+            {
+                component.outputs.push_back(ConnectorGeometry{Offset(component.pos, 0, breadth - outputPos), i});
+                break;
+            }
+            case Direction::UP:
+            {
+                component.outputs.push_back(ConnectorGeometry{Offset(component.pos, outputPos, 0), i});
+                break;
+            }
+            default:
+            {
+                Q_ASSERT(false); // Checked by ReadDirection
+                break;
+            }
+        }
+    }
+
+    mGeometry.components.push_back(component);
+    return true;
+}
+
+bool CircuitGeometryReader::AddShiftRegister(const QJsonObject& pJson, uint32_t pBitWidth)
+{
+    Q_ASSERT(pBitWidth >= 1);
+
+    auto component = CreateComponent(pJson, CellKernel::SHIFTREGISTER);
+    component.cell.inputInverted = ReadInversions(pJson["ininv"], 2);
+    component.cell.outputInverted = ReadInversions(pJson["outinv"], pBitWidth);
+
+    Direction direction;
+
+    if (!ReadDirection(pJson, direction))
+    {
+        return false;
+    }
+
+    const int32_t length = (pBitWidth + 1) * canvas::GRID_SIZE;
+    const int32_t breadth = canvas::GRID_SIZE * 3;
+
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        const int32_t inputPos = (i + 1) * canvas::GRID_SIZE;
+
+        switch (direction)
+        {
+            case Direction::RIGHT:
+            {
+                component.inputs.push_back(ConnectorGeometry{Offset(component.pos, 0, inputPos), i});
+                break;
+            }
+            case Direction::DOWN:
+            {
+                component.inputs.push_back(ConnectorGeometry{Offset(component.pos, inputPos, 0), i});
+                break;
+            }
+            case Direction::LEFT:
+            {
+                component.inputs.push_back(ConnectorGeometry{Offset(component.pos, length, breadth - inputPos), i});
+                break;
+            }
+            case Direction::UP:
+            {
+                component.inputs.push_back(ConnectorGeometry{Offset(component.pos, inputPos, length), i});
+                break;
+            }
+            default:
+            {
+                Q_ASSERT(false); // Checked by ReadDirection
+                break;
+            }
+        }
+    }
+
+    // Only the last output is led out of the component
+    switch (direction)
+    {
+        case Direction::RIGHT:
+        {
+            component.outputs.push_back(ConnectorGeometry{Offset(component.pos, length, canvas::GRID_SIZE), pBitWidth - 1});
+            break;
+        }
+        case Direction::DOWN:
+        {
+            component.outputs.push_back(ConnectorGeometry{Offset(component.pos, breadth - canvas::GRID_SIZE, length), pBitWidth - 1});
+            break;
+        }
+        case Direction::LEFT:
+        {
+            component.outputs.push_back(ConnectorGeometry{Offset(component.pos, 0, breadth - canvas::GRID_SIZE), pBitWidth - 1});
+            break;
+        }
+        case Direction::UP:
+        {
+            component.outputs.push_back(ConnectorGeometry{Offset(component.pos, canvas::GRID_SIZE, 0), pBitWidth - 1});
+            break;
+        }
+        default:
+        {
+            Q_ASSERT(false); // Checked by ReadDirection
+            break;
+        }
+    }
+
+    mGeometry.components.push_back(component);
+    return true;
+}
+
+bool CircuitGeometryReader::AddClock(const QJsonObject& pJson)
+{
+    Direction direction;
+
+    if (!ReadDirection(pJson, direction))
+    {
+        return false;
+    }
+
+    auto component = CreateComponent(pJson, CellKernel::CLOCK);
+    component.cell.outputInverted = std::vector<bool>{pJson["outinv"].toBool()};
+    component.cell.parameters.toggleTicks = pJson["toggle"].toInt();
+    component.cell.parameters.pulseTicks = pJson["pulse"].toInt();
+    component.cell.parameters.pulseMode = (static_cast<ClockMode>(pJson["mode"].toInt()) == ClockMode::PULSE);
+
+    const int32_t size = canvas::GRID_SIZE * 2;
+
+    switch (direction)
+    {
+        case Direction::RIGHT:
+        {
+            component.outputs.push_back(ConnectorGeometry{Offset(component.pos, size, size / 2), 0});
+            break;
+        }
+        case Direction::DOWN:
+        {
+            component.outputs.push_back(ConnectorGeometry{Offset(component.pos, size / 2, size), 0});
+            break;
+        }
+        case Direction::LEFT:
+        {
+            component.outputs.push_back(ConnectorGeometry{Offset(component.pos, 0, size / 2), 0});
+            break;
+        }
+        case Direction::UP:
+        {
+            component.outputs.push_back(ConnectorGeometry{Offset(component.pos, size / 2, 0), 0});
+            break;
+        }
+        default:
+        {
+            Q_ASSERT(false); // Checked by ReadDirection
+            break;
+        }
+    }
+
+    mGeometry.components.push_back(component);
+    return true;
+}
+
+void CircuitGeometryReader::AddPointComponent(const QJsonObject& pJson, CellKernel pKernel, ConnectorType pType, CellParameters pParameters)
+{
+    auto component = CreateComponent(pJson, pKernel);
+    component.cell.parameters = pParameters;
+
+    if (pType == ConnectorType::IN)
+    {
+        component.cell.inputInverted = std::vector<bool>{false};
+        component.inputs.push_back(ConnectorGeometry{component.pos, 0});
+    }
+    else
+    {
+        component.cell.outputInverted = std::vector<bool>{false};
+        component.outputs.push_back(ConnectorGeometry{component.pos, 0});
+    }
+
+    mGeometry.components.push_back(component);
+}
+
+bool CircuitGeometryReader::ReadPinCount(const QJsonObject& pJson, const char* pKey, uint32_t pMaxCount, uint32_t& pCount)
+{
+    const auto count = pJson[pKey].toInt();
+
+    if (count < 1 || count > static_cast<int32_t>(pMaxCount))
+    {
+        mError = "invalid \"" + std::string(pKey) + "\" value " + std::to_string(count) + ", the editor allows 1 to " + std::to_string(pMaxCount);
+        return false;
+    }
+
+    pCount = count;
+    return true;
+}
+
+bool CircuitGeometryReader::ReadDirection(const QJsonObject& pJson, Direction& pDirection)
+{
+    const auto direction = pJson["dir"].toInt();
+
+    if (direction < static_cast<int32_t>(Direction::RIGHT) || direction > static_cast<int32_t>(Direction::UP))
+    {
+        mError = "invalid \"dir\" value " + std::to_string(direction);
+        return false;
+    }
+
+    pDirection = static_cast<Direction>(direction);
+    return true;
+}
+
+ComponentGeometry CircuitGeometryReader::CreateComponent(const QJsonObject& pJson, CellKernel pKernel) const
+{
+    ComponentGeometry component;
+    component.pos = GridPoint{SnapToGrid(pJson["x"].toInt()), SnapToGrid(pJson["y"].toInt())};
+    component.cell.kernel = pKernel;
+    component.cell.parameters.delay = ClampCellDelay(pJson["delay"].toInt(DEFAULT_CELL_DELAY));
+    return component;
+}
+
+std::vector<bool> CircuitGeometryReader::ReadInversions(const QJsonValue& pValue, uint32_t pCount) const
+{
+    std::vector<bool> inversions;
+
+    if (pValue.isArray())
+    {
+        for (const auto& inv : pValue.toArray())
+        {
+            inversions.push_back(inv.toBool());
+        }
+    }
+    else if (pValue.isBool())
+    {
+        inversions.push_back(pValue.toBool());
+    }
+
+    inversions.resize(pCount, false);
+    return inversions;
+}
@@ -0,0 +1,126 @@
+#ifndef CIRCUITGEOMETRYREADER_H
+#define CIRCUITGEOMETRYREADER_H
+
+#include "Simulation/CircuitGeometry.h"
+
+#include <QJsonObject>
+#include <QJsonValue>
+#include <string>
+#include <vector>
+
+/// \brief A text label of the circuit, labels have no logic but can name nearby components
+struct TextLabelGeometry
+{
+    GridPoint pos;
+    std::string text; // UTF-8, without leading and trailing whitespace
+};
+
+///
+/// \brief The CircuitGeometryReader reconstructs the circuit geometry from the JSON of a circuit file
+/// The connector layouts mirror the ones of the graphical components, so no graphics scene is needed
+///
+class CircuitGeometryReader
+{
+public:
+    /// \brief Constructor for CircuitGeometryReader
+    CircuitGeometryReader(void);
+
+    /// \brief Reads all components of the given circuit JSON, replacing any previously read geometry
+    /// \param pJson: The circuit JSON as stored in circuit files
+    /// \return False, if the JSON contains no component array or an invalid component
+    bool ReadJson(const QJsonObject& pJson);
+
+    /// \brief Getter for the geometry read by the last call to ReadJson
+    /// \return The circuit geometry
+    const CircuitGeometry& GetGeometry(void) const;
+
+    /// \brief Getter for the text labels read by the last call to ReadJson
+    /// \return The text labels in file order
+    const std::vector<TextLabelGeometry>& GetTextLabels(void) const;
+
+    /// \brief Getter for the number of components that were skipped because their type is unknown
+    /// \return The number of skipped components
+    uint32_t GetSkippedComponentCount(void) const;
+
+    /// \brief Getter for the invalid component that made the last call to ReadJson fail
+    /// \return The description of the invalid component, empty if there is none
+    const std::string& GetError(void) const;
+
+protected:
+    /// \brief Reads a single component and appends it to the geometry, components of unknown type are skipped
+    /// \param pJson: The JSON of the component
+    /// \return False, if the component is invalid
+    bool ReadComponent(const QJsonObject& pJson);
+
+    /// \brief Appends a gate with the given kernel and input count
+    /// \param pJson: The JSON of the gate
+    /// \param pKernel: The kernel of the gate
+    /// \param pInputCount: The number of gate inputs
+    /// \param pIsOutputInverted: The output inversion if the JSON contains none
+    /// \return False, if the direction is invalid
+    bool AddGate(const QJsonObject& pJson, CellKernel pKernel, uint32_t pInputCount, bool pIsOutputInverted = false);
+
+    /// \brief Appends a complex logic component with the connector layout of AbstractComplexLogic
+    /// \param pJson: The JSON of the component
+    /// \param pKernel: The kernel of the component
+    /// \param pInputCount: The number of inputs, including top inputs
+    /// \param pOutputCount: The number of outputs
+    /// \param pTopInputCount: The number of inputs on the top side
+    /// \param pStretchTwoPins: If true, two in- or outputs on a side are spaced two grid cells apart
+    /// \param pTrapezoidShape: If true, the smaller pin side is centered like on trapezoid components
+    /// \return False, if the direction is invalid
+    bool AddComplexLogic(const QJsonObject& pJson, CellKernel pKernel, uint32_t pInputCount, uint32_t pOutputCount,
+                         uint32_t pTopInputCount = 0, bool pStretchTwoPins = true, bool pTrapezoidShape = false);
+
+    /// \brief Appends a shift register, of which only the last output is connectable
+    /// \param pJson: The JSON of the shift register
+    /// \param pBitWidth: The number of bits
+    /// \return False, if the direction is invalid
+    bool AddShiftRegister(const QJsonObject& pJson, uint32_t pBitWidth);
+
+    /// \brief Appends a clock
+    /// \param pJson: The JSON of the clock
+    /// \return False, if the direction is invalid
+    bool AddClock(const QJsonObject& pJson);
+
+    /// \brief Appends a component with a single pin at its position, like inputs and outputs
+    /// \param pJson: The JSON of the component
+    /// \param pKernel: The kernel of the component
+    /// \param pType: Whether the pin is an in- or output
+    /// \param pParameters: The kernel parameters
+    void AddPointComponent(const QJsonObject& pJson, CellKernel pKernel, ConnectorType pType, CellParameters pParameters = CellParameters());
+
+    /// \brief Reads an in- or output count or bit width of a component and sets the error if it is invalid
+    /// \param pJson: The JSON of the component
+    /// \param pKey: The JSON key of the count
+    /// \param pMaxCount: The largest count the editor allows
+    /// \param pCount: Set to the count
+    /// \return False, if the count is below 1 or above pMaxCount
+    bool ReadPinCount(const QJsonObject& pJson, const char* pKey, uint32_t pMaxCount, uint32_t& pCount);
+
+    /// \brief Reads the direction of a component and sets the error if it is invalid
+    /// \param pJson: The JSON of the component
+    /// \param pDirection: Set to the direction
+    /// \return False, if the direction is invalid
+    bool ReadDirection(const QJsonObject& pJson, Direction& pDirection);
+
+    /// \brief Creates a component at the snapped position of the given JSON
+    /// \param pJson: The JSON of the component
+    /// \param pKernel: The kernel of the component
+    /// \return The component without connectors and inversions
+    ComponentGeometry CreateComponent(const QJsonObject& pJson, CellKernel pKernel) const;
+
+    /// \brief Reads in- or output inversions, stored either as array or as single boolean
+    /// \param pValue: The JSON value of the inversions
+    /// \param pCount: The number of pins, missing inversions are false
+    /// \return The inversion of each pin
+    std::vector<bool> ReadInversions(const QJsonValue& pValue, uint32_t pCount) const;
+
+protected:
+    CircuitGeometry mGeometry;
+    std::vector<TextLabelGeometry> mTextLabels;
+    uint32_t mSkippedComponentCount;
+    std::string mError;
+};
+
+#endif // CIRCUITGEOMETRYREADER_H
@@ -0,0 +1,375 @@
+#include "CompiledNetlist.h"
+
+#include <QtGlobal>
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+/// \brief Returns true, if the cell's output always equals the state of its only input
+/// \param pCompiled: The compiled netlist
+/// \param pCell: The cell index
+/// \return True, if the cell can be collapsed into its driver
+bool IsCollapsible(const CompiledNetlist& pCompiled, uint32_t pCell)
+{
+    const uint32_t inputCount = pCompiled.inputOffsets[pCell + 1] - pCompiled.inputOffsets[pCell];
+    return (pCompiled.kernels[pCell] == CellKernel::DIODE || pCompiled.kernels[pCell] == CellKernel::WIRE) && inputCount == 1;
+}
+
+/// \brief A range of edges still to follow when collapsing, with the inversion accumulated on the way to them
+struct CollapseFrame
+{
+    uint32_t edge;
+    uint32_t lastEdge;
+    uint8_t inverted;
+};
+
+/// \brief Appends the loads reached from the given output to the collapsed edges and mirrors of the output,
+/// following the edges through collapsible cells
+/// The chains are followed depth first with an explicit stack, so long chains of wire groups and diodes can't overflow the call stack
+/// \param pCompiled: The compiled netlist
+/// \param pOutput: The global output index
+/// \param pEdges: Vector to append the collapsed edges to
+/// \param pMirrors: Vector to append the mirrored cells to
+/// \param pVisitStamps: Per cell index of the output that last visited it, protects from loops of collapsible cells
+/// \param pStack: Buffer for the edge ranges still to follow, reused between outputs
+void CollapseEdges(const CompiledNetlist& pCompiled, uint32_t pOutput, std::vector<CompiledEdge>& pEdges, std::vector<CompiledEdge>& pMirrors,
+                   std::vector<uint32_t>& pVisitStamps, std::vector<CollapseFrame>& pStack)
+{
+    pStack.assign(1, CollapseFrame{pCompiled.edgeOffsets[pOutput], pCompiled.edgeOffsets[pOutput + 1], 0});
+
+    while (!pStack.empty())
+    {
+        auto& frame = pStack.back();
+
+        if (frame.edge == frame.lastEdge)
+        {
+            pStack.pop_back();
+            continue;
+        }
+
+        auto target = pCompiled.edges[frame.edge++];
+        target.inverted ^= frame.inverted;
+
+        if (!IsCollapsible(pCompiled, target.targetCell))
+        {
+            pEdges.push_back(target);
+            continue;
+        }
+
+        if (pVisitStamps[target.targetCell] == pOutput)
+        {
+            continue;
+        }
+
+        pVisitStamps[target.targetCell] = pOutput;
+        pMirrors.push_back(target);
+
+        const uint32_t output = pCompiled.outputOffsets[target.targetCell];
+        pStack.push_back(CollapseFrame{pCompiled.edgeOffsets[output], pCompiled.edgeOffsets[output + 1], target.inverted});
+    }
+}
+
+/// \brief Replaces the edges of the compiled netlist with edges that skip collapsible cells and fills the mirrors
+/// \param pCompiled: The compiled netlist
+void CollapseNets(CompiledNetlist& pCompiled)
+{
+    const uint32_t cellCount = pCompiled.kernels.size();
+    const uint32_t outputCount = pCompiled.outputOffsets.back();
+
+    std::vector<uint32_t> edgeOffsets;
+    std::vector<CompiledEdge> edges;
+    edgeOffsets.reserve(outputCount + 1);
+    edges.reserve(pCompiled.edges.size());
+
+    pCompiled.mirrorOffsets.clear();
+    pCompiled.mirrors.clear();
+    pCompiled.mirrorOffsets.reserve(outputCount + 1);
+
+    edgeOffsets.push_back(0);
+    pCompiled.mirrorOffsets.push_back(0);
+
+    std::vector<uint32_t> visitStamps(cellCount, outputCount); // No output has the stamp outputCount
+    std::vector<CollapseFrame> stack;
+
+    for (uint32_t cell = 0; cell < cellCount; cell++)
+    {
+        const bool isCollapsible = IsCollapsible(pCompiled, cell);
+
+        for (uint32_t output = pCompiled.outputOffsets[cell]; output < pCompiled.outputOffsets[cell + 1]; output++)
+        {
+            // Collapsed cells are never notified, their loads are reached through their driver
+            if (!isCollapsible)
+            {
+                CollapseEdges(pCompiled, output, edges, pCompiled.mirrors, visitStamps, stack);
+            }
+
+            edgeOffsets.push_back(edges.size());
+            pCompiled.mirrorOffsets.push_back(pCompiled.mirrors.size());
+        }
+    }
+
+    pCompiled.edgeOffsets = std::move(edgeOffsets);
+    pCompiled.edges = std::move(edges);
+}
+/// \brief Returns true, if the outputs of cells with the given kernel follow their inputs without waiting for a clock edge
+/// \param pKernel: The kernel
+/// \return True, if a cycle of such cells forms a combinational loop
+bool IsTransparent(CellKernel pKernel)
+{
+    switch (pKernel)
+    {
+        case CellKernel::WIRE:
+        case CellKernel::DIODE:
+        case CellKernel::AND_GATE:
+        case CellKernel::OR_GATE:
+        case CellKernel::XOR_GATE:
+        case CellKernel::BUFFER_GATE:
+        case CellKernel::HALF_ADDER:
+        case CellKernel::FULL_ADDER:
+        case CellKernel::RS_FLIPFLOP:
+        case CellKernel::MULTIPLEXER:
+        case CellKernel::DEMULTIPLEXER:
+        case CellKernel::DECODER:
+        case CellKernel::ENCODER:
+        {
+            return true;
+        }
+        default:
+        {
+            return false;
+        }
+    }
+}
+
+/// \brief Returns true, if the given cell drives itself through one of its own edges
+/// \param pCompiled: The compiled netlist
+/// \param pCell: The cell index
+/// \return True, if the cell has an edge to itself
+bool HasSelfEdge(const CompiledNetlist& pCompiled, uint32_t pCell)
+{
+    for (uint32_t edge = pCompiled.edgeOffsets[pCompiled.outputOffsets[pCell]]; edge < pCompiled.edgeOffsets[pCompiled.outputOffsets[pCell + 1]]; edge++)
+    {
+        if (pCompiled.edges[edge].targetCell == pCell)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/// \brief Fills the combinational loops of the compiled netlist and flags the edges that lead into them
+/// The loops are the strongly connected components of the transparent cells (Tarjan's algorithm, iterative
+/// so deep circuits cannot overflow the stack). Loops of wires and diodes only can't oscillate and are left out
+/// \param pCompiled: The compiled netlist
+void FindCombinationalLoops(CompiledNetlist& pCompiled)
+{
+    constexpr uint32_t UNVISITED = std::numeric_limits<uint32_t>::max();
+
+    // A visited cell and the next of its edges to follow
+    struct Frame
+    {
+        uint32_t cell;
+        uint32_t edge;
+    };
+
+    const uint32_t cellCount = pCompiled.kernels.size();
+
+    std::vector<uint32_t> indices(cellCount, UNVISITED);
+    std::vector<uint32_t> lowLinks(cellCount, 0);
+    std::vector<uint8_t> isOnStack(cellCount, 0);
+    std::vector<uint32_t> componentStack;
+    std::vector<Frame> callStack;
+    uint32_t nextIndex = 0;
+
+    pCompiled.loopIds.assign(cellCount, 0);
+    pCompiled.loopOffsets.assign(1, 0);
+    pCompiled.loopCells.clear();
+
+    const auto visit = [&](uint32_t pCell)
+    {
+        indices[pCell] = nextIndex;
+        lowLinks[pCell] = nextIndex;
+        nextIndex++;
+        componentStack.push_back(pCell);
+        isOnStack[pCell] = 1;
+        callStack.push_back(Frame{pCell, pCompiled.edgeOffsets[pCompiled.outputOffsets[pCell]]});
+    };
+
+    for (uint32_t root = 0; root < cellCount; root++)
+    {
+        if (indices[root] != UNVISITED || !IsTransparent(pCompiled.kernels[root]))
+        {
+            continue;
+        }
+
+        visit(root);
+
+        while (!callStack.empty())
+        {
+            const uint32_t cell = callStack.back().cell;
+
+            if (callStack.back().edge < pCompiled.edgeOffsets[pCompiled.outputOffsets[cell + 1]])
+            {
+                const uint32_t target = pCompiled.edges[callStack.back().edge++].targetCell;
+
+                if (!IsTransparent(pCompiled.kernels[target]))
+                {
+                    continue;
+                }
+
+                if (indices[target] == UNVISITED)
+                {
+                    visit(target);
+                }
+                else if (isOnStack[target] != 0)
+                {
+                    lowLinks[cell] = std::min(lowLinks[cell], indices[target]);
+                }
+                continue;
+            }
+
+            callStack.pop_back();
+
+            if (!callStack.empty())
+            {
+                const uint32_t parent = callStack.back().cell;
+                lowLinks[parent] = std::min(lowLinks[parent], lowLinks[cell]);
+            }
+
+            if (lowLinks[cell] != indices[cell])
+            {
+                continue;
+            }
+
+            // The cell is the root of a component, which lies on top of it on the component stack
+            size_t rootPosition = componentStack.size() - 1;
+            while (componentStack[rootPosition] != cell)
+            {
+                rootPosition--;
+            }
+
+            const auto first = componentStack.begin() + rootPosition;
+            bool hasLogic = false;
+
+            for (auto member = first; member < componentStack.end(); member++)
+            {
+                isOnStack[*member] = 0;
+                hasLogic |= (pCompiled.kernels[*member] != CellKernel::WIRE && pCompiled.kernels[*member] != CellKernel::DIODE);
+            }
+
+            const bool isLoop = (componentStack.end() - first > 1 || HasSelfEdge(pCompiled, cell));
+
+            if (isLoop && hasLogic)
+            {
+                const uint32_t loopId = pCompiled.loopOffsets.size();
+
+                for (auto member = first; member < componentStack.end(); member++)
+                {
+                    pCompiled.loopIds[*member] = loopId;
+                }
+
+                pCompiled.loopCells.insert(pCompiled.loopCells.end(), first, componentStack.end());
+                pCompiled.loopOffsets.push_back(pCompiled.loopCells.size());
+            }
+
+            componentStack.erase(first, componentStack.end());
+        }
+    }
+
+    for (uint32_t cell = 0; cell < cellCount; cell++)
+    {
+        for (uint32_t edge = pCompiled.edgeOffsets[pCompiled.outputOffsets[cell]]; edge < pCompiled.edgeOffsets[pCompiled.outputOffsets[cell + 1]]; edge++)
+        {
+            auto& target = pCompiled.edges[edge];
+            const uint32_t loopId = pCompiled.loopIds[target.targetCell];
+            target.entersLoop = (loopId != 0 && loopId != pCompiled.loopIds[cell]) ? 1 : 0;
+        }
+    }
+}
+} // namespace
+
+void CompileNetlist(const Netlist& pNetlist, CompiledNetlist& pCompiled)
+{
+    const uint32_t cellCount = pNetlist.cells.size();
+
+    pCompiled = CompiledNetlist();
+
+    pCompiled.kernels.reserve(cellCount);
+    pCompiled.parameters.reserve(cellCount);
+    pCompiled.inputOffsets.reserve(cellCount + 1);
+    pCompiled.outputOffsets.reserve(cellCount + 1);
+
+    pCompiled.inputOffsets.push_back(0);
+    pCompiled.outputOffsets.push_back(0);
+
+    for (const auto& cell : pNetlist.cells)
+    {
+        if (cell.kernel == CellKernel::CLOCK || cell.kernel == CellKernel::BUTTON)
+        {
+            pCompiled.timedCells.push_back(pCompiled.kernels.size());
+        }
+
+        pCompiled.kernels.push_back(cell.kernel);
+        Q_ASSERT(cell.parameters.delay >= 1 && cell.parameters.delay <= MAX_CELL_DELAY);
+        pCompiled.parameters.push_back(cell.parameters);
+
+        for (const auto& inverted : cell.inputInverted)
+        {
+            pCompiled.inputResetStates.push_back(inverted ? 1 : 0);
+        }
+
+        pCompiled.inputOffsets.push_back(pCompiled.inputResetStates.size());
+        pCompiled.outputOffsets.push_back(pCompiled.outputOffsets.back() + cell.outputInverted.size());
+    }
+
+    // Sort the connections by their global source output (counting sort) to get a compact edge array
+    pCompiled.edgeOffsets.resize(pCompiled.outputOffsets.back() + 1, 0);
+
+    for (const auto& connection : pNetlist.connections)
+    {
+        Q_ASSERT(connection.sourceCell < cellCount && connection.targetCell < cellCount);
+        Q_ASSERT(pCompiled.outputOffsets[connection.sourceCell] + connection.sourceOutput < pCompiled.outputOffsets[connection.sourceCell + 1]);
+        Q_ASSERT(pCompiled.inputOffsets[connection.targetCell] + connection.targetInput < pCompiled.inputOffsets[connection.targetCell + 1]);
+
+        pCompiled.edgeOffsets[pCompiled.outputOffsets[connection.sourceCell] + connection.sourceOutput + 1]++;
+    }
+
+    for (uint32_t i = 1; i < pCompiled.edgeOffsets.size(); i++)
+    {
+        pCompiled.edgeOffsets[i] += pCompiled.edgeOffsets[i - 1];
+    }
+
+    std::vector<uint32_t> fill(pCompiled.edgeOffsets.begin(), pCompiled.edgeOffsets.end() - 1);
+    pCompiled.edges.resize(pNetlist.connections.size());
+
+    for (const auto& connection : pNetlist.connections)
+    {
+        const auto& source = pNetlist.cells[connection.sourceCell];
+        const auto& target = pNetlist.cells[connection.targetCell];
+
+        const uint8_t inverted = (source.outputInverted[connection.sourceOutput] != target.inputInverted[connection.targetInput]) ? 1 : 0;
+        const uint32_t output = pCompiled.outputOffsets[connection.sourceCell] + connection.sourceOutput;
+
+        pCompiled.edges[fill[output]++] = CompiledEdge{connection.targetCell,
+                                                       pCompiled.inputOffsets[connection.targetCell] + connection.targetInput,
+                                                       inverted,
+                                                       0}; // Loops are only known after collapsing
+    }
+
+    CollapseNets(pCompiled);
+    FindCombinationalLoops(pCompiled);
+}
+
+uint32_t GetMultiplexerDigitCount(uint32_t pInputCount)
+{
+    uint32_t digitCount = 0;
+
+    while (digitCount + (1u << digitCount) < pInputCount)
+    {
+        digitCount++;
+    }
+
+    return digitCount;
+}
@@ -0,0 +1,64 @@
+#ifndef COMPILEDNETLIST_H
+#define COMPILEDNETLIST_H
+
+#include "Simulation/Netlist.h"
+
+#include <cstdint>
+#include <vector>
+
+/// \brief A compiled connection from a global output index to a global input index
+struct CompiledEdge
+{
+    uint32_t targetCell;
+    uint32_t targetInput;
+    uint8_t inverted;
+    uint8_t entersLoop; // Set if the edge leads into a combinational loop from outside of it
+};
+
+/// \brief Flat, index-based form of a netlist that the simulation engines operate on
+struct CompiledNetlist
+{
+    std::vector<CellKernel> kernels;
+    std::vector<CellParameters> parameters;
+
+    // Offsets into the pin arrays, cell i owns the pins [offset[i], offset[i + 1])
+    std::vector<uint32_t> inputOffsets;
+    std::vector<uint32_t> outputOffsets;
+
+    // Initial input states, inverted inputs start high
+    std::vector<uint8_t> inputResetStates;
+
+    // Offsets into the edge array, global output i drives the edges [offset[i], offset[i + 1])
+    std::vector<uint32_t> edgeOffsets;
+    std::vector<CompiledEdge> edges;
+
+    // Wire groups with a single driver and diodes are collapsed out of the edges, their drivers forward directly
+    // to their loads. The collapsed cells only mirror the driving output for display and tracing:
+    // global output i sets the only input and the output of the mirror cells [offset[i], offset[i + 1])
+    std::vector<uint32_t> mirrorOffsets;
+    std::vector<CompiledEdge> mirrors;
+
+    // Clocks and buttons, which are evaluated on every tick
+    std::vector<uint32_t> timedCells;
+
+    // Combinational loops, the strongly connected components of cells whose outputs follow their inputs without a clock.
+    // Cell i belongs to loop loopIds[i] - 1, or to no loop if its id is 0; loop l consists of the cells [offset[l], offset[l + 1])
+    std::vector<uint32_t> loopIds;
+    std::vector<uint32_t> loopOffsets;
+    std::vector<uint32_t> loopCells;
+};
+
+/// \brief Compiles the given netlist into its flat form
+/// Output and input inversion are folded into the edges, so a forwarded state needs only a single XOR.
+/// Chains of single driver wire groups and diodes are resolved, so a state reaches the next gate in one hop.
+/// Combinational loops are searched in the resolved edges
+/// \param pNetlist: The netlist to compile
+/// \param pCompiled: The compiled netlist to fill, previous contents are replaced
+void CompileNetlist(const Netlist& pNetlist, CompiledNetlist& pCompiled);
+
+/// \brief Returns the number of select inputs of a multiplexer with the given total input count
+/// \param pInputCount: The total number of multiplexer inputs (select and data inputs)
+/// \return The number of select inputs
+uint32_t GetMultiplexerDigitCount(uint32_t pInputCount);
+
+#endif // COMPILEDNETLIST_H
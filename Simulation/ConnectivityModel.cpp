@@ -0,0 +1,378 @@
+#include "ConnectivityModel.h"
+
+#include <QtGlobal>
+
+#include <algorithm>
+
+constexpr uint32_t ConnectivityModel::NO_WIRE;
+
+ConnectivityModel::ConnectivityModel():
+    mVisitStamp(0)
+{}
+
+uint32_t ConnectivityModel::AddWire(const WireGeometry& pWire)
+{
+    const uint32_t wire = mWires.size();
+    int32_t start;
+    int32_t end;
+    GetSpan(pWire, start, end);
+
+    mWires.push_back(pWire);
+    mVisitStamps.push_back(0);
+
+    auto& line = mLines[GetLineKey(pWire)];
+    line.wires.emplace(start, wire);
+    line.maxLength = std::max(line.maxLength, end - start);
+
+    const auto group = CreateGroup();
+    mWireGroups.push_back(group);
+    mWirePositions.push_back(mGroupWires[group].size());
+    mGroupWires[group].push_back(wire);
+
+    CollectNeighbours(wire);
+
+    for (const auto& neighbour : mNeighbours)
+    {
+        MergeGroups(mWireGroups[wire], mWireGroups[neighbour]);
+    }
+
+    return wire;
+}
+
+void ConnectivityModel::RemoveWire(uint32_t pWire)
+{
+    Q_ASSERT(pWire < mWires.size());
+
+    const auto group = mWireGroups[pWire];
+    const auto last = static_cast<uint32_t>(mWires.size() - 1);
+
+    ReplaceLineEntry(mWires[pWire], pWire, NO_WIRE);
+
+    // Take the wire out of its group, the last wire of the group fills the gap
+    auto& groupWires = mGroupWires[group];
+    groupWires[mWirePositions[pWire]] = groupWires.back();
+    mWirePositions[groupWires.back()] = mWirePositions[pWire];
+    groupWires.pop_back();
+
+    // The last wire takes over the index of the removed one
+    if (pWire != last)
+    {
+        ReplaceLineEntry(mWires[last], last, pWire);
+        mWires[pWire] = mWires[last];
+        mWireGroups[pWire] = mWireGroups[last];
+        mWirePositions[pWire] = mWirePositions[last];
+        mGroupWires[mWireGroups[pWire]][mWirePositions[pWire]] = pWire;
+    }
+
+    mWires.pop_back();
+    mWireGroups.pop_back();
+    mWirePositions.pop_back();
+    mVisitStamps.pop_back();
+
+    Regroup(group);
+}
+
+void ConnectivityModel::AddFullConPoint(GridPoint pPos)
+{
+    if (mFullConPoints[GridIndex::GetPointKey(pPos)]++ > 0)
+    {
+        return; // Stacked ConPoints connect nothing new
+    }
+
+    mFullConPointLines[GridIndex::GetLineKey(WireDirection::HORIZONTAL, pPos.y)].insert(pPos.x);
+    mFullConPointLines[GridIndex::GetLineKey(WireDirection::VERTICAL, pPos.x)].insert(pPos.y);
+
+    GetWiresAt(pPos, mWireHits);
+
+    for (const auto& hit : mWireHits)
+    {
+        MergeGroups(mWireGroups[mWireHits.front().wire], mWireGroups[hit.wire]);
+    }
+}
+
+void ConnectivityModel::RemoveFullConPoint(GridPoint pPos)
+{
+    const auto conPoint = mFullConPoints.find(GridIndex::GetPointKey(pPos));
+    Q_ASSERT(conPoint != mFullConPoints.end());
+
+    if (--conPoint->second > 0)
+    {
+        return;
+    }
+
+    mFullConPoints.erase(conPoint);
+    mFullConPointLines[GridIndex::GetLineKey(WireDirection::HORIZONTAL, pPos.y)].erase(pPos.x);
+    mFullConPointLines[GridIndex::GetLineKey(WireDirection::VERTICAL, pPos.x)].erase(pPos.y);
+
+    // All wires passing the ConPoint were connected by it, so they share one group
+    GetWiresAt(pPos, mWireHits);
+
+    if (!mWireHits.empty())
+    {
+        Regroup(mWireGroups[mWireHits.front().wire]);
+    }
+}
+
+void ConnectivityModel::Clear()
+{
+    mWires.clear();
+    mWireGroups.clear();
+    mWirePositions.clear();
+    mGroupWires.clear();
+    mFreeGroups.clear();
+    mLines.clear();
+    mFullConPoints.clear();
+    mFullConPointLines.clear();
+    mVisitStamps.clear();
+    mVisitStamp = 0;
+}
+
+const std::vector<WireGeometry>& ConnectivityModel::GetWires() const
+{
+    return mWires;
+}
+
+uint32_t ConnectivityModel::GetWireGroup(uint32_t pWire) const
+{
+    Q_ASSERT(pWire < mWireGroups.size());
+    return mWireGroups[pWire];
+}
+
+uint32_t ConnectivityModel::GetGroupLimit() const
+{
+    return mGroupWires.size();
+}
+
+void ConnectivityModel::GetWiresAt(GridPoint pPos, std::vector<GridIndex::WireHit>& pHits) const
+{
+    pHits.clear();
+
+    CollectLineHits(GridIndex::GetLineKey(WireDirection::HORIZONTAL, pPos.y), pPos.x, pHits);
+    CollectLineHits(GridIndex::GetLineKey(WireDirection::VERTICAL, pPos.x), pPos.y, pHits);
+
+    std::sort(pHits.begin(), pHits.end(), [](const GridIndex::WireHit& pA, const GridIndex::WireHit& pB)
+    {
+        return (pA.wire > pB.wire);
+    });
+}
+
+void ConnectivityModel::CollectLineHits(uint64_t pLineKey, int32_t pCoordinate, std::vector<GridIndex::WireHit>& pHits) const
+{
+    const auto line = mLines.find(pLineKey);
+
+    if (line == mLines.end())
+    {
+        return;
+    }
+
+    // Only wires starting at most maxLength before the coordinate can reach it
+    const auto last = line->second.wires.upper_bound(pCoordinate);
+
+    for (auto entry = line->second.wires.lower_bound(pCoordinate - line->second.maxLength); entry != last; entry++)
+    {
+        int32_t start;
+        int32_t end;
+        GetSpan(mWires[entry->second], start, end);
+
+        if (GridIndex::IsPassing(start, end, pCoordinate))
+        {
+            pHits.push_back(GridIndex::WireHit{entry->second, pCoordinate == start || pCoordinate == end});
+        }
+    }
+}
+
+void ConnectivityModel::CollectNeighbours(uint32_t pWire)
+{
+    mNeighbours.clear();
+
+    const auto& wire = mWires[pWire];
+    const int32_t dx = (wire.direction == WireDirection::HORIZONTAL ? wire.length : 0);
+    const int32_t dy = (wire.direction == WireDirection::VERTICAL ? wire.length : 0);
+
+    // L-crossings: Perpendicular wires connect where an end point of both meets
+    for (const auto& endPoint : {wire.pos, GridPoint{wire.pos.x + dx, wire.pos.y + dy}})
+    {
+        GetWiresAt(endPoint, mWireHits);
+
+        for (const auto& hit : mWireHits)
+        {
+            if (hit.isEndPoint && mWires[hit.wire].direction != wire.direction)
+            {
+                mNeighbours.push_back(hit.wire);
+            }
+        }
+    }
+
+    // Full ConPoints connect all wires crossing them
+    const auto conPoints = mFullConPointLines.find(GetLineKey(wire));
+
+    if (conPoints == mFullConPointLines.end())
+    {
+        return;
+    }
+
+    int32_t start;
+    int32_t end;
+    GetSpan(wire, start, end);
+
+    for (auto coordinate = conPoints->second.lower_bound(start); coordinate != conPoints->second.end() && *coordinate <= end; coordinate++)
+    {
+        if (!GridIndex::IsPassing(start, end, *coordinate))
+        {
+            continue;
+        }
+
+        const auto pos = (wire.direction == WireDirection::HORIZONTAL ? GridPoint{*coordinate, wire.pos.y} : GridPoint{wire.pos.x, *coordinate});
+        GetWiresAt(pos, mWireHits);
+
+        for (const auto& hit : mWireHits)
+        {
+            if (hit.wire != pWire)
+            {
+                mNeighbours.push_back(hit.wire);
+            }
+        }
+    }
+}
+
+void ConnectivityModel::ReplaceLineEntry(const WireGeometry& pWire, uint32_t pOldIndex, uint32_t pNewIndex)
+{
+    int32_t start;
+    int32_t end;
+    GetSpan(pWire, start, end);
+
+    auto& line = mLines[GetLineKey(pWire)];
+    const auto entries = line.wires.equal_range(start);
+
+    for (auto entry = entries.first; entry != entries.second; entry++)
+    {
+        if (entry->second != pOldIndex)
+        {
+            continue;
+        }
+
+        if (pNewIndex == NO_WIRE)
+        {
+            line.wires.erase(entry);
+        }
+        else
+        {
+            entry->second = pNewIndex;
+        }
+
+        return;
+    }
+
+    Q_ASSERT(false);
+}
+
+uint32_t ConnectivityModel::CreateGroup()
+{
+    if (mFreeGroups.empty())
+    {
+        mGroupWires.emplace_back();
+        return mGroupWires.size() - 1;
+    }
+
+    const auto group = mFreeGroups.back();
+    mFreeGroups.pop_back();
+    return group;
+}
+
+void ConnectivityModel::MoveToGroup(uint32_t pWire, uint32_t pGroup)
+{
+    auto& oldWires = mGroupWires[mWireGroups[pWire]];
+    oldWires[mWirePositions[pWire]] = oldWires.back();
+    mWirePositions[oldWires.back()] = mWirePositions[pWire];
+    oldWires.pop_back();
+
+    mWireGroups[pWire] = pGroup;
+    mWirePositions[pWire] = mGroupWires[pGroup].size();
+    mGroupWires[pGroup].push_back(pWire);
+}
+
+void ConnectivityModel::MergeGroups(uint32_t pGroupA, uint32_t pGroupB)
+{
+    if (pGroupA == pGroupB)
+    {
+        return;
+    }
+
+    if (mGroupWires[pGroupA].size() < mGroupWires[pGroupB].size())
+    {
+        std::swap(pGroupA, pGroupB);
+    }
+
+    // Relabelling the smaller group keeps the total cost of all merges near-linear
+    while (!mGroupWires[pGroupB].empty())
+    {
+        MoveToGroup(mGroupWires[pGroupB].back(), pGroupA);
+    }
+
+    mFreeGroups.push_back(pGroupB);
+}
+
+void ConnectivityModel::Regroup(uint32_t pGroup)
+{
+    if (mGroupWires[pGroup].empty())
+    {
+        mFreeGroups.push_back(pGroup);
+        return;
+    }
+
+    mRegroupWires = mGroupWires[pGroup];
+    mVisitStamp++;
+
+    // The part connected to the first wire keeps the group, every other part gets a new one
+    uint32_t group = pGroup;
+
+    for (const auto& first : mRegroupWires)
+    {
+        if (mVisitStamps[first] == mVisitStamp)
+        {
+            continue;
+        }
+
+        mVisitStamps[first] = mVisitStamp;
+        mPendingWires.assign(1, first);
+
+        while (!mPendingWires.empty())
+        {
+            const auto wire = mPendingWires.back();
+            mPendingWires.pop_back();
+
+            if (group != pGroup)
+            {
+                MoveToGroup(wire, group);
+            }
+
+            CollectNeighbours(wire);
+
+            for (const auto& neighbour : mNeighbours)
+            {
+                if (mVisitStamps[neighbour] != mVisitStamp)
+                {
+                    mVisitStamps[neighbour] = mVisitStamp;
+                    mPendingWires.push_back(neighbour);
+                }
+            }
+        }
+
+        group = CreateGroup();
+    }
+
+    // The last group has been created for a part that does not exist
+    mFreeGroups.push_back(group);
+}
+
+void ConnectivityModel::GetSpan(const WireGeometry& pWire, int32_t& pStart, int32_t& pEnd)
+{
+    const int32_t start = (pWire.direction == WireDirection::HORIZONTAL ? pWire.pos.x : pWire.pos.y);
+    pStart = std::min(start, start + pWire.length);
+    pEnd = std::max(start, start + pWire.length);
+}
+
+uint64_t ConnectivityModel::GetLineKey(const WireGeometry& pWire)
+{
+    return GridIndex::GetLineKey(pWire.direction, pWire.direction == WireDirection::HORIZONTAL ? pWire.pos.y : pWire.pos.x);
+}
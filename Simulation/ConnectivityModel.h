@@ -0,0 +1,144 @@
+#ifndef CONNECTIVITYMODEL_H
+#define CONNECTIVITYMODEL_H
+
+#include "Simulation/CircuitGeometry.h"
+#include "Simulation/GridIndex.h"
+
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+///
+/// \brief The ConnectivityModel class keeps the wires of a circuit grouped while the circuit is edited
+/// Wires connect by L-crossings and full ConPoints under the same rules as in the NetlistExtractor.
+/// Adding a wire or ConPoint merges the groups it touches, removing one only regroups the group it belonged to.
+///
+class ConnectivityModel
+{
+public:
+    /// \brief Index of no wire
+    static constexpr uint32_t NO_WIRE = std::numeric_limits<uint32_t>::max();
+
+    /// \brief Constructor for ConnectivityModel
+    ConnectivityModel(void);
+
+    /// \brief Adds a wire and merges all groups it connects
+    /// \param pWire: The wire geometry
+    /// \return Index of the new wire, which is the previous wire count
+    uint32_t AddWire(const WireGeometry& pWire);
+
+    /// \brief Removes a wire and splits its group if necessary
+    /// The last wire takes over the index of the removed one
+    /// \param pWire: Index of the wire
+    void RemoveWire(uint32_t pWire);
+
+    /// \brief Adds a full ConPoint and merges the groups of all wires passing it
+    /// \param pPos: Scene position of the ConPoint
+    void AddFullConPoint(GridPoint pPos);
+
+    /// \brief Removes a full ConPoint and splits the group of the wires passing it if necessary
+    /// \param pPos: Scene position of the ConPoint
+    void RemoveFullConPoint(GridPoint pPos);
+
+    /// \brief Removes all wires and ConPoints
+    void Clear(void);
+
+    /// \brief Getter for all wires, in index order
+    /// \return The wire geometries
+    const std::vector<WireGeometry>& GetWires(void) const;
+
+    /// \brief Getter for the group of the given wire
+    /// Group numbers are reused after groups vanish and are not dense
+    /// \param pWire: Index of the wire
+    /// \return The group number, less than GetGroupLimit()
+    uint32_t GetWireGroup(uint32_t pWire) const;
+
+    /// \brief Getter for the upper bound of all group numbers
+    /// \return One past the largest group number in use
+    uint32_t GetGroupLimit(void) const;
+
+    /// \brief Getter for all wires passing the given point, ordered by descending wire index
+    /// \param pPos: The scene position
+    /// \param pHits: Vector to fill with the wires, previous contents are replaced
+    void GetWiresAt(GridPoint pPos, std::vector<GridIndex::WireHit>& pHits) const;
+
+protected:
+    /// \brief All wires on one grid line
+    struct Line
+    {
+        std::multimap<int32_t, uint32_t> wires; // Wire indices by start coordinate
+        int32_t maxLength = 0; // Upper bound of the length of all wires on the line
+    };
+
+    /// \brief Appends the wires passing the given coordinate of one grid line to pHits
+    /// \param pLineKey: Key of the grid line
+    /// \param pCoordinate: The coordinate along the line
+    /// \param pHits: Vector to append the wires to
+    void CollectLineHits(uint64_t pLineKey, int32_t pCoordinate, std::vector<GridIndex::WireHit>& pHits) const;
+
+    /// \brief Collects all wires directly connected to the given wire into mNeighbours
+    /// \param pWire: Index of the wire
+    void CollectNeighbours(uint32_t pWire);
+
+    /// \brief Replaces the wire index stored in the line of a wire
+    /// \param pWire: Geometry of the wire
+    /// \param pOldIndex: The stored index
+    /// \param pNewIndex: The new index, or NO_WIRE to remove the entry
+    void ReplaceLineEntry(const WireGeometry& pWire, uint32_t pOldIndex, uint32_t pNewIndex);
+
+    /// \brief Returns an unused group number
+    /// \return The group number
+    uint32_t CreateGroup(void);
+
+    /// \brief Moves a wire into another group
+    /// \param pWire: Index of the wire
+    /// \param pGroup: The target group
+    void MoveToGroup(uint32_t pWire, uint32_t pGroup);
+
+    /// \brief Merges the smaller of both groups into the larger one
+    /// \param pGroupA: The first group
+    /// \param pGroupB: The second group
+    void MergeGroups(uint32_t pGroupA, uint32_t pGroupB);
+
+    /// \brief Splits a group into its connected parts after a wire or ConPoint has been removed
+    /// \param pGroup: The group
+    void Regroup(uint32_t pGroup);
+
+    /// \brief Getter for the interval a wire spans along its grid line
+    /// \param pWire: The wire geometry
+    /// \param pStart: Set to the smaller end coordinate
+    /// \param pEnd: Set to the larger end coordinate
+    static void GetSpan(const WireGeometry& pWire, int32_t& pStart, int32_t& pEnd);
+
+    /// \brief Getter for the key of the grid line a wire lies on
+    /// \param pWire: The wire geometry
+    /// \return The line key
+    static uint64_t GetLineKey(const WireGeometry& pWire);
+
+protected:
+    std::vector<WireGeometry> mWires;
+    std::vector<uint32_t> mWireGroups; // Group of every wire
+    std::vector<uint32_t> mWirePositions; // Position of every wire in its group's wire list
+
+    std::vector<std::vector<uint32_t>> mGroupWires;
+    std::vector<uint32_t> mFreeGroups;
+
+    std::unordered_map<uint64_t, Line> mLines;
+
+    // Number of full ConPoints per point, and the points on every grid line for queries along a wire
+    std::unordered_map<uint64_t, uint32_t> mFullConPoints;
+    std::unordered_map<uint64_t, std::set<int32_t>> mFullConPointLines;
+
+    // Buffers reused between edits
+    std::vector<GridIndex::WireHit> mWireHits;
+    std::vector<uint32_t> mNeighbours;
+    std::vector<uint32_t> mRegroupWires;
+    std::vector<uint32_t> mPendingWires;
+    std::vector<uint32_t> mVisitStamps;
+    uint32_t mVisitStamp;
+};
+
+#endif // CONNECTIVITYMODEL_H
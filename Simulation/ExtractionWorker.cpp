@@ -0,0 +1,36 @@
+#include "ExtractionWorker.h"
+
+constexpr uint32_t ExtractionWorker::NO_JOB;
+
+ExtractionWorker::ExtractionWorker():
+    mCancelledJob(NO_JOB)
+{}
+
+void ExtractionWorker::Extract(uint32_t pJob, const CircuitGeometry& pGeometry, const ConnectivityModel& pConnectivity)
+{
+    uint8_t lastPercent = 0;
+    emit ProgressChangedSignal(pJob, lastPercent);
+
+    const bool isFinished = mExtractor.Extract(pGeometry, pConnectivity, [this, pJob, &lastPercent](uint8_t pPercent)
+    {
+        if (pPercent != lastPercent)
+        {
+            lastPercent = pPercent;
+            emit ProgressChangedSignal(pJob, pPercent);
+        }
+
+        return (mCancelledJob.load(std::memory_order_relaxed) != pJob);
+    });
+
+    emit ExtractionFinishedSignal(pJob, !isFinished);
+}
+
+void ExtractionWorker::Cancel(uint32_t pJob)
+{
+    mCancelledJob.store(pJob, std::memory_order_relaxed);
+}
+
+const NetlistExtractor& ExtractionWorker::GetExtractor() const
+{
+    return mExtractor;
+}
@@ -0,0 +1,57 @@
+#ifndef EXTRACTIONWORKER_H
+#define EXTRACTIONWORKER_H
+
+#include "Simulation/CircuitGeometry.h"
+#include "Simulation/NetlistExtractor.h"
+
+#include <QObject>
+#include <atomic>
+
+///
+/// \brief The ExtractionWorker class extracts netlists on its own thread
+/// Every extraction is tagged with a job number, so results of cancelled or superseded jobs can be told apart.
+/// Extract must be invoked in the worker's thread, Cancel is thread safe.
+///
+class ExtractionWorker : public QObject
+{
+    Q_OBJECT
+public:
+    /// \brief Job number that never belongs to an extraction
+    static constexpr uint32_t NO_JOB = 0;
+
+    /// \brief Constructor for ExtractionWorker
+    ExtractionWorker(void);
+
+    /// \brief Extracts the netlist of the given geometry and emits ExtractionFinishedSignal
+    /// \param pJob: The job number, passed back in all signals of this extraction
+    /// \param pGeometry: Snapshot of the circuit geometry to extract, its wires must be those of pConnectivity
+    /// \param pConnectivity: Wire groups of the circuit, must not be modified until the extraction has finished
+    void Extract(uint32_t pJob, const CircuitGeometry& pGeometry, const ConnectivityModel& pConnectivity);
+
+    /// \brief Requests the given extraction to stop as soon as possible, thread safe
+    /// \param pJob: The job number of the extraction to cancel
+    void Cancel(uint32_t pJob);
+
+    /// \brief Getter for the extractor holding the result of the last finished extraction
+    /// Must only be accessed while no extraction is running
+    /// \return Reference to the extractor
+    const NetlistExtractor& GetExtractor(void) const;
+
+signals:
+    /// \brief Emitted when the progress of an extraction changed
+    /// \param pJob: The job number of the extraction
+    /// \param pPercent: The progress in percent
+    void ProgressChangedSignal(uint32_t pJob, uint8_t pPercent);
+
+    /// \brief Emitted when an extraction has been finished or cancelled
+    /// \param pJob: The job number of the extraction
+    /// \param pIsCancelled: True, if the extraction has been cancelled and the result is incomplete
+    void ExtractionFinishedSignal(uint32_t pJob, bool pIsCancelled);
+
+protected:
+    NetlistExtractor mExtractor;
+
+    std::atomic<uint32_t> mCancelledJob;
+};
+
+#endif // EXTRACTIONWORKER_H
@@ -0,0 +1,133 @@
+#include "GridIndex.h"
+#include "Configuration.h"
+
+#include <QtGlobal>
+
+#include <algorithm>
+
+GridIndex::GridIndex()
+{}
+
+void GridIndex::Build(const CircuitGeometry& pGeometry)
+{
+    Clear();
+
+    mSortBuffer.reserve(pGeometry.wires.size());
+
+    for (uint32_t wire = 0; wire < pGeometry.wires.size(); wire++)
+    {
+        const auto& geometry = pGeometry.wires[wire];
+        const bool isHorizontal = (geometry.direction == WireDirection::HORIZONTAL);
+        const int32_t start = (isHorizontal ? geometry.pos.x : geometry.pos.y);
+        const int32_t end = start + geometry.length;
+
+        mSortBuffer.emplace_back(GetLineKey(geometry.direction, isHorizontal ? geometry.pos.y : geometry.pos.x),
+                                 Segment{std::min(start, end), std::max(start, end), 0, wire});
+    }
+
+    std::sort(mSortBuffer.begin(), mSortBuffer.end(), [](const std::pair<uint64_t, Segment>& pA, const std::pair<uint64_t, Segment>& pB)
+    {
+        return (pA.first != pB.first ? pA.first < pB.first : pA.second.start < pB.second.start);
+    });
+
+    mSegments.reserve(mSortBuffer.size());
+
+    for (const auto& entry : mSortBuffer)
+    {
+        auto segment = entry.second;
+        auto range = mLineRanges.find(entry.first);
+
+        if (range == mLineRanges.end())
+        {
+            range = mLineRanges.emplace(entry.first, LineRange{static_cast<uint32_t>(mSegments.size()), 0}).first;
+            segment.maxEnd = segment.end;
+        }
+        else
+        {
+            segment.maxEnd = std::max(segment.end, mSegments.back().maxEnd);
+        }
+
+        mSegments.push_back(segment);
+        range->second.last = mSegments.size();
+    }
+
+    mSortBuffer.clear();
+
+    for (const auto& conPoint : pGeometry.conPoints)
+    {
+        if (conPoint.type == ConnectionType::FULL)
+        {
+            mFullConPoints.insert(GetPointKey(conPoint.pos));
+        }
+    }
+}
+
+void GridIndex::Clear()
+{
+    mSegments.clear();
+    mLineRanges.clear();
+    mFullConPoints.clear();
+}
+
+void GridIndex::GetWiresAt(GridPoint pPos, std::vector<WireHit>& pHits) const
+{
+    pHits.clear();
+
+    CollectLineHits(GetLineKey(WireDirection::HORIZONTAL, pPos.y), pPos.x, pHits);
+    CollectLineHits(GetLineKey(WireDirection::VERTICAL, pPos.x), pPos.y, pHits);
+
+    // Callers pick the first wire of a point, so keep the order independent of the segment layout
+    std::sort(pHits.begin(), pHits.end(), [](const WireHit& pA, const WireHit& pB)
+    {
+        return (pA.wire > pB.wire);
+    });
+}
+
+bool GridIndex::HasFullConPoint(GridPoint pPos) const
+{
+    return (mFullConPoints.find(GetPointKey(pPos)) != mFullConPoints.end());
+}
+
+void GridIndex::CollectLineHits(uint64_t pLineKey, int32_t pCoordinate, std::vector<WireHit>& pHits) const
+{
+    const auto range = mLineRanges.find(pLineKey);
+
+    if (range == mLineRanges.end())
+    {
+        return;
+    }
+
+    const auto first = mSegments.begin() + range->second.first;
+    auto segment = std::upper_bound(first, mSegments.begin() + range->second.last, pCoordinate, [](int32_t pCoord, const Segment& pSegment)
+    {
+        return (pCoord < pSegment.start);
+    });
+
+    // Walk back over all segments starting at or before the coordinate, until none of them can reach it anymore
+    while (segment != first && (segment - 1)->maxEnd >= pCoordinate)
+    {
+        segment--;
+
+        if (IsPassing(segment->start, segment->end, pCoordinate))
+        {
+            pHits.push_back(WireHit{segment->wire, pCoordinate == segment->start || pCoordinate == segment->end});
+        }
+    }
+}
+
+bool GridIndex::IsPassing(int32_t pStart, int32_t pEnd, int32_t pCoordinate)
+{
+    // The end point is always passed, even for lengths that are no multiple of the grid size
+    return (pCoordinate >= pStart && pCoordinate <= pEnd && ((pCoordinate - pStart) % canvas::GRID_SIZE == 0 || pCoordinate == pEnd));
+}
+
+uint64_t GridIndex::GetLineKey(WireDirection pDirection, int32_t pCoordinate)
+{
+    const uint64_t isVertical = (pDirection == WireDirection::HORIZONTAL ? 0 : 1);
+    return (isVertical << 32) | static_cast<uint32_t>(pCoordinate);
+}
+
+uint64_t GridIndex::GetPointKey(GridPoint pPos)
+{
+    return (static_cast<uint64_t>(static_cast<uint32_t>(pPos.x)) << 32) | static_cast<uint32_t>(pPos.y);
+}
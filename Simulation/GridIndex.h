@@ -0,0 +1,98 @@
+#ifndef GRIDINDEX_H
+#define GRIDINDEX_H
+
+#include "Simulation/CircuitGeometry.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+///
+/// \brief The GridIndex class maps grid points to the wires passing them and the ConPoints on them
+/// Every wire is stored once as a segment on its grid line, so the index grows with the number of wires, not their length
+///
+class GridIndex
+{
+public:
+    /// \brief A wire passing a queried grid point
+    struct WireHit
+    {
+        uint32_t wire; // Index of the wire in the geometry
+        bool isEndPoint; // True, if the grid point is an end point of the wire
+    };
+
+    /// \brief Constructor for GridIndex
+    GridIndex(void);
+
+    /// \brief Indexes all wires and ConPoints of the given geometry, replacing the previous index
+    /// \param pGeometry: The circuit geometry
+    void Build(const CircuitGeometry& pGeometry);
+
+    /// \brief Releases the index
+    void Clear(void);
+
+    /// \brief Getter for all wires passing the given point, ordered by descending wire index
+    /// A wire passes a point, if the point is one of its end points or lies on the grid of the wire
+    /// \param pPos: The scene position
+    /// \param pHits: Vector to fill with the wires, previous contents are replaced
+    void GetWiresAt(GridPoint pPos, std::vector<WireHit>& pHits) const;
+
+    /// \brief Returns true, if there is a full ConPoint at the given position
+    /// \param pPos: The scene position
+    /// \return True, if a full ConPoint exists at pPos
+    bool HasFullConPoint(GridPoint pPos) const;
+
+    /// \brief Returns true, if a wire spanning [pStart, pEnd] along its grid line passes the given coordinate
+    /// \param pStart: The smaller end coordinate of the wire
+    /// \param pEnd: The larger end coordinate of the wire
+    /// \param pCoordinate: The coordinate along the same line
+    /// \return True, if pCoordinate is an end point or lies on the grid of the wire
+    static bool IsPassing(int32_t pStart, int32_t pEnd, int32_t pCoordinate);
+
+    /// \brief Packs a wire direction and the fixed coordinate of its grid line into a hash key
+    /// \param pDirection: The wire direction, everything but HORIZONTAL is treated as vertical
+    /// \param pCoordinate: The y coordinate of horizontal lines, the x coordinate of vertical lines
+    /// \return The key
+    static uint64_t GetLineKey(WireDirection pDirection, int32_t pCoordinate);
+
+    /// \brief Packs a point into a hash key
+    /// \param pPos: The scene position
+    /// \return The key
+    static uint64_t GetPointKey(GridPoint pPos);
+
+protected:
+    /// \brief A wire as the interval [start, end] along its grid line
+    struct Segment
+    {
+        int32_t start;
+        int32_t end;
+        int32_t maxEnd; // Largest end of this and all previous segments on the same line
+        uint32_t wire;
+    };
+
+    /// \brief Range of the segments of one grid line in mSegments
+    struct LineRange
+    {
+        uint32_t first;
+        uint32_t last; // One past the last segment
+    };
+
+    /// \brief Collects the wires of one grid line passing the given coordinate along that line
+    /// \param pLineKey: Key of the grid line
+    /// \param pCoordinate: The coordinate along the line
+    /// \param pHits: Vector to append the wires to
+    void CollectLineHits(uint64_t pLineKey, int32_t pCoordinate, std::vector<WireHit>& pHits) const;
+
+protected:
+    // Segments sorted by line and start, each line is a contiguous range
+    std::vector<Segment> mSegments;
+    std::unordered_map<uint64_t, LineRange> mLineRanges;
+
+    std::unordered_set<uint64_t> mFullConPoints;
+
+    std::vector<std::pair<uint64_t, Segment>> mSortBuffer;
+};
+
+#endif // GRIDINDEX_H
@@ -0,0 +1,89 @@
+#ifndef NETLIST_H
+#define NETLIST_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+/// \brief CellKernel identifies the logic function the simulation engine evaluates for a cell
+enum class CellKernel : uint8_t
+{
+    WIRE = 0,
+    DIODE,
+    AND_GATE,
+    OR_GATE,
+    XOR_GATE,
+    BUFFER_GATE, // NOT gates are buffers with an inverted output
+    INPUT,
+    CONSTANT,
+    BUTTON,
+    CLOCK,
+    OUTPUT,
+    HALF_ADDER,
+    FULL_ADDER,
+    RS_FLIPFLOP,
+    RS_CLOCKED_FLIPFLOP,
+    RS_MS_FLIPFLOP,
+    D_FLIPFLOP,
+    D_MS_FLIPFLOP,
+    T_FLIPFLOP,
+    JK_FLIPFLOP,
+    JK_MS_FLIPFLOP,
+    MULTIPLEXER,
+    DEMULTIPLEXER,
+    DECODER,
+    ENCODER,
+    SHIFTREGISTER,
+    COUNTER
+};
+
+/// \brief Default propagation delay, the ticks from an input change until the outputs of a cell are updated
+constexpr uint32_t DEFAULT_CELL_DELAY = 2;
+
+/// \brief Upper bound of the propagation delay of a cell
+constexpr uint32_t MAX_CELL_DELAY = 1 << 16;
+
+/// \brief Limits a propagation delay read from a circuit file to the valid range
+/// \param pDelay: The delay in ticks
+/// \return The delay, between 1 and MAX_CELL_DELAY
+inline uint32_t ClampCellDelay(int64_t pDelay)
+{
+    return static_cast<uint32_t>(std::min<int64_t>(std::max<int64_t>(pDelay, 1), MAX_CELL_DELAY));
+}
+
+/// \brief Kernel parameters for cells whose behaviour is not determined by their inputs alone
+struct CellParameters
+{
+    uint32_t delay = DEFAULT_CELL_DELAY; // Propagation delay in ticks, at least 1
+    uint32_t toggleTicks = 0; // Clock toggle speed or button hold duration
+    uint32_t pulseTicks = 0; // Clock pulse duration
+    bool pulseMode = false; // Clock mode, true for pulse, false for toggle
+    bool constantState = false; // Output state of constants
+};
+
+/// \brief A single cell of the netlist as handed over to the simulation engine
+struct NetlistCell
+{
+    CellKernel kernel = CellKernel::WIRE;
+    std::vector<bool> inputInverted;
+    std::vector<bool> outputInverted;
+    CellParameters parameters;
+};
+
+/// \brief A connection from an output of one netlist cell to an input of another
+struct NetlistConnection
+{
+    uint32_t sourceCell;
+    uint32_t sourceOutput;
+    uint32_t targetCell;
+    uint32_t targetInput;
+};
+
+/// \brief A circuit in the flat form the simulation engine compiles
+struct Netlist
+{
+    std::vector<NetlistCell> cells;
+    std::vector<NetlistConnection> connections;
+};
+
+#endif // NETLIST_H
@@ -0,0 +1,389 @@
+#include "NetlistExtractor.h"
+
+#include <QtGlobal>
+#include <algorithm>
+
+namespace
+{
+constexpr uint32_t PROGRESS_REPORT_ITEMS = 4096; // Items processed between two progress reports
+}
+
+constexpr uint32_t NetlistExtractor::NO_CELL;
+
+NetlistExtractor::NetlistExtractor():
+    mConnectivity(nullptr),
+    mWireGroupCount(0),
+    mFirstWireCell(0),
+    mProgressItemCount(0),
+    mProcessedItemCount(0),
+    mNextProgressReport(0)
+{}
+
+bool NetlistExtractor::Extract(const CircuitGeometry& pGeometry, const ProgressCallback& pProgressCallback)
+{
+    mConnectivity = nullptr;
+
+    // Every wire is processed twice (indexing and grouping), every component and ConPoint once when connecting
+    if (!StartExtraction(pGeometry, 2 * pGeometry.wires.size(), pProgressCallback))
+    {
+        return false;
+    }
+
+    mGridIndex.Build(pGeometry);
+
+    if (!AdvanceProgress(pGeometry.wires.size()) || !GroupWires(pGeometry))
+    {
+        return false;
+    }
+
+    return ConnectPins(pGeometry);
+}
+
+bool NetlistExtractor::Extract(const CircuitGeometry& pGeometry, const ConnectivityModel& pConnectivity, const ProgressCallback& pProgressCallback)
+{
+    Q_ASSERT(pGeometry.wires.size() == pConnectivity.GetWires().size());
+
+    mConnectivity = &pConnectivity;
+    mGridIndex.Clear();
+
+    if (!StartExtraction(pGeometry, 0, pProgressCallback))
+    {
+        return false;
+    }
+
+    NumberWireGroups(pConnectivity);
+    return ConnectPins(pGeometry);
+}
+
+bool NetlistExtractor::StartExtraction(const CircuitGeometry& pGeometry, uint64_t pWireItems, const ProgressCallback& pProgressCallback)
+{
+    mNetlist = Netlist();
+    mComponentCells.clear();
+    mConPointCells.assign(pGeometry.conPoints.size(), NO_CELL);
+
+    mProgressCallback = pProgressCallback;
+    mProgressItemCount = std::max<uint64_t>(pWireItems + pGeometry.components.size() + pGeometry.conPoints.size(), 1);
+    mProcessedItemCount = 0;
+    mNextProgressReport = 0;
+
+    return AdvanceProgress(0);
+}
+
+bool NetlistExtractor::ConnectPins(const CircuitGeometry& pGeometry)
+{
+    for (const auto& component : pGeometry.components)
+    {
+        mComponentCells.push_back(mNetlist.cells.size());
+        mNetlist.cells.push_back(component.cell);
+    }
+
+    for (uint32_t conPoint = 0; conPoint < pGeometry.conPoints.size(); conPoint++)
+    {
+        if (pGeometry.conPoints[conPoint].type != ConnectionType::FULL)
+        {
+            NetlistCell diode;
+            diode.kernel = CellKernel::DIODE;
+            diode.inputInverted = std::vector<bool>{false};
+            diode.outputInverted = std::vector<bool>{false};
+
+            mConPointCells[conPoint] = mNetlist.cells.size();
+            mNetlist.cells.push_back(diode);
+        }
+    }
+
+    // Wire cells have a single output that fans out to all connected inputs, their inputs are added per driver
+    mFirstWireCell = mNetlist.cells.size();
+    for (uint32_t group = 0; group < mWireGroupCount; group++)
+    {
+        NetlistCell wire;
+        wire.kernel = CellKernel::WIRE;
+        wire.outputInverted = std::vector<bool>{false};
+        mNetlist.cells.push_back(wire);
+    }
+
+    for (uint32_t component = 0; component < pGeometry.components.size(); component++)
+    {
+        const auto& geometry = pGeometry.components[component];
+
+        for (const auto& output : geometry.outputs)
+        {
+            ConnectOutputToWires(pGeometry, output.pos, mComponentCells[component], output.number, WireDirection::UNSET);
+        }
+
+        for (const auto& input : geometry.inputs)
+        {
+            ConnectWiresToInput(pGeometry, input.pos, mComponentCells[component], input.number, WireDirection::UNSET);
+        }
+
+        if (!AdvanceProgress(1))
+        {
+            return false;
+        }
+    }
+
+    for (uint32_t conPoint = 0; conPoint < pGeometry.conPoints.size(); conPoint++)
+    {
+        const auto& geometry = pGeometry.conPoints[conPoint];
+
+        if (geometry.type == ConnectionType::FULL)
+        {
+            // Full ConPoints belong to the group of the wires below
+            FindWiresAt(geometry.pos);
+            if (!mWireHits.empty())
+            {
+                mConPointCells[conPoint] = GetWireCell(mWireHits.front().wire);
+            }
+        }
+        else
+        {
+            // Diode <-> Wire connection
+            const auto outputDirection = (geometry.type == ConnectionType::DIODE_X ? WireDirection::HORIZONTAL : WireDirection::VERTICAL);
+            const auto inputDirection = (geometry.type == ConnectionType::DIODE_X ? WireDirection::VERTICAL : WireDirection::HORIZONTAL);
+
+            ConnectOutputToWires(pGeometry, geometry.pos, mConPointCells[conPoint], 0, outputDirection);
+            ConnectWiresToInput(pGeometry, geometry.pos, mConPointCells[conPoint], 0, inputDirection);
+        }
+
+        if (!AdvanceProgress(1))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+const Netlist& NetlistExtractor::GetNetlist() const
+{
+    return mNetlist;
+}
+
+uint32_t NetlistExtractor::GetComponentCell(uint32_t pComponent) const
+{
+    Q_ASSERT(pComponent < mComponentCells.size());
+    return mComponentCells[pComponent];
+}
+
+uint32_t NetlistExtractor::GetWireCell(uint32_t pWire) const
+{
+    Q_ASSERT(pWire < mWireGroups.size());
+    return mFirstWireCell + mWireGroups[pWire];
+}
+
+uint32_t NetlistExtractor::GetConPointCell(uint32_t pConPoint) const
+{
+    Q_ASSERT(pConPoint < mConPointCells.size());
+    return mConPointCells[pConPoint];
+}
+
+uint32_t NetlistExtractor::GetWireGroupCount() const
+{
+    return mWireGroupCount;
+}
+
+bool NetlistExtractor::GroupWires(const CircuitGeometry& pGeometry)
+{
+    mWireParents.resize(pGeometry.wires.size());
+    mWireGroupSizes.assign(pGeometry.wires.size(), 1);
+
+    for (uint32_t wire = 0; wire < pGeometry.wires.size(); wire++)
+    {
+        mWireParents[wire] = wire;
+    }
+
+    // L-crossings: Perpendicular wires connect where an end point of both meets
+    for (uint32_t wire = 0; wire < pGeometry.wires.size(); wire++)
+    {
+        const auto& geometry = pGeometry.wires[wire];
+        const int32_t dx = (geometry.direction == WireDirection::HORIZONTAL ? geometry.length : 0);
+        const int32_t dy = (geometry.direction == WireDirection::VERTICAL ? geometry.length : 0);
+
+        for (const auto& endPoint : {geometry.pos, GridPoint{geometry.pos.x + dx, geometry.pos.y + dy}})
+        {
+            FindWiresAt(endPoint);
+
+            for (const auto& other : mWireHits)
+            {
+                // Parallel wires are merged when edited and never connect
+                if (other.isEndPoint && pGeometry.wires[other.wire].direction != geometry.direction)
+                {
+                    UniteWires(wire, other.wire);
+                }
+            }
+        }
+
+        if (!AdvanceProgress(1))
+        {
+            return false;
+        }
+    }
+
+    // Full ConPoints connect all perpendicular wires crossing them
+    for (const auto& conPoint : pGeometry.conPoints)
+    {
+        if (conPoint.type != ConnectionType::FULL)
+        {
+            continue;
+        }
+
+        uint32_t horizontalWire = NO_CELL;
+        uint32_t verticalWire = NO_CELL;
+
+        FindWiresAt(conPoint.pos);
+
+        for (const auto& hit : mWireHits)
+        {
+            const auto wire = hit.wire;
+            auto& first = (pGeometry.wires[wire].direction == WireDirection::HORIZONTAL ? horizontalWire : verticalWire);
+
+            if (first == NO_CELL)
+            {
+                first = wire;
+            }
+            else
+            {
+                UniteWires(first, wire);
+            }
+        }
+
+        if (horizontalWire != NO_CELL && verticalWire != NO_CELL)
+        {
+            UniteWires(horizontalWire, verticalWire);
+        }
+    }
+
+    // Number the groups in order of their first wire, so the cell order doesn't depend on the union order
+    mWireGroups.assign(pGeometry.wires.size(), NO_CELL);
+    mWireGroupCount = 0;
+
+    for (uint32_t wire = 0; wire < pGeometry.wires.size(); wire++)
+    {
+        const auto root = FindWireRoot(wire);
+
+        if (mWireGroups[root] == NO_CELL)
+        {
+            mWireGroups[root] = mWireGroupCount++;
+        }
+
+        mWireGroups[wire] = mWireGroups[root];
+    }
+
+    return true;
+}
+
+void NetlistExtractor::NumberWireGroups(const ConnectivityModel& pConnectivity)
+{
+    const uint32_t wireCount = pConnectivity.GetWires().size();
+
+    mModelGroupNumbers.assign(pConnectivity.GetGroupLimit(), NO_CELL);
+    mWireGroups.resize(wireCount);
+    mWireGroupCount = 0;
+
+    for (uint32_t wire = 0; wire < wireCount; wire++)
+    {
+        auto& number = mModelGroupNumbers[pConnectivity.GetWireGroup(wire)];
+
+        if (number == NO_CELL)
+        {
+            number = mWireGroupCount++;
+        }
+
+        mWireGroups[wire] = number;
+    }
+}
+
+uint32_t NetlistExtractor::FindWireRoot(uint32_t pWire)
+{
+    // Path halving keeps the trees flat without recursion
+    while (mWireParents[pWire] != pWire)
+    {
+        mWireParents[pWire] = mWireParents[mWireParents[pWire]];
+        pWire = mWireParents[pWire];
+    }
+
+    return pWire;
+}
+
+void NetlistExtractor::UniteWires(uint32_t pWireA, uint32_t pWireB)
+{
+    auto rootA = FindWireRoot(pWireA);
+    auto rootB = FindWireRoot(pWireB);
+
+    if (rootA == rootB)
+    {
+        return;
+    }
+
+    if (mWireGroupSizes[rootA] < mWireGroupSizes[rootB])
+    {
+        std::swap(rootA, rootB);
+    }
+
+    mWireParents[rootB] = rootA;
+    mWireGroupSizes[rootA] += mWireGroupSizes[rootB];
+}
+
+void NetlistExtractor::ConnectOutputToWires(const CircuitGeometry& pGeometry, GridPoint pPos, uint32_t pCell, uint32_t pOutput, WireDirection pDirection)
+{
+    CollectWireCellsAt(pGeometry, pPos, pDirection);
+
+    for (const auto& wireCell : mTouchedCells)
+    {
+        auto& inputs = mNetlist.cells[wireCell].inputInverted;
+        inputs.push_back(false);
+        mNetlist.connections.push_back(NetlistConnection{pCell, pOutput, wireCell, static_cast<uint32_t>(inputs.size() - 1)});
+    }
+}
+
+void NetlistExtractor::ConnectWiresToInput(const CircuitGeometry& pGeometry, GridPoint pPos, uint32_t pCell, uint32_t pInput, WireDirection pDirection)
+{
+    CollectWireCellsAt(pGeometry, pPos, pDirection);
+
+    for (const auto& wireCell : mTouchedCells)
+    {
+        mNetlist.connections.push_back(NetlistConnection{wireCell, 0, pCell, pInput});
+    }
+}
+
+void NetlistExtractor::FindWiresAt(GridPoint pPos)
+{
+    if (nullptr != mConnectivity)
+    {
+        mConnectivity->GetWiresAt(pPos, mWireHits);
+    }
+    else
+    {
+        mGridIndex.GetWiresAt(pPos, mWireHits);
+    }
+}
+
+void NetlistExtractor::CollectWireCellsAt(const CircuitGeometry& pGeometry, GridPoint pPos, WireDirection pDirection)
+{
+    mTouchedCells.clear();
+
+    FindWiresAt(pPos);
+
+    for (const auto& hit : mWireHits)
+    {
+        const auto wire = hit.wire;
+
+        if ((pDirection == WireDirection::UNSET || pGeometry.wires[wire].direction == pDirection)
+                && std::find(mTouchedCells.begin(), mTouchedCells.end(), GetWireCell(wire)) == mTouchedCells.end())
+        {
+            mTouchedCells.push_back(GetWireCell(wire));
+        }
+    }
+}
+
+bool NetlistExtractor::AdvanceProgress(uint32_t pItems)
+{
+    mProcessedItemCount += pItems;
+
+    if (!mProgressCallback || mProcessedItemCount < mNextProgressReport)
+    {
+        return true;
+    }
+
+    mNextProgressReport = mProcessedItemCount + PROGRESS_REPORT_ITEMS;
+    return mProgressCallback(static_cast<uint8_t>(std::min<uint64_t>(mProcessedItemCount * 100 / mProgressItemCount, 100)));
+}
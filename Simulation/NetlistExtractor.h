@@ -0,0 +1,165 @@
+#ifndef NETLISTEXTRACTOR_H
+#define NETLISTEXTRACTOR_H
+
+#include "Simulation/CircuitGeometry.h"
+#include "Simulation/ConnectivityModel.h"
+#include "Simulation/GridIndex.h"
+#include "Simulation/Netlist.h"
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <vector>
+
+///
+/// \brief The NetlistExtractor derives the netlist of a circuit purely from its geometry
+/// Connected wires are merged into one wire cell, pins connect to all wires they lie on
+/// All geometric queries are answered by a grid index of wire segments, so extraction time does not depend on wire lengths
+///
+class NetlistExtractor
+{
+public:
+    /// \brief Cell index of geometry that has no logic cell, like full ConPoints
+    static constexpr uint32_t NO_CELL = std::numeric_limits<uint32_t>::max();
+
+    /// \brief Receives the extraction progress in percent, returning false cancels the extraction
+    using ProgressCallback = std::function<bool(uint8_t)>;
+
+    /// \brief Constructor for NetlistExtractor
+    NetlistExtractor(void);
+
+    /// \brief Extracts the netlist of the given geometry, replacing any previously extracted netlist
+    /// Components get the cell indices [0, component count), followed by diodes and wire groups
+    /// \param pGeometry: The circuit geometry
+    /// \param pProgressCallback: Optional callback, invoked periodically with the progress
+    /// \return False, if the extraction has been cancelled and the netlist is incomplete
+    bool Extract(const CircuitGeometry& pGeometry, const ProgressCallback& pProgressCallback = ProgressCallback());
+
+    /// \brief Extracts the netlist with the wire groups of a connectivity model that is kept up to date while editing
+    /// Wires are neither indexed nor grouped again, only the pins of components and ConPoints are looked up
+    /// \param pGeometry: The circuit geometry, its wires must be the wires of pConnectivity in the same order
+    /// \param pConnectivity: The connectivity model, must not be modified during the extraction
+    /// \param pProgressCallback: Optional callback, invoked periodically with the progress
+    /// \return False, if the extraction has been cancelled and the netlist is incomplete
+    bool Extract(const CircuitGeometry& pGeometry, const ConnectivityModel& pConnectivity, const ProgressCallback& pProgressCallback = ProgressCallback());
+
+    /// \brief Getter for the extracted netlist
+    /// \return The netlist
+    const Netlist& GetNetlist(void) const;
+
+    /// \brief Getter for the cell index of the given component
+    /// \param pComponent: Index of the component in the geometry
+    /// \return The cell index
+    uint32_t GetComponentCell(uint32_t pComponent) const;
+
+    /// \brief Getter for the cell index of the wire group the given wire belongs to
+    /// \param pWire: Index of the wire in the geometry
+    /// \return The cell index
+    uint32_t GetWireCell(uint32_t pWire) const;
+
+    /// \brief Getter for the cell index of the given ConPoint
+    /// \param pConPoint: Index of the ConPoint in the geometry
+    /// \return The cell index of the diode, the wire group cell for full ConPoints on a wire or NO_CELL
+    uint32_t GetConPointCell(uint32_t pConPoint) const;
+
+    /// \brief Getter for the number of wire groups
+    /// \return The number of wire groups
+    uint32_t GetWireGroupCount(void) const;
+
+protected:
+    /// \brief Resets the netlist and the progress of a new extraction
+    /// \param pGeometry: The circuit geometry
+    /// \param pWireItems: The number of progress items spent on indexing and grouping wires
+    /// \param pProgressCallback: The progress callback
+    /// \return False, if the extraction has been cancelled
+    bool StartExtraction(const CircuitGeometry& pGeometry, uint64_t pWireItems, const ProgressCallback& pProgressCallback);
+
+    /// \brief Creates all cells and connects the pins of components and ConPoints to the wire groups
+    /// \param pGeometry: The circuit geometry
+    /// \return False, if the extraction has been cancelled
+    bool ConnectPins(const CircuitGeometry& pGeometry);
+
+    /// \brief Sorts all wires into groups of wires that are connected by full ConPoints or L-crossings
+    /// Uses a disjoint-set over all junctions, so the run time is near-linear and the stack depth is constant
+    /// \param pGeometry: The circuit geometry
+    /// \return False, if the extraction has been cancelled
+    bool GroupWires(const CircuitGeometry& pGeometry);
+
+    /// \brief Numbers the groups of a connectivity model in order of their first wire
+    /// \param pConnectivity: The connectivity model
+    void NumberWireGroups(const ConnectivityModel& pConnectivity);
+
+    /// \brief Finds the representative wire of the set containing the given wire
+    /// \param pWire: Index of the wire in the geometry
+    /// \return Index of the representative wire
+    uint32_t FindWireRoot(uint32_t pWire);
+
+    /// \brief Merges the sets of the given wires
+    /// \param pWireA: Index of the first wire
+    /// \param pWireB: Index of the second wire
+    void UniteWires(uint32_t pWireA, uint32_t pWireB);
+
+    /// \brief Connects the given output of a cell to all wire groups of the wires below pPos
+    /// \param pGeometry: The circuit geometry
+    /// \param pPos: Scene position of the output
+    /// \param pCell: The cell index
+    /// \param pOutput: The output number
+    /// \param pDirection: Only wires in this direction are connected, UNSET for all wires
+    void ConnectOutputToWires(const CircuitGeometry& pGeometry, GridPoint pPos, uint32_t pCell, uint32_t pOutput, WireDirection pDirection);
+
+    /// \brief Connects all wire groups of the wires below pPos to the given input of a cell
+    /// \param pGeometry: The circuit geometry
+    /// \param pPos: Scene position of the input
+    /// \param pCell: The cell index
+    /// \param pInput: The input number
+    /// \param pDirection: Only wires in this direction are connected, UNSET for all wires
+    void ConnectWiresToInput(const CircuitGeometry& pGeometry, GridPoint pPos, uint32_t pCell, uint32_t pInput, WireDirection pDirection);
+
+    /// \brief Collects all wires passing pPos into mWireHits, from the connectivity model if one is used
+    /// \param pPos: The scene position
+    void FindWiresAt(GridPoint pPos);
+
+    /// \brief Collects the distinct wire group cells of all wires below pPos into mTouchedCells
+    /// \param pGeometry: The circuit geometry
+    /// \param pPos: The scene position
+    /// \param pDirection: Only wires in this direction are collected, UNSET for all wires
+    void CollectWireCellsAt(const CircuitGeometry& pGeometry, GridPoint pPos, WireDirection pDirection);
+
+    /// \brief Advances the progress by the given number of processed items and reports it if due
+    /// \param pItems: The number of items processed since the last call
+    /// \return False, if the progress callback requested to cancel
+    bool AdvanceProgress(uint32_t pItems);
+
+protected:
+    Netlist mNetlist;
+    GridIndex mGridIndex;
+    const ConnectivityModel* mConnectivity; // Connectivity model of the running extraction, or nullptr to use mGridIndex
+
+    std::vector<uint32_t> mComponentCells;
+    std::vector<uint32_t> mConPointCells;
+
+    // Wire group of every wire and the number of wire groups
+    std::vector<uint32_t> mWireGroups;
+    uint32_t mWireGroupCount;
+
+    // Disjoint-set forest used while grouping wires
+    std::vector<uint32_t> mWireParents;
+    std::vector<uint32_t> mWireGroupSizes;
+
+    // Number of every group of the connectivity model
+    std::vector<uint32_t> mModelGroupNumbers;
+
+    // Cell index of the first wire group cell
+    uint32_t mFirstWireCell;
+
+    std::vector<GridIndex::WireHit> mWireHits;
+    std::vector<uint32_t> mTouchedCells;
+
+    // Progress reporting of the running extraction
+    ProgressCallback mProgressCallback;
+    uint64_t mProgressItemCount;
+    uint64_t mProcessedItemCount;
+    uint64_t mNextProgressReport;
+};
+
+#endif // NETLISTEXTRACTOR_H
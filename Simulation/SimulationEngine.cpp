@@ -0,0 +1,1258 @@
+#include "SimulationEngine.h"
+
+#include <QtGlobal>
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+constexpr uint64_t NO_TICK = 0; // Due tick of cells without a scheduled evaluation
+
+// Output changes of a loop without an input change from outside of it, after which the loop counts as oscillating.
+// Settling loops like latches change a few times per outside change only
+constexpr uint32_t OSCILLATION_CHANGE_COUNT = 256;
+
+// Factor by which the delays of the cells of oscillating loops are stretched by OscillationLimit::SLOW_DOWN
+constexpr uint32_t OSCILLATION_SLOWDOWN = 64;
+
+/// \brief Returns true, if the outputs of the given kernel depend on the current input states only
+/// \param pKernel: The kernel
+/// \return True, if the kernel is combinational
+bool IsCombinational(CellKernel pKernel)
+{
+    switch (pKernel)
+    {
+        case CellKernel::AND_GATE:
+        case CellKernel::OR_GATE:
+        case CellKernel::XOR_GATE:
+        case CellKernel::BUFFER_GATE:
+        case CellKernel::HALF_ADDER:
+        case CellKernel::FULL_ADDER:
+        case CellKernel::MULTIPLEXER:
+        case CellKernel::DEMULTIPLEXER:
+        case CellKernel::DECODER:
+        case CellKernel::ENCODER:
+        {
+            return true;
+        }
+        default:
+        {
+            return false;
+        }
+    }
+}
+} // namespace
+
+SimulationEngine::SimulationEngine()
+{}
+
+void SimulationEngine::Compile(const Netlist& pNetlist)
+{
+    Clear();
+    CompileNetlist(pNetlist, mNetlist);
+
+    const uint32_t cellCount = mNetlist.kernels.size();
+
+    mInputStates.resize(mNetlist.inputResetStates.size(), 0);
+    mPrevInputStates.resize(mNetlist.inputResetStates.size(), 0);
+    mOutputStates.resize(mNetlist.outputOffsets.back(), 0);
+    mHighInputCounts.resize(cellCount, 0);
+
+    mDueTicks.resize(cellCount, NO_TICK);
+    mCellValues.resize(cellCount, 0);
+    mCellAuxValues.resize(cellCount, 0);
+    mStateChanged.resize(cellCount, 0);
+    mIsDirty.resize(cellCount, 0);
+    mIsTraced.resize(cellCount, 0);
+    mIsQueued.resize(cellCount, 0);
+    mCellDelays.resize(cellCount, 0);
+    mLoopChangeCounts.resize(mNetlist.loopOffsets.size() - 1, 0);
+    mIsLoopOscillating.resize(mNetlist.loopOffsets.size() - 1, 0);
+
+    Levelize();
+    InitializeState();
+    SaveState(mInitialState);
+    ClearDirtyCells();
+}
+
+void SimulationEngine::Clear()
+{
+    mNetlist = CompiledNetlist();
+    mInputStates.clear();
+    mPrevInputStates.clear();
+    mOutputStates.clear();
+    mHighInputCounts.clear();
+    mTimingWheel.Reset(0);
+    mDueTicks.clear();
+    mPendingCellCount = 0;
+    mCurrentCells.clear();
+    mCellValues.clear();
+    mCellAuxValues.clear();
+    mStateChanged.clear();
+    mChangedCells.clear();
+    mIsDirty.clear();
+    mDirtyCells.clear();
+    mIsTraced.clear();
+    mTracedChanges.clear();
+    mLevels.clear();
+    mLevelBuckets.clear();
+    mIsQueued.clear();
+    mQueuedCellCount = 0;
+    mCellDelays.clear();
+    mLoopChangeCounts.clear();
+    mIsLoopOscillating.clear();
+    mOscillatingLoopCount = 0;
+    mInitialState = SimulationState();
+}
+
+void SimulationEngine::Reset()
+{
+    RestoreState(mInitialState);
+    ClearDirtyCells(); // Cells repaint themselves on wake up
+}
+
+void SimulationEngine::SaveState(SimulationState& pState) const
+{
+    // Assignments between equally sized vectors reuse the buffers, so saving is a plain copy
+    pState.inputStates = mInputStates;
+    pState.prevInputStates = mPrevInputStates;
+    pState.outputStates = mOutputStates;
+    pState.tick = mTimingWheel.GetCurrentTick();
+    pState.dueTicks = mDueTicks;
+    pState.cellValues = mCellValues;
+    pState.cellAuxValues = mCellAuxValues;
+    pState.stateChanged = mStateChanged;
+    pState.changedCells = mChangedCells;
+    pState.isQueued = mIsQueued;
+    pState.loopChangeCounts = mLoopChangeCounts;
+    pState.isLoopOscillating = mIsLoopOscillating;
+}
+
+void SimulationEngine::RestoreState(const SimulationState& pState)
+{
+    Q_ASSERT(pState.inputStates.size() == mInputStates.size() && pState.outputStates.size() == mOutputStates.size()
+             && pState.dueTicks.size() == mDueTicks.size());
+
+    mInputStates = pState.inputStates;
+    mPrevInputStates = pState.prevInputStates;
+    mOutputStates = pState.outputStates;
+    mDueTicks = pState.dueTicks;
+    mCellValues = pState.cellValues;
+    mCellAuxValues = pState.cellAuxValues;
+    mStateChanged = pState.stateChanged;
+    mChangedCells = pState.changedCells;
+    mIsQueued = pState.isQueued;
+    mLoopChangeCounts = pState.loopChangeCounts;
+    mIsLoopOscillating = pState.isLoopOscillating;
+
+    CountHighInputs();
+    RestoreTimingWheel(pState.tick);
+    RestoreOscillationLimits();
+    RestoreQueue();
+}
+
+void SimulationEngine::InitializeState()
+{
+    mInputStates = mNetlist.inputResetStates;
+    CountHighInputs();
+    std::fill(mPrevInputStates.begin(), mPrevInputStates.end(), 0);
+    std::fill(mOutputStates.begin(), mOutputStates.end(), 0);
+    std::fill(mCellValues.begin(), mCellValues.end(), 0);
+    std::fill(mCellAuxValues.begin(), mCellAuxValues.end(), 0);
+    std::fill(mStateChanged.begin(), mStateChanged.end(), 0);
+    std::fill(mDueTicks.begin(), mDueTicks.end(), NO_TICK);
+    std::fill(mIsQueued.begin(), mIsQueued.end(), 0);
+    std::fill(mLoopChangeCounts.begin(), mLoopChangeCounts.end(), 0);
+    std::fill(mIsLoopOscillating.begin(), mIsLoopOscillating.end(), 0);
+    mChangedCells.clear();
+    mTimingWheel.Reset(0);
+    mPendingCellCount = 0;
+    RestoreOscillationLimits();
+    RestoreQueue();
+
+    for (uint32_t cell = 0; cell < mNetlist.kernels.size(); cell++)
+    {
+        switch (mNetlist.kernels[cell])
+        {
+            case CellKernel::WIRE:
+            case CellKernel::DIODE:
+            case CellKernel::OUTPUT:
+            case CellKernel::INPUT:
+            {
+                break;
+            }
+            case CellKernel::CONSTANT:
+            {
+                mOutputStates[mNetlist.outputOffsets[cell]] = mNetlist.parameters[cell].constantState ? 1 : 0;
+                MarkStateChanged(cell); // Successors should be notified about wake up
+                break;
+            }
+            case CellKernel::BUTTON:
+            {
+                MarkStateChanged(cell);
+                break;
+            }
+            case CellKernel::CLOCK:
+            {
+                mCellValues[cell] = mNetlist.parameters[cell].toggleTicks;
+                mCellAuxValues[cell] = mNetlist.parameters[cell].pulseTicks;
+                MarkStateChanged(cell);
+                break;
+            }
+            case CellKernel::RS_FLIPFLOP:
+            case CellKernel::RS_CLOCKED_FLIPFLOP:
+            case CellKernel::RS_MS_FLIPFLOP:
+            case CellKernel::D_FLIPFLOP:
+            case CellKernel::D_MS_FLIPFLOP:
+            case CellKernel::T_FLIPFLOP:
+            case CellKernel::JK_FLIPFLOP:
+            case CellKernel::JK_MS_FLIPFLOP:
+            {
+                mOutputStates[mNetlist.outputOffsets[cell] + 1] = 1; // Not Q
+                Schedule(cell, 1);
+                MarkStateChanged(cell);
+                break;
+            }
+            default:
+            {
+                Schedule(cell, 1);
+                MarkStateChanged(cell);
+                break;
+            }
+        }
+    }
+}
+
+void SimulationEngine::Tick()
+{
+    for (const auto& cell : mNetlist.timedCells)
+    {
+        LogicFunction(cell); // Time driven cells are evaluated on every tick
+    }
+
+    // Only cells due at this tick are visited, so the tick cost scales with the circuit activity
+    mTimingWheel.Advance(mCurrentCells);
+    const uint64_t tick = mTimingWheel.GetCurrentTick();
+
+    for (const auto& cell : mCurrentCells)
+    {
+        if (mDueTicks[cell] == tick) // Cells that have been rescheduled leave stale entries behind
+        {
+            mDueTicks[cell] = NO_TICK;
+            mPendingCellCount--;
+            LogicFunction(cell);
+        }
+    }
+
+    // Successors are notified after all evaluations, so the cell order has no influence on the result
+    for (size_t i = 0; i < mChangedCells.size(); i++)
+    {
+        const auto cell = mChangedCells[i];
+        mStateChanged[cell] = 0;
+
+        if (mNetlist.loopIds[cell] != 0)
+        {
+            CountLoopChange(mNetlist.loopIds[cell] - 1);
+        }
+
+        NotifySuccessors(cell);
+    }
+
+    if (mQueuedCellCount > 0)
+    {
+        Settle();
+    }
+
+    mChangedCells.clear();
+}
+
+uint64_t SimulationEngine::GetIdleTicks() const
+{
+    if (mPendingCellCount > 0 || !mChangedCells.empty() || mQueuedCellCount > 0)
+    {
+        return 0;
+    }
+
+    uint64_t idleTicks = std::numeric_limits<uint64_t>::max();
+
+    for (const auto& cell : mNetlist.timedCells)
+    {
+        const bool isHigh = (mOutputStates[mNetlist.outputOffsets[cell]] != 0);
+
+        if (mNetlist.kernels[cell] == CellKernel::BUTTON)
+        {
+            if (isHigh)
+            {
+                idleTicks = std::min<uint64_t>(idleTicks, mCellValues[cell] - 1); // Released when the countdown reaches 0
+            }
+            continue;
+        }
+
+        if (mCellValues[cell] == 0)
+        {
+            return 0; // Clock without toggle ticks, it wraps around
+        }
+
+        idleTicks = std::min<uint64_t>(idleTicks, mCellValues[cell] - 1);
+
+        // The end of a pulse is only an event while the pulse is high, otherwise the countdown just restarts
+        if (mNetlist.parameters[cell].pulseMode && isHigh)
+        {
+            const uint64_t ticksToPulseEnd = (mCellAuxValues[cell] == 0) ? (uint64_t{1} << 32) : mCellAuxValues[cell];
+            idleTicks = std::min(idleTicks, ticksToPulseEnd - 1);
+        }
+    }
+
+    return (idleTicks == std::numeric_limits<uint64_t>::max()) ? 0 : idleTicks;
+}
+
+void SimulationEngine::SkipIdleTicks(uint64_t pTicks)
+{
+    if (pTicks == 0)
+    {
+        return; // Pending cells may be on the wheel, which must not be reset
+    }
+
+    Q_ASSERT(pTicks <= GetIdleTicks());
+
+    for (const auto& cell : mNetlist.timedCells)
+    {
+        if (mNetlist.kernels[cell] == CellKernel::BUTTON)
+        {
+            if (mOutputStates[mNetlist.outputOffsets[cell]] != 0)
+            {
+                mCellValues[cell] -= static_cast<uint32_t>(pTicks);
+            }
+            continue;
+        }
+
+        mCellValues[cell] -= static_cast<uint32_t>(pTicks);
+
+        // The pulse countdown restarts at pulseTicks whenever it reaches 0, from 0 or without pulse ticks it wraps around
+        const uint32_t pulseTicks = mNetlist.parameters[cell].pulseTicks;
+        auto& pulseCountdown = mCellAuxValues[cell];
+        const uint64_t ticksToZero = (pulseCountdown == 0) ? (uint64_t{1} << 32) : pulseCountdown;
+
+        if (pulseTicks == 0 || pTicks < ticksToZero)
+        {
+            pulseCountdown -= static_cast<uint32_t>(pTicks);
+        }
+        else
+        {
+            pulseCountdown = pulseTicks - static_cast<uint32_t>((pTicks - ticksToZero) % pulseTicks);
+        }
+    }
+    // No cell is pending, so the wheel holds stale entries at most
+    mTimingWheel.Reset(mTimingWheel.GetCurrentTick() + pTicks);
+}
+
+void SimulationEngine::SetZeroDelaySettle(bool pEnabled)
+{
+    mIsZeroDelaySettle = pEnabled;
+    RestoreQueue();
+}
+
+bool SimulationEngine::IsZeroDelaySettle() const
+{
+    return mIsZeroDelaySettle;
+}
+
+uint32_t SimulationEngine::GetLevel(uint32_t pCell) const
+{
+    Q_ASSERT(pCell < mLevels.size());
+    return mLevels[pCell];
+}
+
+void SimulationEngine::SetOscillationLimit(OscillationLimit pLimit)
+{
+    mOscillationLimit = pLimit;
+    RestoreOscillationLimits();
+}
+
+OscillationLimit SimulationEngine::GetOscillationLimit() const
+{
+    return mOscillationLimit;
+}
+
+uint32_t SimulationEngine::GetLoopCount() const
+{
+    return mLoopChangeCounts.size();
+}
+
+uint32_t SimulationEngine::GetOscillatingLoopCount() const
+{
+    return mOscillatingLoopCount;
+}
+
+bool SimulationEngine::IsOscillating(uint32_t pCell) const
+{
+    Q_ASSERT(pCell < mNetlist.loopIds.size());
+    return (mNetlist.loopIds[pCell] != 0 && mIsLoopOscillating[mNetlist.loopIds[pCell] - 1] != 0);
+}
+
+void SimulationEngine::ToggleInput(uint32_t pCell)
+{
+    Q_ASSERT(pCell < mNetlist.kernels.size() && mNetlist.kernels[pCell] == CellKernel::INPUT);
+
+    mOutputStates[mNetlist.outputOffsets[pCell]] ^= 1;
+    MarkDirty(pCell);
+    NotifySuccessors(pCell);
+}
+
+void SimulationEngine::PressButton(uint32_t pCell)
+{
+    Q_ASSERT(pCell < mNetlist.kernels.size() && mNetlist.kernels[pCell] == CellKernel::BUTTON);
+
+    if (mOutputStates[mNetlist.outputOffsets[pCell]] == 0)
+    {
+        mCellValues[pCell] = mNetlist.parameters[pCell].toggleTicks;
+        mOutputStates[mNetlist.outputOffsets[pCell]] = 1;
+        MarkDirty(pCell);
+        NotifySuccessors(pCell);
+    }
+}
+
+uint32_t SimulationEngine::GetCellCount() const
+{
+    return mNetlist.kernels.size();
+}
+
+CellKernel SimulationEngine::GetKernel(uint32_t pCell) const
+{
+    Q_ASSERT(pCell < mNetlist.kernels.size());
+    return mNetlist.kernels[pCell];
+}
+
+bool SimulationEngine::GetInputState(uint32_t pCell, uint32_t pInput) const
+{
+    Q_ASSERT(pCell < mNetlist.kernels.size() && mNetlist.inputOffsets[pCell] + pInput < mNetlist.inputOffsets[pCell + 1]);
+    return mInputStates[mNetlist.inputOffsets[pCell] + pInput] != 0;
+}
+
+bool SimulationEngine::GetOutputState(uint32_t pCell, uint32_t pOutput) const
+{
+    Q_ASSERT(pCell < mNetlist.kernels.size() && mNetlist.outputOffsets[pCell] + pOutput < mNetlist.outputOffsets[pCell + 1]);
+    return mOutputStates[mNetlist.outputOffsets[pCell] + pOutput] != 0;
+}
+
+const std::vector<uint32_t>& SimulationEngine::GetDirtyCells() const
+{
+    return mDirtyCells;
+}
+
+void SimulationEngine::ClearDirtyCells()
+{
+    for (const auto& cell : mDirtyCells)
+    {
+        mIsDirty[cell] = 0;
+    }
+
+    mDirtyCells.clear();
+}
+
+void SimulationEngine::SetTraced(uint32_t pCell, bool pIsTraced)
+{
+    Q_ASSERT(pCell < mIsTraced.size());
+    mIsTraced[pCell] = pIsTraced ? 1 : 0;
+}
+
+const std::vector<uint32_t>& SimulationEngine::GetTracedChanges() const
+{
+    return mTracedChanges;
+}
+
+void SimulationEngine::ClearTracedChanges()
+{
+    mTracedChanges.clear();
+}
+
+const EngineCounters& SimulationEngine::GetCounters() const
+{
+    return mCounters;
+}
+
+void SimulationEngine::WriteSnapshot(SimulationSnapshot& pSnapshot) const
+{
+    pSnapshot.inputOffsets = mNetlist.inputOffsets;
+    pSnapshot.outputOffsets = mNetlist.outputOffsets;
+    pSnapshot.inputStates = mInputStates;
+    pSnapshot.outputStates = mOutputStates;
+}
+
+void SimulationEngine::WriteSnapshot(SimulationSnapshot& pSnapshot, const std::vector<uint32_t>& pCells) const
+{
+    Q_ASSERT(pSnapshot.inputStates.size() == mInputStates.size() && pSnapshot.outputStates.size() == mOutputStates.size());
+
+    for (const auto& cell : pCells)
+    {
+        std::copy(mInputStates.begin() + mNetlist.inputOffsets[cell], mInputStates.begin() + mNetlist.inputOffsets[cell + 1],
+                  pSnapshot.inputStates.begin() + mNetlist.inputOffsets[cell]);
+        std::copy(mOutputStates.begin() + mNetlist.outputOffsets[cell], mOutputStates.begin() + mNetlist.outputOffsets[cell + 1],
+                  pSnapshot.outputStates.begin() + mNetlist.outputOffsets[cell]);
+    }
+}
+
+void SimulationEngine::CountHighInputs()
+{
+    for (uint32_t cell = 0; cell < mHighInputCounts.size(); cell++)
+    {
+        mHighInputCounts[cell] = std::count(mInputStates.begin() + mNetlist.inputOffsets[cell],
+                                            mInputStates.begin() + mNetlist.inputOffsets[cell + 1], 1);
+    }
+}
+
+void SimulationEngine::Levelize()
+{
+    const uint32_t cellCount = mNetlist.kernels.size();
+
+    // Wires and diodes that were not collapsed pass states on immediately, so they are part of the combinational graph
+    // without adding a level of their own
+    const auto isGraphCell = [this](uint32_t pCell)
+    {
+        const auto kernel = mNetlist.kernels[pCell];
+        return IsCombinational(kernel) || kernel == CellKernel::WIRE || kernel == CellKernel::DIODE;
+    };
+
+    std::vector<uint32_t> predecessorCounts(cellCount, 0);
+
+    for (uint32_t cell = 0; cell < cellCount; cell++)
+    {
+        if (!isGraphCell(cell))
+        {
+            continue;
+        }
+
+        for (uint32_t edge = mNetlist.edgeOffsets[mNetlist.outputOffsets[cell]]; edge < mNetlist.edgeOffsets[mNetlist.outputOffsets[cell + 1]]; edge++)
+        {
+            predecessorCounts[mNetlist.edges[edge].targetCell]++;
+        }
+    }
+
+    // Kahn's algorithm, cells in or behind a loop never run out of predecessors and stay unlevelized
+    std::vector<uint32_t> depths(cellCount, 0);
+    std::vector<uint32_t> readyCells;
+    mLevels.assign(cellCount, 0);
+
+    for (uint32_t cell = 0; cell < cellCount; cell++)
+    {
+        if (isGraphCell(cell) && predecessorCounts[cell] == 0)
+        {
+            readyCells.push_back(cell);
+        }
+    }
+
+    uint32_t maxLevel = 0;
+
+    while (!readyCells.empty())
+    {
+        const auto cell = readyCells.back();
+        readyCells.pop_back();
+
+        const bool isGate = IsCombinational(mNetlist.kernels[cell]);
+        const uint32_t depth = depths[cell] + (isGate ? 1 : 0);
+
+        if (isGate)
+        {
+            mLevels[cell] = depth;
+            maxLevel = std::max(maxLevel, depth);
+        }
+
+        for (uint32_t edge = mNetlist.edgeOffsets[mNetlist.outputOffsets[cell]]; edge < mNetlist.edgeOffsets[mNetlist.outputOffsets[cell + 1]]; edge++)
+        {
+            const auto target = mNetlist.edges[edge].targetCell;
+
+            if (!isGraphCell(target))
+            {
+                continue;
+            }
+
+            depths[target] = std::max(depths[target], depth);
+
+            if (--predecessorCounts[target] == 0)
+            {
+                readyCells.push_back(target);
+            }
+        }
+    }
+
+    mLevelBuckets.assign(maxLevel + 1, std::vector<uint32_t>());
+}
+
+void SimulationEngine::Queue(uint32_t pCell)
+{
+    if (mIsQueued[pCell] == 0)
+    {
+        mIsQueued[pCell] = 1;
+        mLevelBuckets[mLevels[pCell]].push_back(pCell);
+        mQueuedCellCount++;
+    }
+}
+
+void SimulationEngine::Settle()
+{
+    // Successors of a cell have a higher level, so the bucket being evaluated never grows
+    for (uint32_t level = 1; level < mLevelBuckets.size() && mQueuedCellCount > 0; level++)
+    {
+        auto& bucket = mLevelBuckets[level];
+
+        for (const auto& cell : bucket)
+        {
+            mIsQueued[cell] = 0;
+            mQueuedCellCount--;
+            LogicFunction(cell);
+
+            if (mStateChanged[cell] != 0)
+            {
+                mStateChanged[cell] = 0;
+                NotifySuccessors(cell);
+            }
+        }
+
+        bucket.clear();
+    }
+}
+
+void SimulationEngine::RestoreQueue()
+{
+    for (auto& bucket : mLevelBuckets)
+    {
+        bucket.clear();
+    }
+    mQueuedCellCount = 0;
+
+    for (uint32_t cell = 0; cell < mIsQueued.size(); cell++)
+    {
+        if (mIsQueued[cell] == 0)
+        {
+            continue;
+        }
+
+        if (mIsZeroDelaySettle)
+        {
+            mLevelBuckets[mLevels[cell]].push_back(cell);
+            mQueuedCellCount++;
+        }
+        else
+        {
+            mIsQueued[cell] = 0;
+
+            if (mCellDelays[cell] != 0)
+            {
+                Schedule(cell, mTimingWheel.GetCurrentTick() + mCellDelays[cell]);
+            }
+        }
+    }
+}
+
+void SimulationEngine::RestoreOscillationLimits()
+{
+    for (uint32_t cell = 0; cell < mCellDelays.size(); cell++)
+    {
+        mCellDelays[cell] = mNetlist.parameters[cell].delay;
+    }
+
+    mOscillatingLoopCount = 0;
+
+    for (uint32_t loop = 0; loop < mIsLoopOscillating.size(); loop++)
+    {
+        if (mIsLoopOscillating[loop] != 0)
+        {
+            mOscillatingLoopCount++;
+            LimitLoop(loop);
+        }
+    }
+}
+
+void SimulationEngine::CountLoopChange(uint32_t pLoop)
+{
+    if (mIsLoopOscillating[pLoop] != 0 || ++mLoopChangeCounts[pLoop] < OSCILLATION_CHANGE_COUNT)
+    {
+        return;
+    }
+
+    mIsLoopOscillating[pLoop] = 1;
+    mOscillatingLoopCount++;
+    LimitLoop(pLoop);
+}
+
+void SimulationEngine::ReleaseLoop(uint32_t pLoop)
+{
+    mLoopChangeCounts[pLoop] = 0;
+
+    if (mIsLoopOscillating[pLoop] == 0)
+    {
+        return;
+    }
+
+    mIsLoopOscillating[pLoop] = 0;
+    mOscillatingLoopCount--;
+
+    // Inputs of frozen cells may have changed unnoticed, so idle cells are evaluated once more
+    for (uint32_t i = mNetlist.loopOffsets[pLoop]; i < mNetlist.loopOffsets[pLoop + 1]; i++)
+    {
+        const auto cell = mNetlist.loopCells[i];
+        mCellDelays[cell] = mNetlist.parameters[cell].delay;
+
+        if (mDueTicks[cell] == NO_TICK && mNetlist.kernels[cell] != CellKernel::WIRE && mNetlist.kernels[cell] != CellKernel::DIODE)
+        {
+            Schedule(cell, mTimingWheel.GetCurrentTick() + mCellDelays[cell]);
+        }
+    }
+}
+
+void SimulationEngine::LimitLoop(uint32_t pLoop)
+{
+    for (uint32_t i = mNetlist.loopOffsets[pLoop]; i < mNetlist.loopOffsets[pLoop + 1]; i++)
+    {
+        const auto cell = mNetlist.loopCells[i];
+
+        switch (mOscillationLimit)
+        {
+            case OscillationLimit::NONE:
+            {
+                break;
+            }
+            case OscillationLimit::SLOW_DOWN:
+            {
+                mCellDelays[cell] = std::min(mNetlist.parameters[cell].delay * OSCILLATION_SLOWDOWN, MAX_CELL_DELAY);
+                break;
+            }
+            case OscillationLimit::FREEZE:
+            {
+                // The pending evaluation is dropped, its stale wheel entry is skipped when it fires
+                mCellDelays[cell] = 0;
+
+                if (mDueTicks[cell] != NO_TICK)
+                {
+                    mDueTicks[cell] = NO_TICK;
+                    mPendingCellCount--;
+                }
+                break;
+            }
+        }
+    }
+}
+
+void SimulationEngine::RestoreTimingWheel(uint64_t pTick)
+{
+    mTimingWheel.Reset(pTick);
+    mPendingCellCount = 0;
+
+    for (uint32_t cell = 0; cell < mDueTicks.size(); cell++)
+    {
+        if (mDueTicks[cell] != NO_TICK)
+        {
+            mTimingWheel.Insert(cell, mDueTicks[cell]);
+            mPendingCellCount++;
+        }
+    }
+}
+
+void SimulationEngine::LogicFunction(uint32_t pCell)
+{
+    mCounters.evaluatedCells++;
+
+    const uint32_t inputOffset = mNetlist.inputOffsets[pCell];
+    const uint32_t inputCount = mNetlist.inputOffsets[pCell + 1] - inputOffset;
+    const uint32_t outputCount = mNetlist.outputOffsets[pCell + 1] - mNetlist.outputOffsets[pCell];
+
+    const uint8_t* inputs = mInputStates.data() + inputOffset;
+    uint8_t* prevInputs = mPrevInputStates.data() + inputOffset;
+    uint8_t* outputs = mOutputStates.data() + mNetlist.outputOffsets[pCell];
+
+    const bool risingEdge = (inputCount > 1 && prevInputs[1] == 0 && inputs[1] == 1);
+    const bool fallingEdge = (inputCount > 1 && prevInputs[1] == 1 && inputs[1] == 0);
+
+    bool changed = false;
+
+    switch (mNetlist.kernels[pCell])
+    {
+        case CellKernel::AND_GATE:
+        {
+            changed |= AssureOutput(pCell, 0, (mHighInputCounts[pCell] == inputCount) ? 1 : 0);
+            break;
+        }
+        case CellKernel::OR_GATE:
+        {
+            changed |= AssureOutput(pCell, 0, (mHighInputCounts[pCell] > 0) ? 1 : 0);
+            break;
+        }
+        case CellKernel::XOR_GATE:
+        {
+            changed |= AssureOutput(pCell, 0, (mHighInputCounts[pCell] == 1) ? 1 : 0); // Exactly one input high
+            break;
+        }
+        case CellKernel::BUFFER_GATE:
+        {
+            changed |= AssureOutput(pCell, 0, inputs[0]);
+            break;
+        }
+        case CellKernel::BUTTON:
+        {
+            if (outputs[0] == 1)
+            {
+                mCellValues[pCell]--;
+                if (mCellValues[pCell] == 0)
+                {
+                    outputs[0] = 0;
+                    changed = true;
+                }
+            }
+            break;
+        }
+        case CellKernel::CLOCK:
+        {
+            auto& tickCountdown = mCellValues[pCell];
+            auto& pulseCountdown = mCellAuxValues[pCell];
+            const auto& parameters = mNetlist.parameters[pCell];
+
+            tickCountdown--;
+            pulseCountdown--;
+
+            if (tickCountdown == 0)
+            {
+                if (parameters.pulseMode)
+                {
+                    changed |= AssureOutput(pCell, 0, 1);
+                    pulseCountdown = parameters.pulseTicks;
+                }
+                else
+                {
+                    outputs[0] ^= 1;
+                    changed = true;
+                }
+                tickCountdown = parameters.toggleTicks;
+            }
+            else if (pulseCountdown == 0)
+            {
+                if (parameters.pulseMode)
+                {
+                    changed |= AssureOutput(pCell, 0, 0);
+                }
+                pulseCountdown = parameters.pulseTicks;
+            }
+            break;
+        }
+        case CellKernel::HALF_ADDER:
+        {
+            changed |= AssureOutput(pCell, 0, inputs[0] ^ inputs[1]);
+            changed |= AssureOutput(pCell, 1, inputs[0] & inputs[1]);
+            break;
+        }
+        case CellKernel::FULL_ADDER:
+        {
+            changed |= AssureOutput(pCell, 0, inputs[0] ^ inputs[1] ^ inputs[2]);
+            changed |= AssureOutput(pCell, 1, (inputs[0] & inputs[1]) | (inputs[0] & inputs[2]) | (inputs[1] & inputs[2]));
+            break;
+        }
+        case CellKernel::RS_FLIPFLOP:
+        {
+            if (inputs[0] == 1) // S high
+            {
+                changed |= AssureOutput(pCell, 0, 1);
+                changed |= AssureOutput(pCell, 1, 0);
+            }
+            if (inputs[1] == 1) // R high
+            {
+                changed |= AssureOutput(pCell, 0, 0);
+                changed |= AssureOutput(pCell, 1, 1);
+            }
+            break;
+        }
+        case CellKernel::RS_CLOCKED_FLIPFLOP:
+        {
+            if (risingEdge)
+            {
+                if (inputs[0] == 1) // S high
+                {
+                    outputs[0] = 1;
+                    outputs[1] = 0;
+                }
+                if (inputs[2] == 1) // R high
+                {
+                    outputs[0] = 0;
+                    outputs[1] = 1;
+                }
+            }
+            break;
+        }
+        case CellKernel::RS_MS_FLIPFLOP:
+        {
+            if (risingEdge) // Read in state
+            {
+                if (inputs[0] == 1) // S high
+                {
+                    mCellValues[pCell] = 1;
+                }
+                if (inputs[2] == 1) // R high
+                {
+                    mCellValues[pCell] = 0;
+                }
+            }
+            else if (fallingEdge)
+            {
+                outputs[0] = mCellValues[pCell];
+                outputs[1] = outputs[0] ^ 1;
+            }
+            break;
+        }
+        case CellKernel::D_FLIPFLOP:
+        {
+            if (risingEdge)
+            {
+                outputs[0] = prevInputs[0];
+                outputs[1] = prevInputs[0] ^ 1;
+            }
+            break;
+        }
+        case CellKernel::D_MS_FLIPFLOP:
+        {
+            if (risingEdge) // Read in state
+            {
+                mCellValues[pCell] = inputs[0];
+            }
+            else if (fallingEdge)
+            {
+                outputs[0] = mCellValues[pCell];
+                outputs[1] = outputs[0] ^ 1;
+            }
+            break;
+        }
+        case CellKernel::T_FLIPFLOP:
+        {
+            if (risingEdge && prevInputs[0] == 1)
+            {
+                outputs[0] ^= 1;
+                outputs[1] = outputs[0] ^ 1;
+            }
+            break;
+        }
+        case CellKernel::JK_FLIPFLOP:
+        case CellKernel::JK_MS_FLIPFLOP:
+        {
+            // The JK flip-flop stores directly into its output, the master-slave variant into its internal state
+            const bool masterSlave = (mNetlist.kernels[pCell] == CellKernel::JK_MS_FLIPFLOP);
+            uint8_t state = masterSlave ? static_cast<uint8_t>(mCellValues[pCell]) : outputs[0];
+
+            if (risingEdge)
+            {
+                if (prevInputs[0] == 1 && prevInputs[2] == 1) // Both => toggle
+                {
+                    state ^= 1;
+                }
+                else if (prevInputs[0] == 1) // J => pull up
+                {
+                    state = 1;
+                }
+                else if (prevInputs[2] == 1) // K => pull down
+                {
+                    state = 0;
+                }
+
+                if (masterSlave)
+                {
+                    mCellValues[pCell] = state;
+                }
+                else
+                {
+                    outputs[0] = state;
+                    outputs[1] = state ^ 1;
+                }
+            }
+            else if (fallingEdge && masterSlave)
+            {
+                outputs[0] = state;
+                outputs[1] = state ^ 1;
+            }
+            break;
+        }
+        case CellKernel::MULTIPLEXER:
+        {
+            const uint32_t digitCount = GetMultiplexerDigitCount(inputCount);
+            const auto input = ReadInputValue(pCell, 0, digitCount);
+            changed |= AssureOutput(pCell, 0, inputs[digitCount + input]);
+            break;
+        }
+        case CellKernel::DEMULTIPLEXER:
+        {
+            const uint32_t digitCount = inputCount - 1;
+            const auto output = ReadInputValue(pCell, 0, digitCount);
+
+            for (uint32_t i = 0; i < outputCount; i++)
+            {
+                changed |= AssureOutput(pCell, i, (i == output) ? inputs[digitCount] : 0);
+            }
+            break;
+        }
+        case CellKernel::DECODER:
+        {
+            const auto value = ReadInputValue(pCell, 0, inputCount);
+
+            for (uint32_t i = 0; i < outputCount; i++)
+            {
+                changed |= AssureOutput(pCell, i, (i == value) ? 1 : 0);
+            }
+            break;
+        }
+        case CellKernel::ENCODER:
+        {
+            int32_t value = -1;
+
+            for (uint32_t i = 0; i < inputCount; i++)
+            {
+                if (inputs[i] == 1)
+                {
+                    value = i;
+                }
+            }
+
+            changed |= AssureOutput(pCell, outputCount - 1, (value >= 0) ? 1 : 0);
+
+            const uint32_t bits = (value >= 0) ? value : 0;
+            for (uint32_t i = 0; i < outputCount - 1; i++)
+            {
+                changed |= AssureOutput(pCell, i, (bits >> i) & 1);
+            }
+            break;
+        }
+        case CellKernel::SHIFTREGISTER:
+        {
+            if (risingEdge)
+            {
+                for (uint32_t i = outputCount - 1; i > 0; i--)
+                {
+                    outputs[i] = outputs[i - 1];
+                }
+                outputs[0] = inputs[0];
+            }
+            break;
+        }
+        case CellKernel::COUNTER:
+        {
+            if (prevInputs[2] == 0 && inputs[2] == 1)
+            {
+                const uint32_t maxValue = (outputCount >= 32) ? UINT32_MAX : ((1u << outputCount) - 1);
+                auto& value = mCellValues[pCell];
+
+                if (inputs[0] == 1)
+                {
+                    value = 0;
+                }
+                else if (inputs[1] == 0)
+                {
+                    value = (value < maxValue) ? value + 1 : 0;
+                }
+
+                for (uint32_t i = 0; i < outputCount; i++)
+                {
+                    changed |= AssureOutput(pCell, i, (value >> i) & 1);
+                }
+            }
+
+            if (prevInputs[2] != inputs[2]) // Trigger repaint on every clock change
+            {
+                changed = true;
+            }
+            break;
+        }
+        default:
+        {
+            break; // Wires, diodes and outputs are evaluated on input change, inputs and constants never
+        }
+    }
+
+    switch (mNetlist.kernels[pCell])
+    {
+        case CellKernel::RS_CLOCKED_FLIPFLOP:
+        case CellKernel::RS_MS_FLIPFLOP:
+        case CellKernel::D_FLIPFLOP:
+        case CellKernel::D_MS_FLIPFLOP:
+        case CellKernel::T_FLIPFLOP:
+        case CellKernel::JK_FLIPFLOP:
+        case CellKernel::JK_MS_FLIPFLOP:
+        case CellKernel::SHIFTREGISTER:
+        {
+            changed |= (risingEdge || fallingEdge); // Trigger repaint on every clock change
+            std::copy(inputs, inputs + inputCount, prevInputs);
+            break;
+        }
+        case CellKernel::COUNTER:
+        {
+            std::copy(inputs, inputs + inputCount, prevInputs);
+            break;
+        }
+        default:
+        {
+            break;
+        }
+    }
+
+    if (changed)
+    {
+        MarkStateChanged(pCell);
+    }
+}
+
+void SimulationEngine::NotifySuccessors(uint32_t pCell)
+{
+    for (uint32_t output = mNetlist.outputOffsets[pCell]; output < mNetlist.outputOffsets[pCell + 1]; output++)
+    {
+        const uint8_t state = mOutputStates[output];
+
+        for (uint32_t edge = mNetlist.edgeOffsets[output]; edge < mNetlist.edgeOffsets[output + 1]; edge++)
+        {
+            const auto& target = mNetlist.edges[edge];
+
+            // A change from outside of a loop explains the loop's following changes, so its watchdog starts over
+            if (target.entersLoop != 0 && mInputStates[target.targetInput] != (state ^ target.inverted))
+            {
+                ReleaseLoop(mNetlist.loopIds[target.targetCell] - 1);
+            }
+
+            InputReady(target.targetCell, target.targetInput, state ^ target.inverted);
+        }
+
+        for (uint32_t mirror = mNetlist.mirrorOffsets[output]; mirror < mNetlist.mirrorOffsets[output + 1]; mirror++)
+        {
+            const auto& target = mNetlist.mirrors[mirror];
+            MirrorState(target.targetCell, target.targetInput, state ^ target.inverted);
+        }
+    }
+}
+
+void SimulationEngine::MirrorState(uint32_t pCell, uint32_t pInput, uint8_t pState)
+{
+    if (mInputStates[pInput] != pState)
+    {
+        mInputStates[pInput] = pState;
+        mHighInputCounts[pCell] = pState;
+        mOutputStates[mNetlist.outputOffsets[pCell]] = pState;
+        MarkDirty(pCell);
+    }
+}
+
+void SimulationEngine::InputReady(uint32_t pCell, uint32_t pInput, uint8_t pState)
+{
+    mCounters.inputEvents++;
+
+    if (mInputStates[pInput] == pState)
+    {
+        return;
+    }
+
+    mHighInputCounts[pCell] = mHighInputCounts[pCell] + pState - mInputStates[pInput];
+    mInputStates[pInput] = pState;
+    MarkDirty(pCell);
+
+    switch (mNetlist.kernels[pCell])
+    {
+        case CellKernel::WIRE:
+        {
+            // Wires are evaluated immediately and forward their state within the same tick
+            mCounters.evaluatedCells++;
+
+            if (AssureOutput(pCell, 0, (mHighInputCounts[pCell] > 0) ? 1 : 0))
+            {
+                NotifySuccessors(pCell);
+            }
+            break;
+        }
+        case CellKernel::DIODE:
+        {
+            mCounters.evaluatedCells++;
+
+            if (AssureOutput(pCell, 0, pState))
+            {
+                NotifySuccessors(pCell);
+            }
+            break;
+        }
+        case CellKernel::OUTPUT:
+        {
+            break; // Outputs only display their input state
+        }
+        default:
+        {
+            if (mIsZeroDelaySettle && mLevels[pCell] != 0)
+            {
+                Queue(pCell); // Evaluated in topological order at the end of the tick
+                break;
+            }
+
+            // Cells of frozen loops keep their outputs
+            if (mCellDelays[pCell] != 0)
+            {
+                Schedule(pCell, mTimingWheel.GetCurrentTick() + mCellDelays[pCell]);
+            }
+            break;
+        }
+    }
+}
+
+void SimulationEngine::Schedule(uint32_t pCell, uint64_t pTick)
+{
+    if (mDueTicks[pCell] == pTick)
+    {
+        return;
+    }
+
+    if (mDueTicks[pCell] == NO_TICK)
+    {
+        mPendingCellCount++;
+    }
+
+    // A rescheduled cell keeps its old entry in the wheel, it is skipped when it fires because the due tick differs
+    mDueTicks[pCell] = pTick;
+    mTimingWheel.Insert(pCell, pTick);
+}
+
+bool SimulationEngine::AssureOutput(uint32_t pCell, uint32_t pOutput, uint8_t pState)
+{
+    auto& output = mOutputStates[mNetlist.outputOffsets[pCell] + pOutput];
+
+    if (output != pState)
+    {
+        output = pState;
+        return true;
+    }
+
+    return false;
+}
+
+void SimulationEngine::MarkStateChanged(uint32_t pCell)
+{
+    MarkDirty(pCell);
+
+    if (mStateChanged[pCell] == 0)
+    {
+        mStateChanged[pCell] = 1;
+        mChangedCells.push_back(pCell);
+    }
+}
+
+void SimulationEngine::MarkDirty(uint32_t pCell)
+{
+    // Unlike the dirty list, traced changes are consumed every tick, so every change is listed
+    if (mIsTraced[pCell] != 0)
+    {
+        mTracedChanges.push_back(pCell);
+    }
+
+    if (mIsDirty[pCell] == 0)
+    {
+        mIsDirty[pCell] = 1;
+        mDirtyCells.push_back(pCell);
+    }
+}
+
+uint32_t SimulationEngine::ReadInputValue(uint32_t pCell, uint32_t pFirst, uint32_t pCount) const
+{
+    uint32_t value = 0;
+
+    for (uint32_t i = 0; i < pCount; i++)
+    {
+        value |= static_cast<uint32_t>(mInputStates[mNetlist.inputOffsets[pCell] + pFirst + i]) << i;
+    }
+
+    return value;
+}
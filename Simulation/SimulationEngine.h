@@ -0,0 +1,335 @@
+#ifndef SIMULATIONENGINE_H
+#define SIMULATIONENGINE_H
+
+#include "Simulation/CompiledNetlist.h"
+#include "Simulation/SimulationSnapshot.h"
+#include "Simulation/TimingWheel.h"
+
+#include <cstdint>
+#include <vector>
+
+///
+/// \brief The SimulationState struct holds the complete mutable state of a SimulationEngine
+/// A state is only valid for the engine and compiled netlist it has been saved from
+///
+struct SimulationState
+{
+    std::vector<uint8_t> inputStates;
+    std::vector<uint8_t> prevInputStates;
+    std::vector<uint8_t> outputStates;
+    uint64_t tick = 0;
+    std::vector<uint64_t> dueTicks;
+    std::vector<uint32_t> cellValues;
+    std::vector<uint32_t> cellAuxValues;
+    std::vector<uint8_t> stateChanged;
+    std::vector<uint32_t> changedCells;
+    std::vector<uint8_t> isQueued;
+    std::vector<uint32_t> loopChangeCounts;
+    std::vector<uint8_t> isLoopOscillating;
+};
+
+///
+/// \brief How the engine limits combinational loops that oscillate on their own
+///
+enum class OscillationLimit : uint8_t
+{
+    NONE = 0, // Oscillating loops are only reported
+    SLOW_DOWN, // The delays of the loop's cells are stretched, so the loop changes and repaints less often
+    FREEZE // The loop's cells are no longer evaluated and keep their output states
+};
+
+///
+/// \brief Running totals of the work done by a SimulationEngine, used for profiling
+///
+struct EngineCounters
+{
+    uint64_t evaluatedCells = 0; // Calls of cell logic functions
+    uint64_t inputEvents = 0; // Input state updates sent to cells, including unchanged ones
+};
+
+///
+/// \brief The SimulationEngine class simulates a compiled netlist on flat, index-based state arrays
+///
+class SimulationEngine
+{
+public:
+    /// \brief Constructor for SimulationEngine
+    SimulationEngine(void);
+
+    /// \brief Compiles the given netlist into the engine's flat state arrays, replacing any previous circuit
+    /// The engine is in its initial state afterwards
+    /// \param pNetlist: The netlist to compile
+    void Compile(const Netlist& pNetlist);
+
+    /// \brief Releases the compiled circuit
+    void Clear(void);
+
+    /// \brief Puts all cells into their initial simulation state, equivalent to a fresh simulation start
+    /// The initial state is computed once on compile, so a reset only copies the state arrays
+    void Reset(void);
+
+    /// \brief Copies the complete simulation state into the given state
+    /// \param pState: The state to write, its buffers are reused
+    void SaveState(SimulationState& pState) const;
+
+    /// \brief Restores a state previously saved from this engine with the same compiled netlist
+    /// The dirty cells are not restored, as the restored state is unrelated to the last published one
+    /// \param pState: The state to restore
+    void RestoreState(const SimulationState& pState);
+
+    /// \brief Advances the simulation by one logic tick
+    void Tick(void);
+
+    /// \brief Returns the number of upcoming ticks in which no state can change
+    /// These are the ticks before the next clock edge or button release, if no cell has a pending update
+    /// \return The number of idle ticks, 0 if a cell is pending or if no clock or button will ever change
+    uint64_t GetIdleTicks(void) const;
+
+    /// \brief Advances the clock and button countdowns over the given number of idle ticks at once
+    /// The result is identical to calling Tick pTicks times
+    /// \param pTicks: The number of ticks to skip, at most GetIdleTicks, nothing happens for 0
+    void SkipIdleTicks(uint64_t pTicks);
+
+    /// \brief Enables or disables the zero delay settle mode
+    /// In this mode, acyclic combinational logic between the sequential cells (flip-flops, counters, shift registers,
+    /// clocks and inputs) is evaluated once per tick in topological order, so it settles within the tick that changed
+    /// its inputs instead of waiting for the propagation delay of every gate. These delays are ignored,
+    /// combinational loops and the logic they drive keep their delay.
+    /// \param pEnabled: True to enable the mode
+    void SetZeroDelaySettle(bool pEnabled);
+
+    /// \brief Returns true, if the zero delay settle mode is enabled
+    /// \return True, if the mode is enabled
+    bool IsZeroDelaySettle(void) const;
+
+    /// \brief Getter for the topological level of the given cell in the zero delay settle mode
+    /// \param pCell: The cell index
+    /// \return The level, starting at 1, or 0 if the cell is not levelized
+    uint32_t GetLevel(uint32_t pCell) const;
+
+    /// \brief Sets how combinational loops are limited once they oscillate
+    /// A loop oscillates if its cells keep changing without any input change from outside of the loop,
+    /// like an inverter driving itself or an unclocked RS flip-flop race. The next input change from outside releases the loop.
+    /// \param pLimit: The limit applied to oscillating loops
+    void SetOscillationLimit(OscillationLimit pLimit);
+
+    /// \brief Getter for the limit applied to oscillating loops
+    /// \return The oscillation limit
+    OscillationLimit GetOscillationLimit(void) const;
+
+    /// \brief Getter for the number of combinational loops of the compiled circuit
+    /// \return The number of loops
+    uint32_t GetLoopCount(void) const;
+
+    /// \brief Getter for the number of combinational loops that have been detected to oscillate
+    /// \return The number of oscillating loops
+    uint32_t GetOscillatingLoopCount(void) const;
+
+    /// \brief Returns true, if the given cell belongs to an oscillating combinational loop
+    /// \param pCell: The cell index
+    /// \return True, if the cell's loop oscillates
+    bool IsOscillating(uint32_t pCell) const;
+
+    /// \brief Toggles the output of the given input cell and propagates the change immediately
+    /// \param pCell: Index of an INPUT cell
+    void ToggleInput(uint32_t pCell);
+
+    /// \brief Pulls the output of the given button cell high and propagates the change immediately
+    /// \param pCell: Index of a BUTTON cell
+    void PressButton(uint32_t pCell);
+
+    /// \brief Getter for the number of compiled cells
+    /// \return The number of compiled cells
+    uint32_t GetCellCount(void) const;
+
+    /// \brief Getter for the kernel of the given cell
+    /// \param pCell: The cell index
+    /// \return The kernel of the cell
+    CellKernel GetKernel(uint32_t pCell) const;
+
+    /// \brief Getter for the state of input pInput of the given cell, with input inversion applied
+    /// \param pCell: The cell index
+    /// \param pInput: The input number
+    /// \return True, if the input is high
+    bool GetInputState(uint32_t pCell, uint32_t pInput) const;
+
+    /// \brief Getter for the state of output pOutput of the given cell, without output inversion
+    /// \param pCell: The cell index
+    /// \param pOutput: The output number
+    /// \return True, if the output is high
+    bool GetOutputState(uint32_t pCell, uint32_t pOutput) const;
+
+    /// \brief Getter for the cells whose in- or output states changed since the last call to ClearDirtyCells
+    /// \return Vector of cell indices
+    const std::vector<uint32_t>& GetDirtyCells(void) const;
+
+    /// \brief Clears the list of dirty cells
+    void ClearDirtyCells(void);
+
+    /// \brief Enables or disables change tracing for the given cell
+    /// Traced cells are listed in the traced changes whenever one of their in- or output states changes
+    /// \param pCell: The cell index
+    /// \param pIsTraced: True, to trace the cell
+    void SetTraced(uint32_t pCell, bool pIsTraced);
+
+    /// \brief Getter for the traced cells that changed since the last call to ClearTracedChanges
+    /// A cell is listed once per change, so the list may contain duplicates
+    /// \return Vector of cell indices
+    const std::vector<uint32_t>& GetTracedChanges(void) const;
+
+    /// \brief Clears the list of traced changes
+    void ClearTracedChanges(void);
+
+    /// \brief Getter for the work counters, they are never reset and only grow
+    /// \return The counters
+    const EngineCounters& GetCounters(void) const;
+
+    /// \brief Copies the layout and all pin states of the compiled circuit into the given snapshot
+    /// \param pSnapshot: The snapshot to write
+    void WriteSnapshot(SimulationSnapshot& pSnapshot) const;
+
+    /// \brief Copies the pin states of the given cells into a snapshot previously written by this engine
+    /// \param pSnapshot: The snapshot to update
+    /// \param pCells: The indices of the cells to copy
+    void WriteSnapshot(SimulationSnapshot& pSnapshot, const std::vector<uint32_t>& pCells) const;
+
+protected:
+    /// \brief Computes the initial simulation state of all cells from the compiled netlist
+    void InitializeState(void);
+
+    /// \brief Recomputes the number of high inputs of every cell from the input states
+    void CountHighInputs(void);
+
+    /// \brief Assigns the topological levels to the acyclic combinational cells of the compiled netlist
+    void Levelize(void);
+
+    /// \brief Adds the given levelized cell to the cells that are settled at the end of the tick
+    /// \param pCell: The cell index
+    void Queue(uint32_t pCell);
+
+    /// \brief Evaluates all queued cells level by level and forwards their changes immediately
+    void Settle(void);
+
+    /// \brief Rebuilds the level buckets from the queued flags, or hands the queued cells
+    /// to the tick scheduler if the zero delay settle mode is disabled
+    void RestoreQueue(void);
+
+    /// \brief Recomputes the scheduling delays of all cells and reapplies the oscillation limit to the oscillating loops
+    void RestoreOscillationLimits(void);
+
+    /// \brief Counts an output change of a cell of the given loop and flags the loop once it oscillates
+    /// \param pLoop: The loop index
+    void CountLoopChange(uint32_t pLoop);
+
+    /// \brief Restarts the watchdog of the given loop after an input change from outside of it
+    /// An oscillating loop is no longer flagged and its cells are scheduled with their own delays again
+    /// \param pLoop: The loop index
+    void ReleaseLoop(uint32_t pLoop);
+
+    /// \brief Applies the oscillation limit to the cells of the given loop
+    /// \param pLoop: The loop index
+    void LimitLoop(uint32_t pLoop);
+
+    /// \brief Refills the timing wheel from the due ticks of all cells
+    /// \param pTick: The current tick of the restored state
+    void RestoreTimingWheel(uint64_t pTick);
+
+    /// \brief Schedules the evaluation of the given cell at the given tick, replacing an earlier scheduled one
+    /// \param pCell: The cell index
+    /// \param pTick: The tick at which the cell is evaluated
+    void Schedule(uint32_t pCell, uint64_t pTick);
+
+    /// \brief Evaluates the kernel of the given cell and queues it for notification if an output changed
+    /// \param pCell: The cell index
+    void LogicFunction(uint32_t pCell);
+
+    /// \brief Forwards all output states of the given cell to the connected inputs
+    /// \param pCell: The cell index
+    void NotifySuccessors(uint32_t pCell);
+
+    /// \brief Sets the only input and the output of a collapsed wire group or diode to pState
+    /// \param pCell: The cell index
+    /// \param pInput: Global index of the input
+    /// \param pState: The new state
+    void MirrorState(uint32_t pCell, uint32_t pInput, uint8_t pState);
+
+    /// \brief Sets the given input of the given cell to pState and schedules the cell's evaluation
+    /// \param pCell: The cell index
+    /// \param pInput: Global index of the input
+    /// \param pState: The new input state
+    void InputReady(uint32_t pCell, uint32_t pInput, uint8_t pState);
+
+    /// \brief Sets output pOutput of the given cell to pState and returns true if it changed
+    /// \param pCell: The cell index
+    /// \param pOutput: The output number
+    /// \param pState: The new output state
+    /// \return True, if the output state changed
+    bool AssureOutput(uint32_t pCell, uint32_t pOutput, uint8_t pState);
+
+    /// \brief Marks the given cell as changed for the next notification pass
+    /// \param pCell: The cell index
+    void MarkStateChanged(uint32_t pCell);
+
+    /// \brief Adds the given cell to the dirty cell list if it isn't in it already
+    /// \param pCell: The cell index
+    void MarkDirty(uint32_t pCell);
+
+    /// \brief Reads the inputs pFirst to pFirst + pCount - 1 of the given cell as a binary number
+    /// \param pCell: The cell index
+    /// \param pFirst: The first input number
+    /// \param pCount: The number of inputs to read
+    /// \return The value of the inputs, input pFirst being the least significant bit
+    uint32_t ReadInputValue(uint32_t pCell, uint32_t pFirst, uint32_t pCount) const;
+
+protected:
+    CompiledNetlist mNetlist;
+
+    std::vector<uint8_t> mInputStates;
+    std::vector<uint8_t> mPrevInputStates;
+    std::vector<uint8_t> mOutputStates;
+
+    // Number of high inputs per cell, kept up to date by InputReady, so gates and wires evaluate without visiting their inputs
+    std::vector<uint32_t> mHighInputCounts;
+
+    // Cells with a pending evaluation are scheduled on the timing wheel at the tick of their input change
+    // plus their propagation delay, idle cells are never visited
+    TimingWheel mTimingWheel;
+    std::vector<uint64_t> mDueTicks;
+    std::vector<uint32_t> mCurrentCells;
+    uint32_t mPendingCellCount = 0;
+
+    // Counter value, master-slave internal state, button ticks or clock tick countdown
+    std::vector<uint32_t> mCellValues;
+    // Clock pulse countdown
+    std::vector<uint32_t> mCellAuxValues;
+
+    std::vector<uint8_t> mStateChanged;
+    std::vector<uint32_t> mChangedCells;
+
+    std::vector<uint8_t> mIsDirty;
+    std::vector<uint32_t> mDirtyCells;
+
+    std::vector<uint8_t> mIsTraced;
+    std::vector<uint32_t> mTracedChanges;
+
+    // Zero delay settle mode: levelized cells whose inputs changed are queued in the bucket of their level
+    bool mIsZeroDelaySettle = false;
+    std::vector<uint32_t> mLevels;
+    std::vector<std::vector<uint32_t>> mLevelBuckets;
+    std::vector<uint8_t> mIsQueued;
+    uint32_t mQueuedCellCount = 0;
+
+    // Oscillation watchdog: output changes per loop since the last input change from outside of the loop.
+    // Cells are scheduled with their delay in mCellDelays, which the limit stretches or sets to 0 to freeze the cell
+    OscillationLimit mOscillationLimit = OscillationLimit::NONE;
+    std::vector<uint32_t> mCellDelays;
+    std::vector<uint32_t> mLoopChangeCounts;
+    std::vector<uint8_t> mIsLoopOscillating;
+    uint32_t mOscillatingLoopCount = 0;
+
+    EngineCounters mCounters;
+
+    SimulationState mInitialState;
+};
+
+#endif // SIMULATIONENGINE_H
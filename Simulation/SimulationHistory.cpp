@@ -0,0 +1,134 @@
+#include "SimulationHistory.h"
+
+#include <QtGlobal>
+#include <algorithm>
+
+namespace
+{
+constexpr uint64_t INITIAL_CHECKPOINT_INTERVAL = 1024; // Ticks between two checkpoints before any thinning
+constexpr uint32_t MAX_CHECKPOINT_COUNT = 64;
+}
+
+SimulationHistory::SimulationHistory():
+    mCheckpointInterval(INITIAL_CHECKPOINT_INTERVAL),
+    mNextCheckpointTick(INITIAL_CHECKPOINT_INTERVAL)
+{}
+
+void SimulationHistory::Clear()
+{
+    mCheckpoints.clear();
+    mInputEvents.clear();
+    mCheckpointInterval = INITIAL_CHECKPOINT_INTERVAL;
+    mNextCheckpointTick = INITIAL_CHECKPOINT_INTERVAL;
+}
+
+void SimulationHistory::OnTick(const SimulationEngine& pEngine, uint64_t pTickCount)
+{
+    if (pTickCount < mNextCheckpointTick)
+    {
+        return;
+    }
+
+    if (mCheckpoints.size() >= MAX_CHECKPOINT_COUNT)
+    {
+        ThinOutCheckpoints();
+    }
+
+    // Checkpoints are only taken at multiples of the interval, so thinning out keeps them evenly spaced
+    if (pTickCount % mCheckpointInterval == 0)
+    {
+        mCheckpoints.emplace_back();
+        mCheckpoints.back().tick = pTickCount;
+        pEngine.SaveState(mCheckpoints.back().state);
+    }
+
+    mNextCheckpointTick = (pTickCount / mCheckpointInterval + 1) * mCheckpointInterval;
+}
+
+void SimulationHistory::LogInput(uint64_t pTickCount, uint32_t pCell)
+{
+    Q_ASSERT(mInputEvents.empty() || mInputEvents.back().tick <= pTickCount);
+    mInputEvents.push_back(InputEvent{pTickCount, pCell});
+}
+
+void SimulationHistory::Rewind(SimulationEngine& pEngine, uint64_t pTargetTick)
+{
+    while (!mCheckpoints.empty() && mCheckpoints.back().tick > pTargetTick)
+    {
+        mCheckpoints.pop_back();
+    }
+
+    // Start from the closest checkpoint, the initial state of the engine serves as checkpoint at tick 0
+    uint64_t tick = 0;
+    if (mCheckpoints.empty())
+    {
+        pEngine.Reset();
+    }
+    else
+    {
+        pEngine.RestoreState(mCheckpoints.back().state);
+        tick = mCheckpoints.back().tick;
+    }
+
+    const auto byTick = [](const InputEvent& pEvent, uint64_t pTick)
+    {
+        return pEvent.tick < pTick;
+    };
+
+    auto event = std::lower_bound(mInputEvents.begin(), mInputEvents.end(), tick, byTick);
+    const auto firstDiscardedEvent = std::lower_bound(event, mInputEvents.end(), pTargetTick, byTick);
+
+    while (tick < pTargetTick)
+    {
+        for (; event != firstDiscardedEvent && event->tick == tick; event++)
+        {
+            if (pEngine.GetKernel(event->cell) == CellKernel::INPUT)
+            {
+                pEngine.ToggleInput(event->cell);
+            }
+            else
+            {
+                pEngine.PressButton(event->cell);
+            }
+        }
+
+        // Jump over idle ticks, but stop at the next input so it is replayed at its tick
+        const uint64_t nextStop = (event != firstDiscardedEvent ? event->tick : pTargetTick);
+        const uint64_t idleTicks = std::min(pEngine.GetIdleTicks(), nextStop - tick);
+
+        if (idleTicks > 0)
+        {
+            pEngine.SkipIdleTicks(idleTicks);
+            tick += idleTicks;
+        }
+        else
+        {
+            pEngine.Tick();
+            tick++;
+        }
+    }
+
+    mInputEvents.erase(firstDiscardedEvent, mInputEvents.end());
+    mNextCheckpointTick = (pTargetTick / mCheckpointInterval + 1) * mCheckpointInterval;
+}
+
+uint64_t SimulationHistory::GetNextCheckpointTick() const
+{
+    return mNextCheckpointTick;
+}
+
+uint32_t SimulationHistory::GetCheckpointCount() const
+{
+    return mCheckpoints.size();
+}
+
+void SimulationHistory::ThinOutCheckpoints()
+{
+    mCheckpointInterval *= 2;
+
+    const auto interval = mCheckpointInterval;
+    mCheckpoints.erase(std::remove_if(mCheckpoints.begin(), mCheckpoints.end(), [interval](const Checkpoint& pCheckpoint)
+    {
+        return (pCheckpoint.tick % interval != 0);
+    }), mCheckpoints.end());
+}
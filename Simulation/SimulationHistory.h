@@ -0,0 +1,74 @@
+#ifndef SIMULATIONHISTORY_H
+#define SIMULATIONHISTORY_H
+
+#include "Simulation/SimulationEngine.h"
+
+#include <cstdint>
+#include <vector>
+
+///
+/// \brief The SimulationHistory class records periodic checkpoints and all input activations of a simulation run
+/// Any earlier tick can be restored by restoring the closest preceding checkpoint and replaying the inputs from there.
+/// When the checkpoint limit is reached, every second checkpoint is dropped and the interval doubles,
+/// so the memory stays bounded while long runs remain covered.
+///
+class SimulationHistory
+{
+public:
+    /// \brief Constructor for SimulationHistory
+    SimulationHistory(void);
+
+    /// \brief Discards all checkpoints and inputs, must be called whenever the engine is compiled or reset
+    void Clear(void);
+
+    /// \brief Records a checkpoint if one is due, must be called after every tick
+    /// \param pEngine: The engine
+    /// \param pTickCount: The number of ticks simulated so far
+    void OnTick(const SimulationEngine& pEngine, uint64_t pTickCount);
+
+    /// \brief Records the activation of an input or button
+    /// \param pTickCount: The number of ticks simulated before the activation
+    /// \param pCell: Index of the INPUT or BUTTON cell
+    void LogInput(uint64_t pTickCount, uint32_t pCell);
+
+    /// \brief Puts the engine into the state it had after pTargetTick ticks, before any input of that tick
+    /// All history after the target tick is discarded
+    /// \param pEngine: The engine to rewind, it must not have been recompiled since the last Clear
+    /// \param pTargetTick: The tick to rewind to
+    void Rewind(SimulationEngine& pEngine, uint64_t pTargetTick);
+
+    /// \brief Getter for the tick at which the next checkpoint is due
+    /// Callers that skip idle ticks must not skip beyond it, or the checkpoint would be missed
+    /// \return The tick of the next checkpoint
+    uint64_t GetNextCheckpointTick(void) const;
+
+    /// \brief Getter for the number of stored checkpoints
+    /// \return The number of checkpoints
+    uint32_t GetCheckpointCount(void) const;
+
+protected:
+    /// \brief A saved engine state and the tick it has been saved at
+    struct Checkpoint
+    {
+        uint64_t tick;
+        SimulationState state;
+    };
+
+    /// \brief An input activation between two ticks
+    struct InputEvent
+    {
+        uint64_t tick;
+        uint32_t cell;
+    };
+
+    /// \brief Drops every second checkpoint and doubles the checkpoint interval
+    void ThinOutCheckpoints(void);
+
+protected:
+    std::vector<Checkpoint> mCheckpoints; // Sorted by tick
+    std::vector<InputEvent> mInputEvents; // Sorted by tick
+    uint64_t mCheckpointInterval;
+    uint64_t mNextCheckpointTick;
+};
+
+#endif // SIMULATIONHISTORY_H
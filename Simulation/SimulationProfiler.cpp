@@ -0,0 +1,179 @@
+#include "SimulationProfiler.h"
+
+#include <QtGlobal>
+#include <algorithm>
+#include <cmath>
+
+constexpr uint32_t ProfileHistogram::BUCKET_COUNT;
+
+void ProfileHistogram::Add(uint64_t pValue)
+{
+    uint32_t bucket = 0;
+    for (auto value = pValue; value > 0; value >>= 1)
+    {
+        bucket++;
+    }
+
+    buckets[bucket]++;
+    sampleCount++;
+    sum += pValue;
+    max = std::max(max, pValue);
+}
+
+void ProfileHistogram::Merge(const ProfileHistogram& pOther)
+{
+    for (uint32_t bucket = 0; bucket < BUCKET_COUNT; bucket++)
+    {
+        buckets[bucket] += pOther.buckets[bucket];
+    }
+
+    sampleCount += pOther.sampleCount;
+    sum += pOther.sum;
+    max = std::max(max, pOther.max);
+}
+
+uint64_t ProfileHistogram::GetPercentile(double pPercent) const
+{
+    if (sampleCount == 0)
+    {
+        return 0;
+    }
+
+    const auto rank = static_cast<uint64_t>(std::ceil(sampleCount * std::min(std::max(pPercent, 0.0), 100.0) / 100.0));
+    uint64_t count = 0;
+
+    for (uint32_t bucket = 0; bucket < BUCKET_COUNT; bucket++)
+    {
+        count += buckets[bucket];
+
+        if (count >= std::max<uint64_t>(rank, 1))
+        {
+            return std::min(GetBucketUpperBound(bucket), max);
+        }
+    }
+
+    return max;
+}
+
+uint64_t ProfileHistogram::GetBucketUpperBound(uint32_t pBucket)
+{
+    Q_ASSERT(pBucket < BUCKET_COUNT);
+    return (pBucket >= 64 ? UINT64_MAX : (static_cast<uint64_t>(1) << pBucket) - 1);
+}
+
+SimulationProfiler::SimulationProfiler()
+{}
+
+void SimulationProfiler::Clear()
+{
+    mHistograms.fill(ProfileHistogram());
+}
+
+void SimulationProfiler::BeginTick(const SimulationEngine& pEngine)
+{
+    mTickStartCounters = pEngine.GetCounters();
+    mTickStart = std::chrono::steady_clock::now();
+}
+
+void SimulationProfiler::EndTick(const SimulationEngine& pEngine)
+{
+    const auto duration = std::chrono::steady_clock::now() - mTickStart;
+    const auto& counters = pEngine.GetCounters();
+
+    AddSample(Metric::TICK_NANOSECONDS, std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+    AddSample(Metric::EVALUATED_CELLS, counters.evaluatedCells - mTickStartCounters.evaluatedCells);
+    AddSample(Metric::INPUT_EVENTS, counters.inputEvents - mTickStartCounters.inputEvents);
+}
+
+void SimulationProfiler::AddSample(Metric pMetric, uint64_t pValue)
+{
+    Q_ASSERT(pMetric < Metric::COUNT);
+    mHistograms[static_cast<size_t>(pMetric)].Add(pValue);
+}
+
+void SimulationProfiler::Merge(const SimulationProfiler& pOther)
+{
+    for (size_t metric = 0; metric < mHistograms.size(); metric++)
+    {
+        mHistograms[metric].Merge(pOther.mHistograms[metric]);
+    }
+}
+
+const ProfileHistogram& SimulationProfiler::GetHistogram(Metric pMetric) const
+{
+    Q_ASSERT(pMetric < Metric::COUNT);
+    return mHistograms[static_cast<size_t>(pMetric)];
+}
+
+void SimulationProfiler::WriteJson(std::ostream& pStream) const
+{
+    pStream << "{\n";
+
+    for (size_t metric = 0; metric < mHistograms.size(); metric++)
+    {
+        const auto& histogram = mHistograms[metric];
+
+        pStream << "    \"" << GetMetricName(static_cast<Metric>(metric)) << "\": {\n";
+        pStream << "        \"samples\": " << histogram.sampleCount << ",\n";
+        pStream << "        \"sum\": " << histogram.sum << ",\n";
+        pStream << "        \"max\": " << histogram.max << ",\n";
+        pStream << "        \"p50\": " << histogram.GetPercentile(50) << ",\n";
+        pStream << "        \"p99\": " << histogram.GetPercentile(99) << ",\n";
+        pStream << "        \"buckets\": [";
+
+        bool isFirstBucket = true;
+        for (uint32_t bucket = 0; bucket < ProfileHistogram::BUCKET_COUNT; bucket++)
+        {
+            if (histogram.buckets[bucket] > 0)
+            {
+                pStream << (isFirstBucket ? "" : ", ") << "{\"upTo\": " << ProfileHistogram::GetBucketUpperBound(bucket)
+                        << ", \"count\": " << histogram.buckets[bucket] << "}";
+                isFirstBucket = false;
+            }
+        }
+
+        pStream << "]\n";
+        pStream << "    }" << (metric + 1 < mHistograms.size() ? "," : "") << "\n";
+    }
+
+    pStream << "}\n";
+}
+
+const char* SimulationProfiler::GetMetricName(Metric pMetric)
+{
+    switch (pMetric)
+    {
+        case Metric::TICK_NANOSECONDS:
+        {
+            return "tickNanoseconds";
+        }
+        case Metric::EVALUATED_CELLS:
+        {
+            return "evaluatedCells";
+        }
+        case Metric::INPUT_EVENTS:
+        {
+            return "inputEvents";
+        }
+        case Metric::STATE_CHANGED_SIGNALS:
+        {
+            return "stateChangedSignals";
+        }
+        case Metric::REPAINT_REQUESTS:
+        {
+            return "repaintRequests";
+        }
+        case Metric::DISPATCH_NANOSECONDS:
+        {
+            return "dispatchNanoseconds";
+        }
+        case Metric::PAINT_NANOSECONDS:
+        {
+            return "paintNanoseconds";
+        }
+        default:
+        {
+            return "unknown";
+        }
+    }
+}
@@ -0,0 +1,107 @@
+#ifndef SIMULATIONPROFILER_H
+#define SIMULATIONPROFILER_H
+
+#include "Simulation/SimulationEngine.h"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+
+///
+/// \brief A histogram with power of two buckets, bucket i holds values of bit width i
+///
+struct ProfileHistogram
+{
+    static constexpr uint32_t BUCKET_COUNT = 65;
+
+    std::array<uint64_t, BUCKET_COUNT> buckets{};
+    uint64_t sampleCount = 0;
+    uint64_t sum = 0;
+    uint64_t max = 0;
+
+    /// \brief Adds a sample
+    /// \param pValue: The sample value
+    void Add(uint64_t pValue);
+
+    /// \brief Adds all samples of another histogram
+    /// \param pOther: The other histogram
+    void Merge(const ProfileHistogram& pOther);
+
+    /// \brief Estimates a percentile as the upper bound of the bucket containing it
+    /// \param pPercent: The percentile, 0 to 100
+    /// \return The estimated value, 0 if there are no samples
+    uint64_t GetPercentile(double pPercent) const;
+
+    /// \brief Getter for the largest value of a bucket
+    /// \param pBucket: The bucket index
+    /// \return The upper bound of the bucket
+    static uint64_t GetBucketUpperBound(uint32_t pBucket);
+};
+
+///
+/// \brief The SimulationProfiler class aggregates per tick and per frame measurements of a simulation into histograms
+/// Tick metrics are measured by the simulation thread between BeginTick and EndTick, frame metrics by the GUI.
+///
+class SimulationProfiler
+{
+public:
+    /// \brief The measured quantities
+    enum class Metric : uint8_t
+    {
+        TICK_NANOSECONDS = 0, // Wall time of one tick
+        EVALUATED_CELLS, // Cell evaluations per tick
+        INPUT_EVENTS, // Input updates per tick
+        STATE_CHANGED_SIGNALS, // StateChangedSignal emissions per frame
+        REPAINT_REQUESTS, // Items asked to repaint per frame
+        DISPATCH_NANOSECONDS, // Wall time of sampling the simulation and emitting the signals per frame
+        PAINT_NANOSECONDS, // Wall time of painting the scene per paint event
+        COUNT
+    };
+
+    /// \brief Constructor for SimulationProfiler
+    SimulationProfiler(void);
+
+    /// \brief Discards all samples
+    void Clear(void);
+
+    /// \brief Starts measuring a tick
+    /// \param pEngine: The engine about to tick
+    void BeginTick(const SimulationEngine& pEngine);
+
+    /// \brief Finishes measuring a tick and adds its samples
+    /// \param pEngine: The engine that ticked
+    void EndTick(const SimulationEngine& pEngine);
+
+    /// \brief Adds a sample of the given metric
+    /// \param pMetric: The metric
+    /// \param pValue: The sample value
+    void AddSample(Metric pMetric, uint64_t pValue);
+
+    /// \brief Adds all samples of another profiler
+    /// \param pOther: The other profiler
+    void Merge(const SimulationProfiler& pOther);
+
+    /// \brief Getter for the histogram of a metric
+    /// \param pMetric: The metric
+    /// \return The histogram
+    const ProfileHistogram& GetHistogram(Metric pMetric) const;
+
+    /// \brief Writes all histograms as a JSON object, empty buckets are omitted
+    /// \param pStream: The stream to write to
+    void WriteJson(std::ostream& pStream) const;
+
+    /// \brief Getter for the name of a metric, as used in the JSON output
+    /// \param pMetric: The metric
+    /// \return The name
+    static const char* GetMetricName(Metric pMetric);
+
+protected:
+    std::array<ProfileHistogram, static_cast<size_t>(Metric::COUNT)> mHistograms;
+
+    // State of the tick being measured
+    std::chrono::steady_clock::time_point mTickStart;
+    EngineCounters mTickStartCounters;
+};
+
+#endif // SIMULATIONPROFILER_H
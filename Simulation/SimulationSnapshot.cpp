@@ -0,0 +1,47 @@
+#include "SimulationSnapshot.h"
+
+#include <QtGlobal>
+#include <algorithm>
+
+bool SimulationSnapshot::GetInputState(uint32_t pCell, uint32_t pInput) const
+{
+    Q_ASSERT(pCell + 1 < inputOffsets.size() && inputOffsets[pCell] + pInput < inputOffsets[pCell + 1]);
+    return inputStates[inputOffsets[pCell] + pInput] != 0;
+}
+
+bool SimulationSnapshot::GetOutputState(uint32_t pCell, uint32_t pOutput) const
+{
+    Q_ASSERT(pCell + 1 < outputOffsets.size() && outputOffsets[pCell] + pOutput < outputOffsets[pCell + 1]);
+    return outputStates[outputOffsets[pCell] + pOutput] != 0;
+}
+
+bool SimulationSnapshot::CopyCellStates(const SimulationSnapshot& pSource, uint32_t pCell)
+{
+    Q_ASSERT(pSource.inputStates.size() == inputStates.size() && pSource.outputStates.size() == outputStates.size());
+
+    const auto inputBegin = pSource.inputStates.begin() + inputOffsets[pCell];
+    const auto inputEnd = pSource.inputStates.begin() + inputOffsets[pCell + 1];
+    const auto outputBegin = pSource.outputStates.begin() + outputOffsets[pCell];
+    const auto outputEnd = pSource.outputStates.begin() + outputOffsets[pCell + 1];
+
+    // States that toggled back and forth since the last copy are not a change
+    if (std::equal(inputBegin, inputEnd, inputStates.begin() + inputOffsets[pCell])
+            && std::equal(outputBegin, outputEnd, outputStates.begin() + outputOffsets[pCell]))
+    {
+        return false;
+    }
+
+    std::copy(inputBegin, inputEnd, inputStates.begin() + inputOffsets[pCell]);
+    std::copy(outputBegin, outputEnd, outputStates.begin() + outputOffsets[pCell]);
+    return true;
+}
+
+void SimulationSnapshot::Clear()
+{
+    inputOffsets.clear();
+    outputOffsets.clear();
+    inputStates.clear();
+    outputStates.clear();
+    tickCount = 0;
+    oscillatingLoopCount = 0;
+}
@@ -0,0 +1,42 @@
+#ifndef SIMULATIONSNAPSHOT_H
+#define SIMULATIONSNAPSHOT_H
+
+#include <cstdint>
+#include <vector>
+
+///
+/// \brief The SimulationSnapshot struct holds a copy of the pin states of a compiled circuit
+/// The simulation thread publishes its state in a snapshot, the GUI only ever reads its own copy
+///
+struct SimulationSnapshot
+{
+    /// \brief Getter for the state of input pInput of the given cell, with input inversion applied
+    /// \param pCell: The cell index
+    /// \param pInput: The input number
+    /// \return True, if the input is high
+    bool GetInputState(uint32_t pCell, uint32_t pInput) const;
+
+    /// \brief Getter for the state of output pOutput of the given cell, without output inversion
+    /// \param pCell: The cell index
+    /// \param pOutput: The output number
+    /// \return True, if the output is high
+    bool GetOutputState(uint32_t pCell, uint32_t pOutput) const;
+
+    /// \brief Copies the in- and output states of the given cell from pSource, which must have the same layout
+    /// \param pSource: The snapshot to copy from
+    /// \param pCell: The cell index
+    /// \return True, if any of the states differed
+    bool CopyCellStates(const SimulationSnapshot& pSource, uint32_t pCell);
+
+    /// \brief Releases all states
+    void Clear(void);
+
+    std::vector<uint32_t> inputOffsets; // First input of each cell, followed by the total input count
+    std::vector<uint32_t> outputOffsets; // First output of each cell, followed by the total output count
+    std::vector<uint8_t> inputStates;
+    std::vector<uint8_t> outputStates;
+    uint64_t tickCount = 0;
+    uint32_t oscillatingLoopCount = 0;
+};
+
+#endif // SIMULATIONSNAPSHOT_H
@@ -0,0 +1,305 @@
+#include "SimulationWorker.h"
+#include "Configuration.h"
+
+#include <algorithm>
+
+namespace
+{
+constexpr uint32_t CLOCK_CHECK_TICKS = 64; // Ticks between two checks of the batch time
+}
+
+SimulationWorker::SimulationWorker():
+    mWaveformRecorder(simulation::WAVEFORM_CAPACITY),
+    mIsProfiling(false),
+    mIsZeroDelaySettle(false),
+    mOscillationLimit(OscillationLimit::NONE),
+    mTickTimer(this),
+    mTickCount(0),
+    mTicksPerTimeout(1),
+    mBatchDuration(0),
+    mIsFullSnapshotPending(false)
+{
+    QObject::connect(&mTickTimer, &QTimer::timeout, this, &SimulationWorker::OnTickTimeout);
+}
+
+void SimulationWorker::Compile(const Netlist& pNetlist)
+{
+    mTickTimer.stop();
+    mTickCount = 0;
+
+    mEngine.SetZeroDelaySettle(mIsZeroDelaySettle);
+    mEngine.SetOscillationLimit(mOscillationLimit);
+    mEngine.Compile(pNetlist);
+    mHistory.Clear();
+    mWaveformRecorder.Clear();
+    PublishAll();
+}
+
+void SimulationWorker::SetZeroDelaySettle(bool pEnabled)
+{
+    mIsZeroDelaySettle = pEnabled;
+}
+
+void SimulationWorker::SetOscillationLimit(OscillationLimit pLimit)
+{
+    mOscillationLimit = pLimit;
+}
+
+void SimulationWorker::Clear()
+{
+    mTickTimer.stop();
+    mTickCount = 0;
+    mEngine.Clear();
+    mHistory.Clear();
+    mWaveformRecorder.Clear();
+
+    QMutexLocker lock(&mSnapshotMutex);
+    mPublishedSnapshot.Clear();
+    mPublishedChangedCells.clear();
+    mIsPublishedChanged.clear();
+    mIsFullSnapshotPending = false;
+}
+
+void SimulationWorker::Reset()
+{
+    mTickTimer.stop();
+    mTickCount = 0;
+
+    mEngine.Reset();
+    mHistory.Clear();
+    mWaveformRecorder.Restart(mEngine, mTickCount);
+    PublishAll();
+}
+
+void SimulationWorker::Start(std::chrono::milliseconds pInterval, uint32_t pTicksPerTimeout, std::chrono::milliseconds pBatchDuration)
+{
+    mTicksPerTimeout = pTicksPerTimeout;
+    mBatchDuration = pBatchDuration;
+    mTickTimer.start(pInterval);
+}
+
+void SimulationWorker::Pause()
+{
+    mTickTimer.stop();
+}
+
+void SimulationWorker::Step()
+{
+    if (mEngine.GetCellCount() > 0)
+    {
+        Tick();
+        Publish();
+    }
+}
+
+void SimulationWorker::StepBack(uint64_t pTicks)
+{
+    if (mEngine.GetCellCount() == 0)
+    {
+        return;
+    }
+
+    mTickTimer.stop();
+    mTickCount = (pTicks < mTickCount ? mTickCount - pTicks : 0);
+
+    mHistory.Rewind(mEngine, mTickCount);
+    mWaveformRecorder.Truncate(mEngine, mTickCount);
+    mEngine.ClearDirtyCells();
+    PublishAll();
+}
+
+void SimulationWorker::ActivateInput(uint32_t pCell)
+{
+    if (pCell >= mEngine.GetCellCount())
+    {
+        return; // Request from before the last recompile
+    }
+
+    switch (mEngine.GetKernel(pCell))
+    {
+        case CellKernel::INPUT:
+        {
+            mEngine.ToggleInput(pCell);
+            break;
+        }
+        case CellKernel::BUTTON:
+        {
+            mEngine.PressButton(pCell);
+            break;
+        }
+        default:
+        {
+            return;
+        }
+    }
+
+    mHistory.LogInput(mTickCount, pCell);
+    mWaveformRecorder.Sample(mEngine, mTickCount);
+    Publish();
+}
+
+void SimulationWorker::SetWaveformSignals(std::vector<WaveformSignal> pSignals)
+{
+    mWaveformRecorder.SetSignals(mEngine, std::move(pSignals), mTickCount);
+}
+
+std::vector<WaveformTrace> SimulationWorker::GetWaveformTraces(const std::vector<uint32_t>& pSignals, uint64_t pTicks, uint64_t& pEndTick) const
+{
+    pEndTick = mTickCount;
+    return mWaveformRecorder.GetTraces(pSignals, (pTicks < mTickCount ? mTickCount - pTicks : 0));
+}
+
+void SimulationWorker::WriteWaveform(std::ostream& pStream) const
+{
+    mWaveformRecorder.WriteVcd(pStream, mTickCount);
+}
+
+void SimulationWorker::SetProfiling(bool pEnabled)
+{
+    mIsProfiling = pEnabled;
+}
+
+void SimulationWorker::ClearProfile()
+{
+    mProfiler.Clear();
+}
+
+const SimulationProfiler& SimulationWorker::GetProfile() const
+{
+    return mProfiler;
+}
+
+void SimulationWorker::TakeSnapshot(SimulationSnapshot& pSnapshot, std::vector<uint32_t>& pChangedCells)
+{
+    QMutexLocker lock(&mSnapshotMutex);
+
+    if (mIsFullSnapshotPending)
+    {
+        pSnapshot = mPublishedSnapshot;
+        mIsFullSnapshotPending = false;
+
+        // Every cell may have changed with a full snapshot
+        for (uint32_t cell = 0; cell < mIsPublishedChanged.size(); cell++)
+        {
+            pChangedCells.push_back(cell);
+        }
+    }
+    else
+    {
+        // Cells whose states ended up where they were at the last snapshot are not reported
+        for (const auto& cell : mPublishedChangedCells)
+        {
+            if (pSnapshot.CopyCellStates(mPublishedSnapshot, cell))
+            {
+                pChangedCells.push_back(cell);
+            }
+        }
+        pSnapshot.tickCount = mPublishedSnapshot.tickCount;
+        pSnapshot.oscillatingLoopCount = mPublishedSnapshot.oscillatingLoopCount;
+    }
+
+    for (const auto& cell : mPublishedChangedCells)
+    {
+        mIsPublishedChanged[cell] = 0;
+    }
+
+    mPublishedChangedCells.clear();
+}
+
+void SimulationWorker::OnTickTimeout()
+{
+    if (mEngine.GetCellCount() == 0)
+    {
+        return;
+    }
+
+    if (mTicksPerTimeout > 0)
+    {
+        for (uint32_t i = 0; i < mTicksPerTimeout; i++)
+        {
+            Tick();
+        }
+    }
+    else
+    {
+        // Tick until the batch time is used up, returning to the event loop in between keeps the worker responsive
+        const auto batchEnd = std::chrono::steady_clock::now() + mBatchDuration;
+        do
+        {
+            for (uint32_t i = 0; i < CLOCK_CHECK_TICKS; i++)
+            {
+                SkipIdleTicks();
+                Tick();
+            }
+        } while (std::chrono::steady_clock::now() < batchEnd);
+    }
+
+    Publish(); // Publish once per batch, the GUI samples at frame rate anyway
+}
+
+void SimulationWorker::Tick()
+{
+    if (mIsProfiling)
+    {
+        mProfiler.BeginTick(mEngine);
+    }
+
+    mEngine.Tick();
+    mTickCount++;
+    mHistory.OnTick(mEngine, mTickCount);
+    mWaveformRecorder.Sample(mEngine, mTickCount);
+
+    if (mIsProfiling)
+    {
+        mProfiler.EndTick(mEngine);
+    }
+}
+
+void SimulationWorker::SkipIdleTicks()
+{
+    if (mIsProfiling)
+    {
+        return; // The profiler measures every single tick
+    }
+
+    const uint64_t idleTicks = std::min(mEngine.GetIdleTicks(), mHistory.GetNextCheckpointTick() - mTickCount);
+
+    if (idleTicks > 0)
+    {
+        mEngine.SkipIdleTicks(idleTicks);
+        mTickCount += idleTicks;
+        mHistory.OnTick(mEngine, mTickCount);
+    }
+}
+
+void SimulationWorker::Publish()
+{
+    QMutexLocker lock(&mSnapshotMutex);
+
+    mEngine.WriteSnapshot(mPublishedSnapshot, mEngine.GetDirtyCells());
+    mPublishedSnapshot.tickCount = mTickCount;
+    mPublishedSnapshot.oscillatingLoopCount = mEngine.GetOscillatingLoopCount();
+
+    for (const auto& cell : mEngine.GetDirtyCells())
+    {
+        if (mIsPublishedChanged[cell] == 0)
+        {
+            mIsPublishedChanged[cell] = 1;
+            mPublishedChangedCells.push_back(cell);
+        }
+    }
+
+    mEngine.ClearDirtyCells();
+}
+
+void SimulationWorker::PublishAll()
+{
+    QMutexLocker lock(&mSnapshotMutex);
+
+    mEngine.WriteSnapshot(mPublishedSnapshot);
+    mPublishedSnapshot.tickCount = mTickCount;
+    mPublishedSnapshot.oscillatingLoopCount = mEngine.GetOscillatingLoopCount();
+    mPublishedChangedCells.clear();
+    mIsPublishedChanged.assign(mEngine.GetCellCount(), 0);
+    mIsFullSnapshotPending = true;
+}
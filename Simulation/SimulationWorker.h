@@ -0,0 +1,137 @@
+#ifndef SIMULATIONWORKER_H
+#define SIMULATIONWORKER_H
+
+#include "Simulation/SimulationEngine.h"
+#include "Simulation/SimulationHistory.h"
+#include "Simulation/SimulationProfiler.h"
+#include "Simulation/SimulationSnapshot.h"
+#include "Simulation/WaveformRecorder.h"
+
+#include <QObject>
+#include <QTimer>
+#include <QMutex>
+#include <chrono>
+
+///
+/// \brief The SimulationWorker class runs the simulation engine on its own thread
+/// The worker publishes the engine state after every change, the GUI samples it with TakeSnapshot
+/// at its own pace, so neither painting can stall the logic nor the logic the painting.
+/// All functions except TakeSnapshot must be invoked in the worker's thread.
+///
+class SimulationWorker : public QObject
+{
+    Q_OBJECT
+public:
+    /// \brief Constructor for SimulationWorker
+    SimulationWorker(void);
+
+    /// \brief Compiles and resets the given netlist and publishes the complete state
+    /// \param pNetlist: The netlist to simulate
+    void Compile(const Netlist& pNetlist);
+
+    /// \brief Enables or disables the zero delay settle mode of the engine, it takes effect with the next Compile
+    /// Switching modes within a run would make the recorded history unreproducible
+    /// \param pEnabled: True to enable the mode
+    void SetZeroDelaySettle(bool pEnabled);
+
+    /// \brief Sets how the engine limits oscillating combinational loops, it takes effect with the next Compile
+    /// \param pLimit: The oscillation limit
+    void SetOscillationLimit(OscillationLimit pLimit);
+
+    /// \brief Stops the simulation and releases the compiled circuit
+    void Clear(void);
+
+    /// \brief Stops the simulation, restores the initial state of the compiled circuit and publishes the complete state
+    void Reset(void);
+
+    /// \brief Starts ticking the simulation periodically
+    /// \param pInterval: The interval between two timer timeouts
+    /// \param pTicksPerTimeout: The number of ticks per timeout, or 0 to tick for pBatchDuration per timeout
+    /// \param pBatchDuration: The time to spend ticking per timeout if pTicksPerTimeout is 0
+    void Start(std::chrono::milliseconds pInterval, uint32_t pTicksPerTimeout, std::chrono::milliseconds pBatchDuration);
+
+    /// \brief Stops ticking the simulation
+    void Pause(void);
+
+    /// \brief Advances the simulation by one tick
+    void Step(void);
+
+    /// \brief Stops the simulation and restores the state it had the given number of ticks ago
+    /// Inputs activated after the restored tick are forgotten
+    /// \param pTicks: The number of ticks to go back, clamped to the start of the simulation
+    void StepBack(uint64_t pTicks);
+
+    /// \brief Toggles the given input or presses the given button
+    /// \param pCell: Index of an INPUT or BUTTON cell
+    void ActivateInput(uint32_t pCell);
+
+    /// \brief Replaces the signals recorded by the waveform recorder and restarts the recording
+    /// \param pSignals: The signals to record, their cells must belong to the compiled netlist
+    void SetWaveformSignals(std::vector<WaveformSignal> pSignals);
+
+    /// \brief Reconstructs the course of the given recorded signals over the last ticks
+    /// \param pSignals: Indices of the recorded signals
+    /// \param pTicks: The number of ticks to reconstruct
+    /// \param pEndTick: Receives the tick the traces end at
+    /// \return One trace per signal
+    std::vector<WaveformTrace> GetWaveformTraces(const std::vector<uint32_t>& pSignals, uint64_t pTicks, uint64_t& pEndTick) const;
+
+    /// \brief Writes the recorded waveform in the Value Change Dump format
+    /// \param pStream: The stream to write to
+    void WriteWaveform(std::ostream& pStream) const;
+
+    /// \brief Enables or disables measuring every tick, disabled profiling costs nothing per tick
+    /// \param pEnabled: True to enable profiling
+    void SetProfiling(bool pEnabled);
+
+    /// \brief Discards all profiled ticks
+    void ClearProfile(void);
+
+    /// \brief Getter for the profiled ticks
+    /// \return The profiler
+    const SimulationProfiler& GetProfile(void) const;
+
+    /// \brief Brings the given snapshot up to date with the published simulation state, thread safe
+    /// \param pSnapshot: The GUI's snapshot, it is replaced completely after a compile or reset
+    /// \param pChangedCells: Vector to append the cells to whose states changed since the last call
+    void TakeSnapshot(SimulationSnapshot& pSnapshot, std::vector<uint32_t>& pChangedCells);
+
+protected slots:
+    /// \brief Advances the simulation by the configured number of ticks or time; invoked by mTickTimer
+    void OnTickTimeout(void);
+
+protected:
+    /// \brief Advances the engine by one tick without publishing
+    void Tick(void);
+
+    /// \brief Jumps over the upcoming ticks in which no state can change, at most up to the next history checkpoint
+    void SkipIdleTicks(void);
+
+    /// \brief Copies the states of all cells changed since the last call into the published snapshot
+    void Publish(void);
+
+    /// \brief Replaces the published snapshot with the complete engine state
+    void PublishAll(void);
+
+protected:
+    SimulationEngine mEngine;
+    SimulationHistory mHistory;
+    WaveformRecorder mWaveformRecorder;
+    SimulationProfiler mProfiler;
+    bool mIsProfiling;
+    bool mIsZeroDelaySettle;
+    OscillationLimit mOscillationLimit;
+    QTimer mTickTimer;
+    uint64_t mTickCount;
+    uint32_t mTicksPerTimeout;
+    std::chrono::milliseconds mBatchDuration;
+
+    // Published state, guarded by mSnapshotMutex
+    QMutex mSnapshotMutex;
+    SimulationSnapshot mPublishedSnapshot;
+    std::vector<uint32_t> mPublishedChangedCells;
+    std::vector<uint8_t> mIsPublishedChanged;
+    bool mIsFullSnapshotPending;
+};
+
+#endif // SIMULATIONWORKER_H
@@ -0,0 +1,306 @@
+#include "Testbench.h"
+
+#include <QtGlobal>
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <sstream>
+
+namespace
+{
+constexpr char COMMENT_CHAR = '#';
+constexpr char EXPECTATION_PREFIX = '=';
+constexpr char EDGE_PREFIX = '^';
+constexpr auto TICKS_COLUMN_NAME = "ticks";
+
+/// \brief Splits a line of the stimulus file into its values, ignoring comments
+/// \param pLine: The line
+/// \return The values
+std::vector<std::string> Tokenize(std::string pLine)
+{
+    pLine = pLine.substr(0, pLine.find(COMMENT_CHAR));
+    std::replace(pLine.begin(), pLine.end(), ',', ' ');
+
+    std::istringstream stream(pLine);
+    std::vector<std::string> tokens;
+    std::string token;
+
+    while (stream >> token)
+    {
+        tokens.push_back(token);
+    }
+
+    return tokens;
+}
+} // namespace
+
+constexpr uint32_t Testbench::NO_SIGNAL;
+constexpr uint64_t Testbench::MAX_EDGE_TICKS;
+
+Testbench::Testbench():
+    mCheckCount(0),
+    mTickCount(0)
+{}
+
+bool Testbench::AddSignal(const std::string& pName, uint32_t pCell, CellKernel pKernel)
+{
+    if (!mSignalIndices.emplace(pName, mSignals.size()).second)
+    {
+        return false;
+    }
+
+    mSignals.push_back(Signal{pName, pCell, pKernel});
+    return true;
+}
+
+bool Testbench::Load(std::istream& pStimulus)
+{
+    mColumns.clear();
+    mSteps.clear();
+    mError.clear();
+
+    bool isHeaderRead = false;
+    uint32_t lineNumber = 0;
+    std::string line;
+
+    while (std::getline(pStimulus, line))
+    {
+        lineNumber++;
+        const auto tokens = Tokenize(line);
+
+        if (tokens.empty())
+        {
+            continue;
+        }
+
+        if (!isHeaderRead)
+        {
+            if (tokens.front() != TICKS_COLUMN_NAME)
+            {
+                return Fail(lineNumber, std::string("the first column must be \"") + TICKS_COLUMN_NAME + "\"");
+            }
+
+            for (auto token = tokens.begin() + 1; token != tokens.end(); token++)
+            {
+                const bool isExpectation = (token->front() == EXPECTATION_PREFIX);
+                const auto name = (isExpectation ? token->substr(1) : *token);
+                const auto signal = FindSignal(name);
+
+                if (signal == NO_SIGNAL)
+                {
+                    return Fail(lineNumber, "unknown signal \"" + name + "\"");
+                }
+
+                if (!isExpectation && mSignals[signal].kernel != CellKernel::INPUT && mSignals[signal].kernel != CellKernel::BUTTON)
+                {
+                    return Fail(lineNumber, "\"" + name + "\" is no input or button and can't be driven");
+                }
+
+                mColumns.push_back(Column{signal, isExpectation});
+            }
+
+            isHeaderRead = true;
+            continue;
+        }
+
+        if (tokens.size() != mColumns.size() + 1)
+        {
+            return Fail(lineNumber, "expected " + std::to_string(mColumns.size() + 1) + " values");
+        }
+
+        Step step{lineNumber, 0, NO_SIGNAL, std::vector<int8_t>()};
+
+        if (tokens.front().front() == EDGE_PREFIX)
+        {
+            step.edgeSignal = FindSignal(tokens.front().substr(1));
+
+            if (step.edgeSignal == NO_SIGNAL)
+            {
+                return Fail(lineNumber, "unknown signal \"" + tokens.front().substr(1) + "\"");
+            }
+        }
+        else
+        {
+            // Digit strings beyond the range of a tick count are rejected like any other invalid count
+            errno = 0;
+            step.ticks = std::strtoull(tokens.front().c_str(), nullptr, 10);
+
+            if (tokens.front().find_first_not_of("0123456789") != std::string::npos || errno == ERANGE)
+            {
+                return Fail(lineNumber, "invalid tick count \"" + tokens.front() + "\"");
+            }
+        }
+
+        for (auto token = tokens.begin() + 1; token != tokens.end(); token++)
+        {
+            if (*token != "0" && *token != "1" && *token != "-")
+            {
+                return Fail(lineNumber, "invalid value \"" + *token + "\", expected 0, 1 or -");
+            }
+
+            step.values.push_back(*token == "-" ? -1 : static_cast<int8_t>(*token == "1"));
+        }
+
+        mSteps.push_back(step);
+    }
+
+    if (!isHeaderRead)
+    {
+        return Fail(lineNumber, "the stimulus file has no header");
+    }
+
+    return true;
+}
+
+bool Testbench::Run(SimulationEngine& pEngine, const TickCallback& pTickCallback)
+{
+    mMismatches.clear();
+    mError.clear();
+    mCheckCount = 0;
+    mTickCount = 0;
+
+    const auto tick = [&]()
+    {
+        pEngine.Tick();
+        mTickCount++;
+
+        if (pTickCallback)
+        {
+            pTickCallback(mTickCount);
+        }
+    };
+
+    // Jumps over ticks in which no state can change, nothing is sampled in them
+    const auto skipIdleTicks = [&](uint64_t pMaxTicks)
+    {
+        const uint64_t idleTicks = std::min(pEngine.GetIdleTicks(), pMaxTicks);
+
+        if (idleTicks > 0)
+        {
+            pEngine.SkipIdleTicks(idleTicks);
+            mTickCount += idleTicks;
+        }
+
+        return idleTicks;
+    };
+
+    for (const auto& step : mSteps)
+    {
+        bool isStimulusChanged = false;
+
+        for (uint32_t column = 0; column < mColumns.size(); column++)
+        {
+            const auto& signal = mSignals[mColumns[column].signal];
+
+            if (mColumns[column].isExpectation || step.values[column] < 0)
+            {
+                continue;
+            }
+
+            if (signal.kernel == CellKernel::INPUT && ReadValue(pEngine, mColumns[column].signal) != (step.values[column] == 1))
+            {
+                pEngine.ToggleInput(signal.cell);
+                isStimulusChanged = true;
+            }
+            else if (signal.kernel == CellKernel::BUTTON && step.values[column] == 1)
+            {
+                pEngine.PressButton(signal.cell);
+                isStimulusChanged = true;
+            }
+        }
+
+        if (isStimulusChanged && pTickCallback)
+        {
+            pTickCallback(mTickCount);
+        }
+
+        if (step.edgeSignal == NO_SIGNAL)
+        {
+            for (uint64_t i = 0; i < step.ticks; i++)
+            {
+                i += skipIdleTicks(step.ticks - i - 1);
+                tick();
+            }
+        }
+        else
+        {
+            bool previousValue = ReadValue(pEngine, step.edgeSignal);
+            uint64_t waitedTicks = 0;
+
+            for (;;)
+            {
+                if (waitedTicks++ == MAX_EDGE_TICKS)
+                {
+                    return Fail(step.line, "no rising edge of \"" + mSignals[step.edgeSignal].name + "\" within "
+                                + std::to_string(MAX_EDGE_TICKS) + " ticks");
+                }
+
+                waitedTicks += skipIdleTicks(MAX_EDGE_TICKS - waitedTicks);
+                tick();
+
+                const bool value = ReadValue(pEngine, step.edgeSignal);
+                if (value && !previousValue)
+                {
+                    break;
+                }
+                previousValue = value;
+            }
+        }
+
+        for (uint32_t column = 0; column < mColumns.size(); column++)
+        {
+            if (!mColumns[column].isExpectation || step.values[column] < 0)
+            {
+                continue;
+            }
+
+            mCheckCount++;
+
+            if (ReadValue(pEngine, mColumns[column].signal) != (step.values[column] == 1))
+            {
+                mMismatches.push_back(Mismatch{step.line, mTickCount, mSignals[mColumns[column].signal].name, step.values[column] == 1});
+            }
+        }
+    }
+
+    return true;
+}
+
+const std::string& Testbench::GetError() const
+{
+    return mError;
+}
+
+const std::vector<Testbench::Mismatch>& Testbench::GetMismatches() const
+{
+    return mMismatches;
+}
+
+uint32_t Testbench::GetCheckCount() const
+{
+    return mCheckCount;
+}
+
+uint64_t Testbench::GetTickCount() const
+{
+    return mTickCount;
+}
+
+bool Testbench::ReadValue(const SimulationEngine& pEngine, uint32_t pSignal) const
+{
+    Q_ASSERT(pSignal < mSignals.size());
+    const auto& signal = mSignals[pSignal];
+    return (signal.kernel == CellKernel::OUTPUT ? pEngine.GetInputState(signal.cell, 0) : pEngine.GetOutputState(signal.cell, 0));
+}
+
+uint32_t Testbench::FindSignal(const std::string& pName) const
+{
+    const auto signal = mSignalIndices.find(pName);
+    return (signal == mSignalIndices.end() ? NO_SIGNAL : signal->second);
+}
+
+bool Testbench::Fail(uint32_t pLine, const std::string& pMessage)
+{
+    mError = "line " + std::to_string(pLine) + ": " + pMessage;
+    return false;
+}
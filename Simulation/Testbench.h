@@ -0,0 +1,135 @@
+#ifndef TESTBENCH_H
+#define TESTBENCH_H
+
+#include "Simulation/SimulationEngine.h"
+
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+///
+/// \brief The Testbench class drives a simulation with the input vectors of a stimulus file and checks the outputs
+/// A stimulus file is a table of whitespace or comma separated values, '#' starts a comment. The header names the
+/// columns: the first one is "ticks", names prefixed with '=' are expected values, all others are stimuli.
+/// Each row applies its stimuli, advances the simulation and then checks its expected values. The first value of a row
+/// is either a number of ticks or "^name", which advances until the next rising edge of the named signal.
+/// Values are 0, 1 or '-' for unchanged stimuli and unchecked expectations; a 1 for a button presses it.
+///
+class Testbench
+{
+public:
+    /// \brief Index of no signal
+    static constexpr uint32_t NO_SIGNAL = std::numeric_limits<uint32_t>::max();
+
+    /// \brief Maximum number of ticks to wait for a rising edge
+    static constexpr uint64_t MAX_EDGE_TICKS = 1 << 20;
+
+    /// \brief Invoked with the tick count whenever the simulation state may have changed, e.g. to record a waveform
+    using TickCallback = std::function<void(uint64_t)>;
+
+    /// \brief An expected value that did not match the simulated one
+    struct Mismatch
+    {
+        uint32_t line; // Line of the stimulus file
+        uint64_t tick; // Tick at which the value was checked
+        std::string signal;
+        bool expected;
+    };
+
+    /// \brief Constructor for Testbench
+    Testbench(void);
+
+    /// \brief Makes a cell accessible by name, must be called for all signals before loading a stimulus file
+    /// \param pName: The name used in stimulus files
+    /// \param pCell: The cell index
+    /// \param pKernel: The kernel of the cell, only INPUT and BUTTON cells can be driven
+    /// \return False, if the name is already taken
+    bool AddSignal(const std::string& pName, uint32_t pCell, CellKernel pKernel);
+
+    /// \brief Parses a stimulus file, replacing any previously loaded one
+    /// \param pStimulus: The stream to read the stimulus file from
+    /// \return False, if the file is malformed, see GetError
+    bool Load(std::istream& pStimulus);
+
+    /// \brief Runs all rows of the loaded stimulus file and collects the mismatches
+    /// \param pEngine: The engine, usually in its initial state
+    /// \param pTickCallback: Optional callback invoked after every tick and every change of the stimuli
+    /// \return False, if a rising edge did not occur in time, see GetError
+    bool Run(SimulationEngine& pEngine, const TickCallback& pTickCallback = TickCallback());
+
+    /// \brief Getter for the error of the last failed Load or Run
+    /// \return The error message, prefixed with the line number
+    const std::string& GetError(void) const;
+
+    /// \brief Getter for the mismatches of the last run
+    /// \return The mismatches in order of occurrence
+    const std::vector<Mismatch>& GetMismatches(void) const;
+
+    /// \brief Getter for the number of values checked in the last run
+    /// \return The number of checked values
+    uint32_t GetCheckCount(void) const;
+
+    /// \brief Getter for the number of ticks simulated in the last run
+    /// \return The number of ticks
+    uint64_t GetTickCount(void) const;
+
+protected:
+    /// \brief A named cell
+    struct Signal
+    {
+        std::string name;
+        uint32_t cell;
+        CellKernel kernel;
+    };
+
+    /// \brief A column of the stimulus table
+    struct Column
+    {
+        uint32_t signal;
+        bool isExpectation;
+    };
+
+    /// \brief A row of the stimulus table
+    struct Step
+    {
+        uint32_t line;
+        uint64_t ticks; // Ticks to advance, unused if edgeSignal is set
+        uint32_t edgeSignal; // Signal whose rising edge to advance to or NO_SIGNAL
+        std::vector<int8_t> values; // One per column, -1 for '-'
+    };
+
+    /// \brief Reads the current value of a signal, outputs show their input
+    /// \param pEngine: The engine
+    /// \param pSignal: The signal index
+    /// \return The value
+    bool ReadValue(const SimulationEngine& pEngine, uint32_t pSignal) const;
+
+    /// \brief Looks up a signal by name
+    /// \param pName: The name
+    /// \return The signal index or NO_SIGNAL
+    uint32_t FindSignal(const std::string& pName) const;
+
+    /// \brief Sets the error message
+    /// \param pLine: The line of the stimulus file
+    /// \param pMessage: The message
+    /// \return Always false
+    bool Fail(uint32_t pLine, const std::string& pMessage);
+
+protected:
+    std::vector<Signal> mSignals;
+    std::unordered_map<std::string, uint32_t> mSignalIndices;
+
+    std::vector<Column> mColumns;
+    std::vector<Step> mSteps;
+
+    std::vector<Mismatch> mMismatches;
+    std::string mError;
+    uint32_t mCheckCount;
+    uint64_t mTickCount;
+};
+
+#endif // TESTBENCH_H
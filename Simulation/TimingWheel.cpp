@@ -0,0 +1,116 @@
+#include "TimingWheel.h"
+
+#include <QtGlobal>
+
+namespace
+{
+constexpr uint64_t SLOT_MASK = TimingWheel::SLOT_COUNT - 1;
+constexpr uint32_t REACH_BITS = TimingWheel::SLOT_BITS * TimingWheel::LEVEL_COUNT;
+} // namespace
+
+TimingWheel::TimingWheel():
+    mCurrentTick(0),
+    mTickSlots(SLOT_COUNT),
+    mSlots(SLOT_COUNT * (LEVEL_COUNT - 1))
+{}
+
+void TimingWheel::Reset(uint64_t pTick)
+{
+    for (auto& slot : mTickSlots)
+    {
+        slot.clear();
+    }
+
+    for (auto& slot : mSlots)
+    {
+        slot.clear();
+    }
+    mOverflow.clear();
+    mCurrentTick = pTick;
+}
+
+void TimingWheel::Insert(uint32_t pCell, uint64_t pTick)
+{
+    Q_ASSERT(pTick > mCurrentTick);
+    Place(Event{pTick, pCell});
+}
+
+void TimingWheel::Advance(std::vector<uint32_t>& pDueCells)
+{
+    mCurrentTick++;
+
+    // Whenever a block of a level ends, the next block of the level above is distributed, highest level first
+    if ((mCurrentTick & ((uint64_t{1} << REACH_BITS) - 1)) == 0)
+    {
+        mCascadeBuffer.swap(mOverflow);
+        mOverflow.clear();
+
+        for (const auto& event : mCascadeBuffer)
+        {
+            Place(event);
+        }
+    }
+
+    uint32_t topLevel = 0;
+    while (topLevel + 1 < LEVEL_COUNT && ((mCurrentTick >> (SLOT_BITS * (topLevel + 1))) << (SLOT_BITS * (topLevel + 1))) == mCurrentTick)
+    {
+        topLevel++;
+    }
+
+    for (uint32_t level = topLevel; level > 0; level--)
+    {
+        Cascade(level, (mCurrentTick >> (SLOT_BITS * level)) & SLOT_MASK);
+    }
+
+    pDueCells.swap(mTickSlots[mCurrentTick & SLOT_MASK]);
+    mTickSlots[mCurrentTick & SLOT_MASK].clear();
+}
+
+uint64_t TimingWheel::GetCurrentTick() const
+{
+    return mCurrentTick;
+}
+
+void TimingWheel::Place(const Event& pEvent)
+{
+    // The level is given by the highest slot digit in which the event tick differs from the current tick
+    const uint64_t difference = pEvent.tick ^ mCurrentTick;
+
+    if ((difference >> REACH_BITS) != 0)
+    {
+        mOverflow.push_back(pEvent);
+        return;
+    }
+
+    if ((difference >> SLOT_BITS) == 0)
+    {
+        mTickSlots[pEvent.tick & SLOT_MASK].push_back(pEvent.cell);
+        return;
+    }
+
+    uint32_t level = 1;
+    while ((difference >> (SLOT_BITS * (level + 1))) != 0)
+    {
+        level++;
+    }
+
+    mSlots[(level - 1) * SLOT_COUNT + ((pEvent.tick >> (SLOT_BITS * level)) & SLOT_MASK)].push_back(pEvent);
+}
+
+void TimingWheel::Cascade(uint32_t pLevel, uint32_t pSlot)
+{
+    auto& slot = mSlots[(pLevel - 1) * SLOT_COUNT + pSlot];
+
+    if (slot.empty())
+    {
+        return;
+    }
+
+    mCascadeBuffer.swap(slot);
+    slot.clear();
+
+    for (const auto& event : mCascadeBuffer)
+    {
+        Place(event);
+    }
+}
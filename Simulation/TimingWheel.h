@@ -0,0 +1,73 @@
+#ifndef TIMINGWHEEL_H
+#define TIMINGWHEEL_H
+
+#include <cstdint>
+#include <vector>
+
+///
+/// \brief The TimingWheel class schedules cell evaluations at absolute ticks in constant time
+/// The wheel is hierarchical: level 0 has one slot per tick of the current block of SLOT_COUNT ticks,
+/// each higher level has one slot per block of the level below. An event is placed in the lowest level
+/// whose block contains its tick and moves down one level whenever its block becomes the current one,
+/// so inserting and firing cost O(1) regardless of the number of pending events.
+/// Events further ahead than the highest level reaches are kept in an overflow list.
+///
+class TimingWheel
+{
+public:
+    /// \brief Number of slots per level, a power of two
+    static constexpr uint32_t SLOT_BITS = 6;
+    static constexpr uint32_t SLOT_COUNT = 1 << SLOT_BITS;
+
+    /// \brief Number of levels, the wheel reaches SLOT_COUNT ^ LEVEL_COUNT ticks ahead
+    static constexpr uint32_t LEVEL_COUNT = 4;
+
+    /// \brief Constructor for TimingWheel
+    TimingWheel(void);
+
+    /// \brief Removes all events and sets the current tick
+    /// \param pTick: The new current tick
+    void Reset(uint64_t pTick);
+
+    /// \brief Schedules the given cell at the given tick
+    /// \param pCell: The cell index
+    /// \param pTick: The tick at which the cell is due, must be after the current tick
+    void Insert(uint32_t pCell, uint64_t pTick);
+
+    /// \brief Advances the current tick by one and moves the cells due at the new tick into pDueCells
+    /// \param pDueCells: Receives the due cells, previous contents are replaced and its buffer is reused by the wheel
+    void Advance(std::vector<uint32_t>& pDueCells);
+
+    /// \brief Getter for the current tick
+    /// \return The current tick
+    uint64_t GetCurrentTick(void) const;
+
+protected:
+    /// \brief A scheduled cell evaluation
+    struct Event
+    {
+        uint64_t tick;
+        uint32_t cell;
+    };
+
+    /// \brief Places the given event in the lowest level whose block contains its tick
+    /// \param pEvent: The event, its tick must not be before the current tick
+    void Place(const Event& pEvent);
+
+    /// \brief Moves all events of the given slot one or more levels down
+    /// \param pLevel: The level of the slot, at least 1 and below LEVEL_COUNT
+    /// \param pSlot: The slot index
+    void Cascade(uint32_t pLevel, uint32_t pSlot);
+
+protected:
+    uint64_t mCurrentTick;
+
+    // The slots of level 0 hold the cells of a single tick, so they store no ticks
+    std::vector<std::vector<uint32_t>> mTickSlots;
+    // Slots of level l > 0 are stored at [(l - 1) * SLOT_COUNT, l * SLOT_COUNT)
+    std::vector<std::vector<Event>> mSlots;
+    std::vector<Event> mOverflow;
+    std::vector<Event> mCascadeBuffer;
+};
+
+#endif // TIMINGWHEEL_H
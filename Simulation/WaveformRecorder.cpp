@@ -0,0 +1,313 @@
+#include "WaveformRecorder.h"
+
+#include <QtGlobal>
+#include <algorithm>
+
+namespace
+{
+constexpr uint32_t VALUE_BIT = 1u << 31;
+constexpr char VCD_FIRST_IDENTIFIER_CHAR = '!';
+constexpr uint32_t VCD_IDENTIFIER_CHAR_COUNT = 94; // Printable ASCII characters from '!' to '~'
+}
+
+constexpr uint32_t WaveformRecorder::NO_SIGNAL;
+
+WaveformRecorder::WaveformRecorder(uint32_t pCapacity):
+    mCapacity(std::max<uint32_t>(pCapacity, 1)),
+    mOldestRecord(0),
+    mRecordCount(0),
+    mStartTick(0),
+    mNewestTick(0)
+{}
+
+void WaveformRecorder::SetSignals(SimulationEngine& pEngine, std::vector<WaveformSignal> pSignals, uint64_t pTickCount)
+{
+    for (const auto& signal : mSignals)
+    {
+        if (signal.cell < pEngine.GetCellCount())
+        {
+            pEngine.SetTraced(signal.cell, false);
+        }
+    }
+
+    mSignals = std::move(pSignals);
+    mFirstSignalOfCell.assign(pEngine.GetCellCount(), NO_SIGNAL);
+    mNextSignalOfCell.assign(mSignals.size(), NO_SIGNAL);
+
+    for (uint32_t signal = 0; signal < mSignals.size(); signal++)
+    {
+        const auto cell = mSignals[signal].cell;
+        Q_ASSERT(cell < pEngine.GetCellCount());
+
+        mNextSignalOfCell[signal] = mFirstSignalOfCell[cell];
+        mFirstSignalOfCell[cell] = signal;
+        pEngine.SetTraced(cell, true);
+    }
+
+    mStartValues.assign(mSignals.size(), 0);
+    mCurrentValues.assign(mSignals.size(), 0);
+    Restart(pEngine, pTickCount);
+}
+
+void WaveformRecorder::Clear()
+{
+    mSignals.clear();
+    mFirstSignalOfCell.clear();
+    mNextSignalOfCell.clear();
+    mStartValues.clear();
+    mCurrentValues.clear();
+    mRecords.clear();
+    mOldestRecord = 0;
+    mRecordCount = 0;
+    mStartTick = 0;
+    mNewestTick = 0;
+}
+
+void WaveformRecorder::Restart(SimulationEngine& pEngine, uint64_t pTickCount)
+{
+    pEngine.ClearTracedChanges();
+
+    mRecords.clear();
+    mOldestRecord = 0;
+    mRecordCount = 0;
+    mStartTick = pTickCount;
+    mNewestTick = pTickCount;
+
+    for (uint32_t signal = 0; signal < mSignals.size(); signal++)
+    {
+        mStartValues[signal] = ReadValue(pEngine, signal) ? 1 : 0;
+        mCurrentValues[signal] = mStartValues[signal];
+    }
+}
+
+void WaveformRecorder::Sample(SimulationEngine& pEngine, uint64_t pTickCount)
+{
+    for (const auto& cell : pEngine.GetTracedChanges())
+    {
+        for (auto signal = mFirstSignalOfCell[cell]; signal != NO_SIGNAL; signal = mNextSignalOfCell[signal])
+        {
+            const bool value = ReadValue(pEngine, signal);
+
+            if (value != (mCurrentValues[signal] != 0))
+            {
+                mCurrentValues[signal] = value ? 1 : 0;
+                Append(pTickCount, signal, value);
+            }
+        }
+    }
+
+    pEngine.ClearTracedChanges();
+}
+
+void WaveformRecorder::Truncate(SimulationEngine& pEngine, uint64_t pTickCount)
+{
+    pEngine.ClearTracedChanges();
+
+    if (pTickCount < mStartTick)
+    {
+        Restart(pEngine, pTickCount); // Rewound to before the oldest record
+        return;
+    }
+
+    // Every record toggles its signal, so undoing a record restores the inverted value
+    while (mRecordCount > 0 && mNewestTick > pTickCount)
+    {
+        const auto& record = GetRecord(mRecordCount - 1);
+        const auto signal = record.signalAndValue & ~VALUE_BIT;
+
+        if (signal != NO_SIGNAL)
+        {
+            mCurrentValues[signal] = (record.signalAndValue & VALUE_BIT) ? 0 : 1;
+        }
+
+        mNewestTick -= record.tickDelta;
+        mRecordCount--;
+    }
+
+    mNewestTick = std::min(mNewestTick, pTickCount);
+    SampleAll(pEngine, pTickCount);
+}
+
+uint32_t WaveformRecorder::GetSignalCount() const
+{
+    return mSignals.size();
+}
+
+uint64_t WaveformRecorder::GetStartTick() const
+{
+    return mStartTick;
+}
+
+std::vector<WaveformTrace> WaveformRecorder::GetTraces(const std::vector<uint32_t>& pSignals, uint64_t pFromTick) const
+{
+    std::vector<WaveformTrace> traces(pSignals.size());
+    std::vector<uint32_t> traceOfSignal(mSignals.size(), NO_SIGNAL);
+
+    for (uint32_t trace = 0; trace < pSignals.size(); trace++)
+    {
+        if (pSignals[trace] < mSignals.size())
+        {
+            traceOfSignal[pSignals[trace]] = trace;
+            traces[trace].startValue = (mCurrentValues[pSignals[trace]] != 0);
+        }
+    }
+
+    // Walk back from the newest record, so only the records within the window are visited
+    auto tick = mNewestTick;
+    for (uint32_t position = mRecordCount; position > 0 && tick > pFromTick; position--)
+    {
+        const auto& record = GetRecord(position - 1);
+        const auto signal = record.signalAndValue & ~VALUE_BIT;
+
+        if (signal != NO_SIGNAL && traceOfSignal[signal] != NO_SIGNAL)
+        {
+            auto& trace = traces[traceOfSignal[signal]];
+            trace.transitions.push_back(tick);
+            trace.startValue = (record.signalAndValue & VALUE_BIT) == 0;
+        }
+
+        tick -= record.tickDelta;
+    }
+
+    for (auto& trace : traces)
+    {
+        std::reverse(trace.transitions.begin(), trace.transitions.end());
+    }
+
+    return traces;
+}
+
+void WaveformRecorder::WriteVcd(std::ostream& pStream, uint64_t pEndTick) const
+{
+    pStream << "$version Linkuit Studio $end\n";
+    pStream << "$comment One time unit is one simulation tick $end\n";
+    pStream << "$timescale 1 ns $end\n";
+    pStream << "$scope module circuit $end\n";
+
+    for (uint32_t signal = 0; signal < mSignals.size(); signal++)
+    {
+        pStream << "$var wire 1 " << GetVcdIdentifier(signal) << ' ' << mSignals[signal].name << " $end\n";
+    }
+
+    pStream << "$upscope $end\n";
+    pStream << "$enddefinitions $end\n";
+
+    pStream << '#' << mStartTick << '\n';
+    pStream << "$dumpvars\n";
+
+    for (uint32_t signal = 0; signal < mSignals.size(); signal++)
+    {
+        pStream << (mStartValues[signal] != 0 ? '1' : '0') << GetVcdIdentifier(signal) << '\n';
+    }
+
+    pStream << "$end\n";
+
+    auto tick = mStartTick;
+    auto writtenTick = mStartTick;
+
+    for (uint32_t position = 0; position < mRecordCount; position++)
+    {
+        const auto& record = GetRecord(position);
+        const auto signal = record.signalAndValue & ~VALUE_BIT;
+        tick += record.tickDelta;
+
+        if (signal == NO_SIGNAL)
+        {
+            continue;
+        }
+
+        if (tick != writtenTick)
+        {
+            pStream << '#' << tick << '\n';
+            writtenTick = tick;
+        }
+
+        pStream << ((record.signalAndValue & VALUE_BIT) ? '1' : '0') << GetVcdIdentifier(signal) << '\n';
+    }
+
+    if (pEndTick > writtenTick)
+    {
+        pStream << '#' << pEndTick << '\n';
+    }
+}
+
+bool WaveformRecorder::ReadValue(const SimulationEngine& pEngine, uint32_t pSignal) const
+{
+    const auto& signal = mSignals[pSignal];
+    return signal.isInput ? pEngine.GetInputState(signal.cell, signal.pin) : pEngine.GetOutputState(signal.cell, signal.pin);
+}
+
+void WaveformRecorder::Append(uint64_t pTick, uint32_t pSignal, bool pValue)
+{
+    Q_ASSERT(pTick >= mNewestTick);
+
+    // Gaps that don't fit into a delta are bridged with padding records
+    while (pTick - mNewestTick > std::numeric_limits<uint32_t>::max())
+    {
+        Append(mNewestTick + std::numeric_limits<uint32_t>::max(), NO_SIGNAL, false);
+    }
+
+    if (mRecordCount == mCapacity)
+    {
+        // Fold the oldest record into the start values
+        const auto& oldest = mRecords[mOldestRecord];
+        const auto signal = oldest.signalAndValue & ~VALUE_BIT;
+
+        if (signal != NO_SIGNAL)
+        {
+            mStartValues[signal] = (oldest.signalAndValue & VALUE_BIT) ? 1 : 0;
+        }
+
+        mStartTick += oldest.tickDelta;
+        mOldestRecord = (mOldestRecord + 1) % mCapacity;
+        mRecordCount--;
+    }
+
+    const ChangeRecord record{static_cast<uint32_t>(pTick - mNewestTick), pSignal | (pValue ? VALUE_BIT : 0)};
+    const uint32_t position = (mOldestRecord + mRecordCount) % mCapacity;
+
+    if (position == mRecords.size())
+    {
+        mRecords.push_back(record); // The buffer only grows as far as it is used
+    }
+    else
+    {
+        mRecords[position] = record;
+    }
+
+    mRecordCount++;
+    mNewestTick = pTick;
+}
+
+void WaveformRecorder::SampleAll(SimulationEngine& pEngine, uint64_t pTickCount)
+{
+    for (uint32_t signal = 0; signal < mSignals.size(); signal++)
+    {
+        const bool value = ReadValue(pEngine, signal);
+
+        if (value != (mCurrentValues[signal] != 0))
+        {
+            mCurrentValues[signal] = value ? 1 : 0;
+            Append(pTickCount, signal, value);
+        }
+    }
+}
+
+const WaveformRecorder::ChangeRecord& WaveformRecorder::GetRecord(uint32_t pPosition) const
+{
+    Q_ASSERT(pPosition < mRecordCount);
+    return mRecords[(mOldestRecord + pPosition) % mCapacity];
+}
+
+std::string WaveformRecorder::GetVcdIdentifier(uint32_t pSignal)
+{
+    std::string identifier;
+
+    do
+    {
+        identifier.push_back(static_cast<char>(VCD_FIRST_IDENTIFIER_CHAR + pSignal % VCD_IDENTIFIER_CHAR_COUNT));
+        pSignal /= VCD_IDENTIFIER_CHAR_COUNT;
+    } while (pSignal > 0);
+
+    return identifier;
+}
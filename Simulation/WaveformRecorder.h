@@ -0,0 +1,146 @@
+#ifndef WAVEFORMRECORDER_H
+#define WAVEFORMRECORDER_H
+
+#include "Simulation/SimulationEngine.h"
+
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <vector>
+
+///
+/// \brief A signal to record, either an input or an output pin of a cell
+///
+struct WaveformSignal
+{
+    uint32_t cell;
+    uint32_t pin;
+    bool isInput;
+    std::string name;
+};
+
+///
+/// \brief The recorded course of one signal within a window of ticks
+///
+struct WaveformTrace
+{
+    bool startValue = false; // Value at the start of the window
+    std::vector<uint64_t> transitions; // Ticks at which the value toggles, ascending
+};
+
+///
+/// \brief The WaveformRecorder class records the value changes of selected signals of a simulation run
+/// Only changes are stored, as 8 byte records in a ring buffer of bounded capacity. When the buffer is full,
+/// the oldest changes are folded into the start values, so long runs keep their most recent history.
+/// The recorder only visits the cells the engine reports as changed, so idle signals cost nothing per tick.
+///
+class WaveformRecorder
+{
+public:
+    /// \brief Signal index of no signal, used for padding records
+    static constexpr uint32_t NO_SIGNAL = std::numeric_limits<uint32_t>::max() >> 1;
+
+    /// \brief Constructor for WaveformRecorder
+    /// \param pCapacity: The maximum number of stored changes
+    WaveformRecorder(uint32_t pCapacity);
+
+    /// \brief Replaces the recorded signals, enables tracing of their cells and restarts the recording
+    /// \param pEngine: The engine, it must not be recompiled without calling Clear or SetSignals again
+    /// \param pSignals: The signals to record
+    /// \param pTickCount: The number of ticks simulated so far
+    void SetSignals(SimulationEngine& pEngine, std::vector<WaveformSignal> pSignals, uint64_t pTickCount);
+
+    /// \brief Discards all signals and recorded changes
+    void Clear(void);
+
+    /// \brief Discards all recorded changes and takes the current values as start values
+    /// \param pEngine: The engine
+    /// \param pTickCount: The number of ticks simulated so far
+    void Restart(SimulationEngine& pEngine, uint64_t pTickCount);
+
+    /// \brief Records the changes of all signals whose cells changed since the last call
+    /// Must be called after every tick and input activation
+    /// \param pEngine: The engine
+    /// \param pTickCount: The number of ticks simulated so far
+    void Sample(SimulationEngine& pEngine, uint64_t pTickCount);
+
+    /// \brief Discards all changes after the given tick and records the current values, used after rewinding the engine
+    /// \param pEngine: The engine, already rewound to pTickCount
+    /// \param pTickCount: The number of ticks simulated so far
+    void Truncate(SimulationEngine& pEngine, uint64_t pTickCount);
+
+    /// \brief Getter for the number of recorded signals
+    /// \return The number of signals
+    uint32_t GetSignalCount(void) const;
+
+    /// \brief Getter for the first recorded tick, older changes have been overwritten
+    /// \return The first recorded tick
+    uint64_t GetStartTick(void) const;
+
+    /// \brief Reconstructs the course of the given signals from pFromTick on
+    /// \param pSignals: Indices of the signals, out of range indices yield empty traces
+    /// \param pFromTick: The first tick of the window, clamped to the start tick
+    /// \return One trace per signal
+    std::vector<WaveformTrace> GetTraces(const std::vector<uint32_t>& pSignals, uint64_t pFromTick) const;
+
+    /// \brief Writes all recorded changes in the Value Change Dump format, one time unit per tick
+    /// \param pStream: The stream to write to
+    /// \param pEndTick: The tick the dump ends at
+    void WriteVcd(std::ostream& pStream, uint64_t pEndTick) const;
+
+protected:
+    /// \brief A value change, the tick is stored relative to the previous record
+    struct ChangeRecord
+    {
+        uint32_t tickDelta;
+        uint32_t signalAndValue; // Signal index in the lower 31 bits, the new value in the highest bit
+    };
+
+    /// \brief Reads the current value of the given signal from the engine
+    /// \param pEngine: The engine
+    /// \param pSignal: The signal index
+    /// \return The value
+    bool ReadValue(const SimulationEngine& pEngine, uint32_t pSignal) const;
+
+    /// \brief Appends a change record, overwriting the oldest record if the buffer is full
+    /// \param pTick: The tick of the change, not less than the tick of the newest record
+    /// \param pSignal: The signal index or NO_SIGNAL
+    /// \param pValue: The new value
+    void Append(uint64_t pTick, uint32_t pSignal, bool pValue);
+
+    /// \brief Records the signals whose current value differs from the last recorded one
+    /// \param pEngine: The engine
+    /// \param pTickCount: The number of ticks simulated so far
+    void SampleAll(SimulationEngine& pEngine, uint64_t pTickCount);
+
+    /// \brief Getter for the record at the given position, 0 being the oldest
+    /// \param pPosition: The position
+    /// \return The record
+    const ChangeRecord& GetRecord(uint32_t pPosition) const;
+
+    /// \brief Encodes a signal index as a VCD identifier
+    /// \param pSignal: The signal index
+    /// \return The identifier
+    static std::string GetVcdIdentifier(uint32_t pSignal);
+
+protected:
+    std::vector<WaveformSignal> mSignals;
+
+    // Signals of every cell as singly linked lists, indexed by cell and signal
+    std::vector<uint32_t> mFirstSignalOfCell;
+    std::vector<uint32_t> mNextSignalOfCell;
+
+    // Value of every signal at mStartTick and after the newest record
+    std::vector<uint8_t> mStartValues;
+    std::vector<uint8_t> mCurrentValues;
+
+    std::vector<ChangeRecord> mRecords; // Ring buffer, grows up to mCapacity
+    uint32_t mCapacity;
+    uint32_t mOldestRecord;
+    uint32_t mRecordCount;
+    uint64_t mStartTick;
+    uint64_t mNewestTick;
+};
+
+#endif // WAVEFORMRECORDER_H
@@ -198,6 +198,21 @@ void GraphicsView::mouseDoubleClickEvent(QMouseEvent *pEvent)
     return; // Prevent interaction while not in edit mode
 }
 
+void GraphicsView::paintEvent(QPaintEvent *pEvent)
+{
+    if (!mCoreLogic.IsProfilingEnabled())
+    {
+        QGraphicsView::paintEvent(pEvent);
+        return;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    QGraphicsView::paintEvent(pEvent);
+    const auto duration = std::chrono::steady_clock::now() - start;
+
+    mCoreLogic.AddPaintSample(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+}
+
 View::View(QtAwesome &pAwesome, CoreLogic &pCoreLogic):
     mGraphicsView(*this, pCoreLogic),
     mCoreLogic(pCoreLogic),
@@ -233,8 +248,22 @@ void View::Init()
     mProcessingImage = new QLabel();
     mProcessingImage->setPixmap(QPixmap(":/images/logo_processing.png").scaled(518, 200, Qt::KeepAspectRatio));
 
+    mProcessingProgressBar = new QProgressBar();
+    mProcessingProgressBar->setRange(0, 100);
+    mProcessingProgressBar->setFixedWidth(300);
+    mProcessingProgressBar->hide();
+
+    mProcessingCancelButton = new QPushButton(tr("Cancel"));
+    mProcessingCancelButton->hide();
+
+    QObject::connect(mProcessingCancelButton, &QPushButton::clicked, &mCoreLogic, &CoreLogic::CancelProcessing);
+
     mProcessingLayout = new QGridLayout();
-    mProcessingLayout->addWidget(mProcessingImage, 0, 0, Qt::AlignHCenter | Qt::AlignVCenter);
+    mProcessingLayout->setRowStretch(0, 1);
+    mProcessingLayout->setRowStretch(4, 1);
+    mProcessingLayout->addWidget(mProcessingImage, 1, 0, Qt::AlignHCenter | Qt::AlignVCenter);
+    mProcessingLayout->addWidget(mProcessingProgressBar, 2, 0, Qt::AlignHCenter | Qt::AlignVCenter);
+    mProcessingLayout->addWidget(mProcessingCancelButton, 3, 0, Qt::AlignHCenter | Qt::AlignVCenter);
 
     mProcessingOverlay->setLayout(mProcessingLayout);
 
@@ -253,6 +282,10 @@ void View::Init()
     mMainLayout->addWidget(&mGraphicsView, 1, 0);
     mMainLayout->addWidget(mProcessingOverlay, 1, 0);
 
+    mWaveformStrip = new WaveformStrip();
+    mWaveformStrip->hide();
+    mMainLayout->addWidget(mWaveformStrip, 2, 0);
+
     setLayout(mMainLayout);
 
     mGraphicsView.stackUnder(mProcessingOverlay);
@@ -293,11 +326,14 @@ QList<QGraphicsItem*> View::Components(void) const
 void View::OnSimulationStart()
 {
     mGraphicsView.setDragMode(QGraphicsView::NoDrag);
+    mWaveformStrip->setVisible(mIsWaveformStripEnabled);
 }
 
 void View::OnSimulationStop()
 {
     mGraphicsView.setDragMode(QGraphicsView::RubberBandDrag);
+    mWaveformStrip->hide();
+    mWaveformStrip->Clear();
 }
 
 void View::SetupMatrix()
@@ -523,3 +559,31 @@ void View::FadeOutProcessingOverlay()
         anim->start(QAbstractAnimation::DeleteWhenStopped);
     }
 }
+
+void View::ShowProcessingProgress(bool pShow)
+{
+    mProcessingProgressBar->setValue(0);
+    mProcessingProgressBar->setVisible(pShow);
+    mProcessingCancelButton->setVisible(pShow);
+}
+
+void View::SetProcessingProgress(uint8_t pPercent)
+{
+    mProcessingProgressBar->setValue(pPercent);
+}
+
+void View::SetWaveformStripEnabled(bool pEnabled)
+{
+    mIsWaveformStripEnabled = pEnabled;
+    mWaveformStrip->setVisible(pEnabled && mCoreLogic.IsSimulationRunning());
+}
+
+bool View::IsWaveformStripVisible() const
+{
+    return !mWaveformStrip->isHidden();
+}
+
+WaveformStrip* View::GetWaveformStrip()
+{
+    return mWaveformStrip;
+}
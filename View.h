@@ -5,6 +5,7 @@
 #include "Configuration.h"
 
 #include "Gui/PieMenu.h"
+#include "Gui/WaveformStrip.h"
 #include "QtAwesome.h"
 
 #include <QFrame>
@@ -19,6 +20,8 @@
 // forward declarations
 QT_BEGIN_NAMESPACE
 class QLabel;
+class QProgressBar;
+class QPushButton;
 class QToolButton;
 QT_END_NAMESPACE
 
@@ -69,6 +72,10 @@ protected:
     /// \param pEvent: The associated double click event
     void mouseDoubleClickEvent(QMouseEvent *pEvent) override;
 
+    /// \brief Paints the scene and reports the paint duration to the profiler
+    /// \param pEvent: The associated paint event
+    void paintEvent(QPaintEvent *pEvent) override;
+
 protected:
     View &mView;
     CoreLogic &mCoreLogic;
@@ -112,6 +119,14 @@ public:
     /// \brief Fades in the overlay that indicates that the SW is loading
     void FadeInProcessingOverlay(void);
 
+    /// \brief Shows or hides the progress bar and cancel button of the processing overlay
+    /// \param pShow: If true, the progress is reset to zero and shown
+    void ShowProcessingProgress(bool pShow);
+
+    /// \brief Sets the progress displayed on the processing overlay
+    /// \param pPercent: The progress in percent
+    void SetProcessingProgress(uint8_t pPercent);
+
     /// \brief Resets zoom and position
     void ResetViewport(void);
 
@@ -124,6 +139,18 @@ public:
 
     PieMenu* GetPieMenu(void);
 
+    /// \brief Enables or disables the waveform strip below the canvas, it is only shown while simulating
+    /// \param pEnabled: If true, the strip is shown during simulation
+    void SetWaveformStripEnabled(bool pEnabled);
+
+    /// \brief Returns true, if the waveform strip is currently shown
+    /// \return Whether the waveform strip is shown
+    bool IsWaveformStripVisible(void) const;
+
+    /// \brief Getter for the waveform strip
+    /// \return Pointer to the waveform strip
+    WaveformStrip* GetWaveformStrip(void);
+
 signals:
     /// \brief Emitted when the scene is zoomed in or out
     /// \param pPercentage: The new zoom percentage
@@ -179,10 +206,15 @@ protected:
 
     QWidget *mProcessingOverlay;
     QLabel *mProcessingImage;
+    QProgressBar *mProcessingProgressBar;
+    QPushButton *mProcessingCancelButton;
     QGridLayout *mProcessingLayout;
 
     PieMenu *mPieMenu;
 
+    WaveformStrip *mWaveformStrip;
+    bool mIsWaveformStripEnabled = false;
+
     int32_t mZoomLevel = canvas::DEFAULT_ZOOM_LEVEL;
 };
 